@@ -0,0 +1,133 @@
+#include "AllocationCounter.h"
+
+#include "imgui.h"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef GD_COUNT_ALLOCATIONS
+
+// Plain integers: the counters belong to the thread that allocates
+static thread_local uint64_t t_allocationCount = 0;
+static thread_local uint64_t t_allocationBytes = 0;
+
+static void CountAllocation(size_t size)
+{
+    t_allocationCount++;
+    t_allocationBytes += size;
+}
+
+static void* AlignedAlloc(size_t size, size_t alignment)
+{
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    // aligned_alloc wants the size to be a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+}
+
+static void AlignedFree(void* memory)
+{
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+// The array and nothrow forms forward to these by default
+void* operator new(size_t size)
+{
+    CountAllocation(size);
+    if (void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    CountAllocation(size);
+    if (void* memory = AlignedAlloc(size ? size : 1, (size_t)alignment)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    AlignedFree(memory);
+}
+
+void operator delete(void* memory, size_t, std::align_val_t) noexcept
+{
+    AlignedFree(memory);
+}
+
+static void* ImGuiCountingAlloc(size_t size, void*)
+{
+    CountAllocation(size);
+    return std::malloc(size);
+}
+
+static void ImGuiCountingFree(void* memory, void*)
+{
+    std::free(memory);
+}
+
+bool AllocationCountingEnabled()
+{
+    return true;
+}
+
+AllocationStats ThreadAllocations()
+{
+    AllocationStats stats;
+    stats.count = t_allocationCount;
+    stats.bytes = t_allocationBytes;
+    return stats;
+}
+
+void InstallImGuiAllocationHooks()
+{
+    ImGui::SetAllocatorFunctions(ImGuiCountingAlloc, ImGuiCountingFree);
+}
+
+#else
+
+bool AllocationCountingEnabled()
+{
+    return false;
+}
+
+AllocationStats ThreadAllocations()
+{
+    return AllocationStats();
+}
+
+void InstallImGuiAllocationHooks()
+{
+}
+
+#endif
+
+// FrameAllocationMeter
+void FrameAllocationMeter::BeginFrame()
+{
+    m_start = ThreadAllocations();
+}
+
+void FrameAllocationMeter::EndFrame()
+{
+    AllocationStats now = ThreadAllocations();
+    m_lastFrame.count = now.count - m_start.count;
+    m_lastFrame.bytes = now.bytes - m_start.bytes;
+    m_cleanFrames = m_lastFrame.count == 0 ? m_cleanFrames + 1 : 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+// Heap allocation counting for checking that steady-state frames do not allocate. Only compiled in
+// when GD_COUNT_ALLOCATIONS is defined (it replaces global operator new/delete); otherwise every count
+// stays zero and the hooks do nothing.
+
+struct AllocationStats {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+bool AllocationCountingEnabled();
+
+// Allocations made so far by the calling thread, through operator new and through ImGui
+AllocationStats ThreadAllocations();
+
+// ImGui allocates with malloc rather than operator new, so it is counted through its allocator hooks.
+// Call before ImGui::CreateContext().
+void InstallImGuiAllocationHooks();
+
+// Allocations one thread made between BeginFrame() and EndFrame()
+class FrameAllocationMeter {
+public:
+    void BeginFrame();
+    void EndFrame();
+
+    const AllocationStats& LastFrame() const { return m_lastFrame; }
+    // Frames in a row that allocated nothing
+    uint64_t CleanFrames() const { return m_cleanFrames; }
+
+private:
+    AllocationStats m_start;
+    AllocationStats m_lastFrame;
+    uint64_t m_cleanFrames = 0;
+};
@@ -0,0 +1,122 @@
+#include "AppRegistry.h"
+
+#include <algorithm>
+
+// StringTable
+StringId StringTable::Intern(std::string_view text)
+{
+    auto it = m_ids.find(text);
+    if (it != m_ids.end()) return it->second;
+
+    StringId id = (StringId)m_strings.size();
+    m_strings.emplace_back(text);
+    m_ids.emplace(std::string_view(m_strings.back()), id);
+    return id;
+}
+
+StringId StringTable::Find(std::string_view text) const
+{
+    auto it = m_ids.find(text);
+    return it == m_ids.end() ? INVALID : it->second;
+}
+
+// AppRegistry
+AppHandle AppRegistry::Add(const AppDesc& desc)
+{
+    std::uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else {
+        slot = (std::uint32_t)m_generations.size();
+        m_generations.push_back(0);
+        m_launching.push_back(0);
+        m_windows.push_back(0);
+        m_icons.emplace_back();
+        m_telemetry.emplace_back();
+        m_info.emplace_back();
+        m_loadingLabels.emplace_back();
+        m_processes.emplace_back();
+        m_launches.emplace_back();
+    }
+
+    AppInfo& info = m_info[slot];
+    info.name = m_strings.Intern(desc.name);
+    info.windowTitle = m_strings.Intern(desc.windowTitle);
+    info.commandLine = desc.commandLine;
+    info.iconPath = desc.iconPath;
+    info.custom = desc.custom;
+    info.readiness = desc.readiness.IsEmpty() ? nullptr : std::make_shared<const ReadinessMatcher>(desc.readiness);
+    info.throttleWhenHidden = desc.throttleWhenHidden;
+    m_loadingLabels[slot] = desc.name + " (Loading...)";
+
+    m_order.push_back(slot);
+    return { slot, m_generations[slot] };
+}
+
+void AppRegistry::Remove(AppHandle app)
+{
+    if (!Contains(app)) return;
+
+    CancelLaunch(app);
+    EndLaunch(app);
+    std::uint32_t slot = app.index;
+    m_order.erase(std::find(m_order.begin(), m_order.end(), slot));
+
+    // Bumping the generation is what makes outstanding handles stale
+    m_generations[slot]++;
+    m_windows[slot] = 0;
+    m_icons[slot] = IconTexture();
+    m_telemetry[slot] = TelemetrySample();
+    m_info[slot] = AppInfo();
+    m_loadingLabels[slot].clear();
+    m_processes[slot].reset();
+    m_launches[slot] = CancellationSource();
+    m_freeSlots.push_back(slot);
+}
+
+bool AppRegistry::Contains(AppHandle app) const
+{
+    return app.index < m_generations.size() && m_generations[app.index] == app.generation;
+}
+
+AppHandle AppRegistry::Find(std::string_view name) const
+{
+    StringId id = m_strings.Find(name);
+    if (id == StringTable::INVALID) return AppHandle();
+    for (std::uint32_t slot : m_order) {
+        if (m_info[slot].name == id) return { slot, m_generations[slot] };
+    }
+    return AppHandle();
+}
+
+CancellationToken AppRegistry::BeginLaunch(AppHandle app)
+{
+    if (!m_launching[app.index]) {
+        m_launching[app.index] = 1;
+        m_launchingCount++;
+        // A fresh source; the previous launch's token may still be held by a finishing coroutine
+        m_launches[app.index] = CancellationSource();
+    }
+    return m_launches[app.index].Token();
+}
+
+void AppRegistry::EndLaunch(AppHandle app)
+{
+    if (!m_launching[app.index]) return;
+    m_launching[app.index] = 0;
+    m_launchingCount--;
+}
+
+void AppRegistry::CancelLaunch(AppHandle app)
+{
+    if (m_launching[app.index]) m_launches[app.index].Cancel();
+}
+
+void AppRegistry::CancelAllLaunches()
+{
+    for (std::uint32_t slot : m_order) {
+        if (m_launching[slot]) m_launches[slot].Cancel();
+    }
+}
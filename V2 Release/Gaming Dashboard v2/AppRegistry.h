@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Executor.h"
+#include "IconAtlas.h"
+#include "ProcessLauncher.h"
+#include "ProcessTelemetry.h"
+#include "WindowReadiness.h"
+#include "WindowSystem.h"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+typedef std::uint32_t StringId;
+
+// Each distinct string is stored once and referred to by a small integer id
+class StringTable {
+public:
+    static const StringId INVALID = 0xFFFFFFFF;
+
+    StringId Intern(std::string_view text);
+    // INVALID if the string was never interned
+    StringId Find(std::string_view text) const;
+    const std::string& Get(StringId id) const { return m_strings[id]; }
+    size_t Size() const { return m_strings.size(); }
+
+private:
+    // A deque never moves its elements, so the views used as map keys stay valid
+    std::deque<std::string> m_strings;
+    std::unordered_map<std::string_view, StringId> m_ids;
+};
+
+// Stable reference to an app. The index addresses the registry's arrays directly; the generation
+// tells a handle to a removed app apart from a newer app reusing its slot.
+struct AppHandle {
+    static const std::uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+    std::uint32_t index = INVALID_INDEX;
+    std::uint32_t generation = 0;
+
+    bool IsValid() const { return index != INVALID_INDEX; }
+    bool operator==(const AppHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const AppHandle& other) const { return !(*this == other); }
+};
+
+// What an app is registered with
+struct AppDesc {
+    std::string name;
+    std::string commandLine;
+    std::string iconPath;
+    std::string windowTitle;
+    // User-added (saved with the settings) rather than built in
+    bool custom = false;
+    // When a window of the app is its main window; empty takes the first window with the title
+    ReadinessRule readiness{};
+    // Off for launchers like Steam, whose games run in their process tree
+    bool throttleWhenHidden = true;
+};
+
+// Configuration of a registered app, only read when launching or saving
+struct AppInfo {
+    StringId name = StringTable::INVALID;
+    StringId windowTitle = StringTable::INVALID;
+    std::string commandLine;
+    std::string iconPath;
+    bool custom = false;
+    // Null when the app has no readiness rule
+    std::shared_ptr<const ReadinessMatcher> readiness;
+    bool throttleWhenHidden = true;
+};
+
+// Every app the dashboard can launch. The state read every frame (launch flag, embedded window, icon)
+// lives in parallel arrays indexed by handle, so the sidebar reads it without hashing, string
+// compares or allocation. Slots of removed apps are reused. UI thread only.
+class AppRegistry {
+public:
+    AppHandle Add(const AppDesc& desc);
+    // Cancels a pending launch; the handle is stale afterwards
+    void Remove(AppHandle app);
+    bool Contains(AppHandle app) const;
+    // First live app with this name, an invalid handle if there is none
+    AppHandle Find(std::string_view name) const;
+
+    // Live apps in the order they were added
+    size_t Count() const { return m_order.size(); }
+    AppHandle At(size_t position) const { return { m_order[position], m_generations[m_order[position]] }; }
+
+    AppInfo& Info(AppHandle app) { return m_info[app.index]; }
+    const AppInfo& Info(AppHandle app) const { return m_info[app.index]; }
+    const std::string& Name(AppHandle app) const { return m_strings.Get(m_info[app.index].name); }
+    const std::string& WindowTitle(AppHandle app) const { return m_strings.Get(m_info[app.index].windowTitle); }
+    // Sidebar label while a launch is pending, built once so drawing it does not allocate
+    const std::string& LoadingLabel(AppHandle app) const { return m_loadingLabels[app.index]; }
+    StringTable& Strings() { return m_strings; }
+
+    IconTexture& Icon(AppHandle app) { return m_icons[app.index]; }
+
+    // Embedded window, 0 if the app has no tab yet
+    WindowId Window(AppHandle app) const { return m_windows[app.index]; }
+    void SetWindow(AppHandle app, WindowId window) { m_windows[app.index] = window; }
+
+    // Process tree behind the app's tab
+    std::shared_ptr<LaunchedProcess>& Process(AppHandle app) { return m_processes[app.index]; }
+    // Latest resource usage of that tree; processCount is 0 until the first sample arrives
+    TelemetrySample& Telemetry(AppHandle app) { return m_telemetry[app.index]; }
+    // Identifies the app in telemetry samples; stale once the app is removed
+    uint64_t TelemetryKey(AppHandle app) const { return (uint64_t)app.index << 32 | app.generation; }
+    AppHandle FromTelemetryKey(uint64_t key) const { return { (std::uint32_t)(key >> 32), (std::uint32_t)key }; }
+
+    bool IsLaunching(AppHandle app) const { return m_launching[app.index] != 0; }
+    bool AnyLaunching() const { return m_launchingCount > 0; }
+    // Marks the app as launching and returns the token that cancels it
+    CancellationToken BeginLaunch(AppHandle app);
+    void EndLaunch(AppHandle app);
+    void CancelLaunch(AppHandle app);
+    void CancelAllLaunches();
+
+private:
+    StringTable m_strings;
+
+    // Hot, indexed by slot
+    std::vector<std::uint32_t> m_generations;
+    std::vector<unsigned char> m_launching;
+    std::vector<WindowId> m_windows;
+    std::vector<IconTexture> m_icons;
+    std::vector<TelemetrySample> m_telemetry;
+
+    // Cold, indexed by slot
+    std::vector<AppInfo> m_info;
+    std::vector<std::string> m_loadingLabels;
+    std::vector<std::shared_ptr<LaunchedProcess>> m_processes;
+    std::vector<CancellationSource> m_launches;
+
+    // Live slots in display order, and removed slots ready for reuse
+    std::vector<std::uint32_t> m_order;
+    std::vector<std::uint32_t> m_freeSlots;
+    int m_launchingCount = 0;
+};
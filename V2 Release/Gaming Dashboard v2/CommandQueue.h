@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// Bounded lock-free multi-producer / single-consumer queue (Vyukov-style ring with per-cell sequence numbers).
+// Producers never block each other; TryPush fails only when the ring is full.
+template <typename T, size_t Capacity>
+class CommandQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    CommandQueue() {
+        for (size_t i = 0; i < Capacity; i++) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~CommandQueue() {
+        T value;
+        while (TryPop(value)) {}
+    }
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    // Any thread
+    bool TryPush(T&& value) {
+        size_t position = m_enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &m_cells[position & (Capacity - 1)];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)position;
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                position = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (cell->storage) T(std::move(value));
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only
+    bool TryPop(T& value) {
+        Cell* cell = &m_cells[m_dequeuePos & (Capacity - 1)];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        if ((intptr_t)sequence - (intptr_t)(m_dequeuePos + 1) < 0) return false;
+
+        T* stored = std::launder(reinterpret_cast<T*>(cell->storage));
+        value = std::move(*stored);
+        stored->~T();
+        cell->sequence.store(m_dequeuePos + Capacity, std::memory_order_release);
+        m_dequeuePos++;
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    // Keep the producer and consumer cursors on separate cache lines
+    alignas(64) std::atomic<size_t> m_enqueuePos{ 0 };
+    alignas(64) size_t m_dequeuePos = 0;
+    alignas(64) Cell m_cells[Capacity];
+};
@@ -0,0 +1,212 @@
+#include "Executor.h"
+#include "FrameProfiler.h"
+
+#include "WindowIndex.h"
+
+// Cancellation
+bool CancellationToken::IsCancelled() const
+{
+    if (!m_state) return false;
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->cancelled;
+}
+
+uint64_t CancellationToken::Register(std::function<void()> callback) const
+{
+    if (!m_state) return 0;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (!m_state->cancelled) {
+            uint64_t id = m_state->nextId++;
+            m_state->callbacks[id] = std::move(callback);
+            return id;
+        }
+    }
+    callback();
+    return 0;
+}
+
+void CancellationToken::Unregister(uint64_t id) const
+{
+    if (!m_state || id == 0) return;
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    m_state->callbacks.erase(id);
+}
+
+void CancellationSource::Cancel()
+{
+    std::map<uint64_t, std::function<void()>> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (m_state->cancelled) return;
+        m_state->cancelled = true;
+        callbacks.swap(m_state->callbacks);
+    }
+    for (auto& entry : callbacks) entry.second();
+}
+
+// Executor
+Executor::Executor(int threadCount)
+{
+    for (int i = 0; i < threadCount; i++) {
+        m_workers.emplace_back([this]() { WorkerThread(); });
+    }
+}
+
+Executor::~Executor()
+{
+    Shutdown();
+}
+
+void Executor::Post(std::function<void()> work)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_ready.push_back(std::move(work));
+    }
+    m_wake.notify_one();
+}
+
+uint64_t Executor::PostAfter(int delayMs, std::function<void()> work)
+{
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        id = m_nextTimerId++;
+        m_timers.insert({ Clock::now() + std::chrono::milliseconds(delayMs), Timer{ id, std::move(work) } });
+    }
+    // Every worker may be sleeping until a later deadline
+    m_wake.notify_all();
+    return id;
+}
+
+void Executor::CancelTimer(uint64_t id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto it = m_timers.begin(); it != m_timers.end(); ++it) {
+        if (it->second.id == id) {
+            m_timers.erase(it);
+            return;
+        }
+    }
+}
+
+void Executor::Shutdown()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_tasksDone.wait(lock, [this]() { return m_taskCount == 0; });
+        if (m_stopping) return;
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers) worker.join();
+    m_workers.clear();
+}
+
+void Executor::TaskStarted()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_taskCount++;
+}
+
+void Executor::TaskFinished()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--m_taskCount == 0) m_tasksDone.notify_all();
+}
+
+void Executor::WorkerThread()
+{
+    GD_PROFILE_THREAD("Executor");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        // Move due timers onto the ready queue
+        Clock::time_point now = Clock::now();
+        while (!m_timers.empty() && m_timers.begin()->first <= now) {
+            m_ready.push_back(std::move(m_timers.begin()->second.work));
+            m_timers.erase(m_timers.begin());
+        }
+
+        if (!m_ready.empty()) {
+            std::function<void()> work = std::move(m_ready.front());
+            m_ready.pop_front();
+            lock.unlock();
+            {
+                GD_PROFILE_ZONE("Executor job");
+                work();
+            }
+            lock.lock();
+            continue;
+        }
+
+        if (m_stopping) return;
+        if (m_timers.empty()) {
+            m_wake.wait(lock);
+        }
+        else {
+            m_wake.wait_until(lock, m_timers.begin()->first);
+        }
+    }
+}
+
+void Spawn(Executor& executor, Task task)
+{
+    task.handle.promise().executor = &executor;
+    executor.TaskStarted();
+    executor.Post([handle = task.handle]() { handle.resume(); });
+}
+
+// Awaitables
+DelayAwaitable::DelayAwaitable(Executor& executor, int delayMs, CancellationToken token)
+    : m_delayMs(delayMs), m_token(std::move(token)), m_state(std::make_shared<State>())
+{
+    m_state->executor = &executor;
+}
+
+void DelayAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    std::shared_ptr<State> state = m_state;
+    // Completion may race with setup; await_resume takes the same lock before tearing down
+    std::lock_guard<std::mutex> lock(state->setupMutex);
+    state->handle = handle;
+    state->timer = state->executor->PostAfter(m_delayMs, [state]() {
+        state->Complete([&]() { state->elapsed = true; });
+    });
+    state->cancelRegistration = m_token.Register([state]() { state->Complete([]() {}); });
+}
+
+bool DelayAwaitable::await_resume()
+{
+    std::lock_guard<std::mutex> lock(m_state->setupMutex);
+    m_state->executor->CancelTimer(m_state->timer);
+    m_token.Unregister(m_state->cancelRegistration);
+    return m_state->elapsed;
+}
+
+WindowAwaitable::WindowAwaitable(Executor& executor, WindowIndex& index, WindowPredicate predicate, int timeoutMs, CancellationToken token)
+    : m_index(index), m_predicate(std::move(predicate)), m_timeoutMs(timeoutMs), m_token(std::move(token)), m_state(std::make_shared<State>())
+{
+    m_state->executor = &executor;
+}
+
+void WindowAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    std::shared_ptr<State> state = m_state;
+    std::lock_guard<std::mutex> lock(state->setupMutex);
+    state->handle = handle;
+    state->watch = m_index.Watch(m_predicate, [state](WindowId window) {
+        state->Complete([&]() { state->window = window; });
+    });
+    state->timer = state->executor->PostAfter(m_timeoutMs, [state]() { state->Complete([]() {}); });
+    state->cancelRegistration = m_token.Register([state]() { state->Complete([]() {}); });
+}
+
+WindowId WindowAwaitable::await_resume()
+{
+    std::lock_guard<std::mutex> lock(m_state->setupMutex);
+    m_index.CancelWatch(m_state->watch);
+    m_state->executor->CancelTimer(m_state->timer);
+    m_token.Unregister(m_state->cancelRegistration);
+    return m_state->window;
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "WindowSystem.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WindowIndex;
+
+// Shared cancellation flag; callbacks run on the thread that calls Cancel()
+struct CancellationState {
+    std::mutex mutex;
+    bool cancelled = false;
+    uint64_t nextId = 1;
+    std::map<uint64_t, std::function<void()>> callbacks;
+};
+
+class CancellationToken {
+public:
+    CancellationToken() = default;
+    explicit CancellationToken(std::shared_ptr<CancellationState> state) : m_state(std::move(state)) {}
+
+    bool IsCancelled() const;
+    // Runs callback on cancellation (immediately if already cancelled). Returns 0 if it already ran.
+    uint64_t Register(std::function<void()> callback) const;
+    void Unregister(uint64_t id) const;
+
+private:
+    std::shared_ptr<CancellationState> m_state;
+};
+
+class CancellationSource {
+public:
+    CancellationSource() : m_state(std::make_shared<CancellationState>()) {}
+
+    void Cancel();
+    CancellationToken Token() const { return CancellationToken(m_state); }
+
+private:
+    std::shared_ptr<CancellationState> m_state;
+};
+
+// Small shared thread pool with timers. Coroutines park here as suspended frames, not as threads.
+class Executor {
+public:
+    explicit Executor(int threadCount);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    void Post(std::function<void()> work);
+    // Runs work after delayMs unless cancelled first. Returns an id for CancelTimer.
+    uint64_t PostAfter(int delayMs, std::function<void()> work);
+    void CancelTimer(uint64_t id);
+
+    // Waits for every spawned task to finish, then joins the workers. Cancel tasks first.
+    void Shutdown();
+
+    void TaskStarted();
+    void TaskFinished();
+
+    struct ScheduleAwaitable {
+        Executor& executor;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) { executor.Post([handle]() { handle.resume(); }); }
+        void await_resume() const noexcept {}
+    };
+
+    // co_await executor.Schedule() continues on a worker thread
+    ScheduleAwaitable Schedule() { return { *this }; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Timer {
+        uint64_t id;
+        std::function<void()> work;
+    };
+
+    void WorkerThread();
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_tasksDone;
+    std::deque<std::function<void()>> m_ready;
+    std::multimap<Clock::time_point, Timer> m_timers;
+    uint64_t m_nextTimerId = 1;
+    int m_taskCount = 0;
+    bool m_stopping = false;
+    std::vector<std::thread> m_workers;
+};
+
+// Fire-and-forget coroutine. Starts suspended; Spawn() hands it to an executor.
+struct Task {
+    struct promise_type {
+        Executor* executor = nullptr;
+
+        ~promise_type() {
+            if (executor) executor->TaskFinished();
+        }
+
+        Task get_return_object() { return Task{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+void Spawn(Executor& executor, Task task);
+
+// State shared by an awaitable and the callbacks that may resume it; the first callback to complete wins
+struct ResumeState {
+    std::atomic<bool> completed{ false };
+    std::mutex setupMutex;
+    std::coroutine_handle<> handle;
+    Executor* executor = nullptr;
+
+    template <typename SetResult>
+    void Complete(SetResult&& setResult) {
+        if (completed.exchange(true)) return;
+        setResult();
+        executor->Post([this]() { handle.resume(); });
+    }
+};
+
+// co_await Delay(...) yields true once delayMs has passed, false if the token was cancelled first
+class DelayAwaitable {
+public:
+    DelayAwaitable(Executor& executor, int delayMs, CancellationToken token);
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle);
+    bool await_resume();
+
+private:
+    struct State : ResumeState {
+        bool elapsed = false;
+        uint64_t timer = 0;
+        uint64_t cancelRegistration = 0;
+    };
+
+    int m_delayMs;
+    CancellationToken m_token;
+    std::shared_ptr<State> m_state;
+};
+
+inline DelayAwaitable Delay(Executor& executor, int delayMs, CancellationToken token = CancellationToken())
+{
+    return DelayAwaitable(executor, delayMs, std::move(token));
+}
+
+// co_await WaitForWindowAsync(...) yields the first matching window, or 0 on timeout / cancellation
+class WindowAwaitable {
+public:
+    WindowAwaitable(Executor& executor, WindowIndex& index, WindowPredicate predicate, int timeoutMs, CancellationToken token);
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle);
+    WindowId await_resume();
+
+private:
+    struct State : ResumeState {
+        WindowId window = 0;
+        int watch = 0;
+        uint64_t timer = 0;
+        uint64_t cancelRegistration = 0;
+    };
+
+    WindowIndex& m_index;
+    WindowPredicate m_predicate;
+    int m_timeoutMs;
+    CancellationToken m_token;
+    std::shared_ptr<State> m_state;
+};
+
+inline WindowAwaitable WaitForWindowAsync(Executor& executor, WindowIndex& index, WindowPredicate predicate, int timeoutMs,
+    CancellationToken token = CancellationToken())
+{
+    return WindowAwaitable(executor, index, std::move(predicate), timeoutMs, std::move(token));
+}
@@ -0,0 +1,204 @@
+#include "FrameProfiler.h"
+
+#include <cstdio>
+#include <fstream>
+#include <utility>
+
+bool ProfilingEnabled()
+{
+#ifdef GD_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+namespace {
+
+// Gives the thread's slot back when the thread exits
+struct ThreadSlot {
+    ProfileThread* thread = nullptr;
+    bool full = false;
+
+    ~ThreadSlot() {
+        if (thread) thread->inUse.store(false, std::memory_order_release);
+    }
+};
+
+thread_local ThreadSlot t_slot;
+
+void WriteJsonString(std::ostream& out, const char* text)
+{
+    out << '"';
+    for (const char* c = text ? text : ""; *c; c++) {
+        if (*c == '"' || *c == '\\') out << '\\';
+        if ((unsigned char)*c >= 0x20) out << *c;
+    }
+    out << '"';
+}
+
+}
+
+FrameProfiler& FrameProfiler::Instance()
+{
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+FrameProfiler::FrameProfiler()
+    : m_baseTicks(ProfileTimestamp()), m_baseTime(std::chrono::steady_clock::now())
+{
+    // Reserved up front so steady-state frames never allocate
+    m_frame.zones.reserve(MAX_FRAME_ZONES);
+    m_lastFrame.zones.reserve(MAX_FRAME_ZONES);
+    for (ProfileFrame& capture : m_captures) capture.zones.reserve(MAX_FRAME_ZONES);
+}
+
+FrameProfiler::~FrameProfiler() = default;
+
+ProfileThread* FrameProfiler::CurrentThread()
+{
+    if (t_slot.thread || t_slot.full) return t_slot.thread;
+
+    std::lock_guard<std::mutex> lock(m_threadsMutex);
+    int count = m_threadCount.load(std::memory_order_relaxed);
+    // A slot left by an exited thread; the UI thread keeps draining it, only the producer changes
+    for (int i = 0; i < count; i++) {
+        bool expected = false;
+        if (m_threads[i]->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            m_threads[i]->name.store(nullptr, std::memory_order_relaxed);
+            m_threads[i]->depth = 0;
+            t_slot.thread = m_threads[i].get();
+            return t_slot.thread;
+        }
+    }
+    if (count == MAX_THREADS) {
+        t_slot.full = true;
+        return nullptr;
+    }
+
+    m_threads[count] = std::make_unique<ProfileThread>();
+    m_threads[count]->index = (uint16_t)count;
+    m_threads[count]->inUse.store(true, std::memory_order_relaxed);
+    m_threadCount.store(count + 1, std::memory_order_release);
+    t_slot.thread = m_threads[count].get();
+    return t_slot.thread;
+}
+
+void FrameProfiler::SetThreadName(const char* name)
+{
+    if (ProfileThread* thread = CurrentThread()) thread->name.store(name, std::memory_order_relaxed);
+}
+
+const char* FrameProfiler::ThreadName(int thread) const
+{
+    if (thread < 0 || thread >= ThreadCount()) return nullptr;
+    return m_threads[thread]->name.load(std::memory_order_relaxed);
+}
+
+const ProfileFrame& FrameProfiler::Capture(int i) const
+{
+    // Once the ring has wrapped the oldest capture is the next one to be overwritten
+    int first = m_captureCount < MAX_CAPTURES ? 0 : m_nextCapture;
+    return m_captures[(first + i) % MAX_CAPTURES];
+}
+
+void FrameProfiler::BeginFrame()
+{
+    m_frame.index = m_frameIndex;
+    m_frame.start = ProfileTimestamp();
+}
+
+void FrameProfiler::EndFrame()
+{
+    m_frame.end = ProfileTimestamp();
+    Calibrate();
+    Collect(m_frame);
+
+    float durationMs = (float)TicksToMs(m_frame.end - m_frame.start);
+    m_history[m_frameIndex % HISTORY_FRAMES] = durationMs;
+    m_frameIndex++;
+
+    if (durationMs > m_budgetMs) {
+        // Copy assignment reuses the capture's reserved storage
+        m_captures[m_nextCapture] = m_frame;
+        m_nextCapture = (m_nextCapture + 1) % MAX_CAPTURES;
+        if (m_captureCount < MAX_CAPTURES) m_captureCount++;
+    }
+
+    std::swap(m_lastFrame, m_frame);
+    m_frame.zones.clear();
+    m_frame.droppedZones = 0;
+}
+
+// Ticks per second from the time since start-up, so rdtsc needs no separate calibration pause
+void FrameProfiler::Calibrate()
+{
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_baseTime).count();
+    if (seconds > 0.01) m_ticksPerSecond = (ProfileTimestamp() - m_baseTicks) / seconds;
+}
+
+void FrameProfiler::Collect(ProfileFrame& frame)
+{
+    int count = ThreadCount();
+    for (int i = 0; i < count; i++) {
+        ProfileThread& thread = *m_threads[i];
+        frame.droppedZones += thread.dropped.exchange(0, std::memory_order_relaxed);
+        ProfileZone zone;
+        while (thread.zones.TryPop(zone)) {
+            if (frame.zones.size() < MAX_FRAME_ZONES) {
+                frame.zones.push_back(zone);
+            }
+            else {
+                frame.droppedZones++;
+            }
+        }
+    }
+}
+
+bool FrameProfiler::ExportChromeTrace(const std::string& path) const
+{
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+
+    // Frames get their own row after the thread slots
+    const int framesRow = MAX_THREADS;
+    char line[256];
+    out << "{\"traceEvents\":[\n";
+    snprintf(line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Frames\"}}", framesRow);
+    out << line;
+    int threads = ThreadCount();
+    for (int i = 0; i < threads; i++) {
+        snprintf(line, sizeof(line), ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", i);
+        out << line;
+        const char* name = ThreadName(i);
+        if (name) {
+            WriteJsonString(out, name);
+        }
+        else {
+            out << "\"Thread " << i << '"';
+        }
+        out << "}}";
+    }
+
+    // Timestamps in microseconds since the profiler started
+    auto writeFrame = [&](const ProfileFrame& frame) {
+        snprintf(line, sizeof(line), ",\n{\"name\":\"Frame %llu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+            (unsigned long long)frame.index, TicksToMs(frame.start - m_baseTicks) * 1000.0, TicksToMs(frame.end - frame.start) * 1000.0, framesRow);
+        out << line;
+        for (const ProfileZone& zone : frame.zones) {
+            out << ",\n{\"name\":";
+            WriteJsonString(out, zone.name);
+            snprintf(line, sizeof(line), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                TicksToMs(zone.start - m_baseTicks) * 1000.0, TicksToMs(zone.end - zone.start) * 1000.0, (int)zone.thread);
+            out << line;
+        }
+    };
+    for (int i = 0; i < m_captureCount; i++) writeFrame(Capture(i));
+    // The last frame may also be the newest capture
+    if (m_captureCount == 0 || Capture(m_captureCount - 1).index != m_lastFrame.index) writeFrame(m_lastFrame);
+
+    out << "\n]}\n";
+    out.close();
+    return !out.fail();
+}
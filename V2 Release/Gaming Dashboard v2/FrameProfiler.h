@@ -0,0 +1,196 @@
+#pragma once
+
+#include "SpscRing.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// Scoped-zone frame profiler. Zones are recorded into per-thread SPSC rings and collected by the UI
+// thread at the end of each frame. The GD_PROFILE_* macros compile to nothing unless GD_PROFILE is
+// defined; the FrameProfiler class itself is always built so the panel code does not need #ifdefs.
+//
+//     GD_PROFILE_THREAD("UI");        // optional name for the calling thread
+//     GD_PROFILE_FRAME();             // UI thread: the rest of this scope is one frame
+//     GD_PROFILE_ZONE("Present");     // the rest of this scope is one zone
+//
+// Zone names must be string literals (only the pointer is stored). A zone must not span a co_await:
+// it has to end on the thread it started on.
+
+#ifdef GD_PROFILE
+#define GD_PROFILE_CONCAT_(a, b) a##b
+#define GD_PROFILE_CONCAT(a, b) GD_PROFILE_CONCAT_(a, b)
+#define GD_PROFILE_ZONE(name) ProfileScope GD_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define GD_PROFILE_FRAME() ProfileFrameScope GD_PROFILE_CONCAT(profileFrame, __LINE__)
+#define GD_PROFILE_THREAD(name) FrameProfiler::Instance().SetThreadName(name)
+#else
+#define GD_PROFILE_ZONE(name) ((void)0)
+#define GD_PROFILE_FRAME() ((void)0)
+#define GD_PROFILE_THREAD(name) ((void)0)
+#endif
+
+bool ProfilingEnabled();
+
+// rdtsc where available (invariant on every CPU this runs on), steady_clock nanoseconds elsewhere.
+// FrameProfiler::TicksToMs converts either.
+inline uint64_t ProfileTimestamp()
+{
+#if defined(_M_X64) || defined(__x86_64__)
+    return __rdtsc();
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct ProfileZone {
+    const char* name = nullptr;
+    uint64_t start = 0;         // ProfileTimestamp ticks
+    uint64_t end = 0;
+    uint16_t thread = 0;        // FrameProfiler thread slot
+    uint16_t depth = 0;         // nesting level on that thread
+};
+
+// Zones recorded by one thread, waiting for the UI thread to collect them. Slots are reused once
+// their thread exits.
+struct ProfileThread {
+    static const size_t RING_CAPACITY = 4096;
+
+    SpscRing<ProfileZone, RING_CAPACITY> zones;
+    std::atomic<const char*> name{ nullptr };
+    std::atomic<bool> inUse{ false };
+    std::atomic<uint64_t> dropped{ 0 };
+    uint16_t index = 0;
+    uint16_t depth = 0;
+};
+
+// Zones collected during one frame, from every thread
+struct ProfileFrame {
+    uint64_t index = 0;
+    uint64_t start = 0;
+    uint64_t end = 0;
+    uint64_t droppedZones = 0;
+    std::vector<ProfileZone> zones;
+};
+
+class FrameProfiler {
+public:
+    static const int MAX_THREADS = 64;
+    static const size_t MAX_FRAME_ZONES = 4096;
+    static const int HISTORY_FRAMES = 240;
+    static const int MAX_CAPTURES = 8;
+    // Present waits for vsync, so a healthy frame already takes ~16.7 ms; two intervals is the first real miss
+    static constexpr float DEFAULT_BUDGET_MS = 33.4f;
+
+    static FrameProfiler& Instance();
+
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    // Any thread. name must outlive the thread (a string literal).
+    void SetThreadName(const char* name);
+    // Ring of the calling thread, registering it on first use; null once MAX_THREADS threads are live
+    ProfileThread* CurrentThread();
+
+    // UI thread only. EndFrame collects every thread's zones, updates the history and keeps a copy of
+    // the frame when it went over budget. Nothing here allocates after the first frame.
+    void BeginFrame();
+    void EndFrame();
+
+    float BudgetMs() const { return m_budgetMs; }
+    void SetBudgetMs(float budgetMs) { m_budgetMs = budgetMs; }
+
+    const ProfileFrame& LastFrame() const { return m_lastFrame; }
+    // Slow frames, oldest first
+    int CaptureCount() const { return m_captureCount; }
+    const ProfileFrame& Capture(int i) const;
+    void ClearCaptures() { m_captureCount = 0; }
+
+    // Frame durations in ms; a ring starting at HistoryOffset(), as ImGui::PlotLines takes it
+    const float* History() const { return m_history; }
+    int HistoryOffset() const { return (int)(m_frameIndex % HISTORY_FRAMES); }
+
+    double TicksToMs(uint64_t ticks) const { return ticks * 1000.0 / m_ticksPerSecond; }
+    // Thread slots ever used; names can be null
+    int ThreadCount() const { return m_threadCount.load(std::memory_order_acquire); }
+    const char* ThreadName(int thread) const;
+
+    // Writes the captured slow frames and the last frame as Chrome trace JSON (chrome://tracing, Perfetto)
+    bool ExportChromeTrace(const std::string& path) const;
+
+private:
+    FrameProfiler();
+    ~FrameProfiler();
+
+    void Calibrate();
+    void Collect(ProfileFrame& frame);
+
+    std::mutex m_threadsMutex;
+    std::unique_ptr<ProfileThread> m_threads[MAX_THREADS];
+    std::atomic<int> m_threadCount{ 0 };
+
+    uint64_t m_baseTicks;
+    std::chrono::steady_clock::time_point m_baseTime;
+    double m_ticksPerSecond = 1e9;
+
+    float m_budgetMs = DEFAULT_BUDGET_MS;
+    uint64_t m_frameIndex = 0;
+    ProfileFrame m_frame;
+    ProfileFrame m_lastFrame;
+    ProfileFrame m_captures[MAX_CAPTURES];
+    int m_captureCount = 0;
+    int m_nextCapture = 0;
+    float m_history[HISTORY_FRAMES] = {};
+};
+
+// Records one zone from construction to destruction on the calling thread
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : m_name(name), m_thread(FrameProfiler::Instance().CurrentThread()) {
+        if (!m_thread) return;
+        m_depth = m_thread->depth++;
+        m_start = ProfileTimestamp();
+    }
+
+    ~ProfileScope() {
+        if (!m_thread) return;
+        ProfileZone zone;
+        zone.name = m_name;
+        zone.start = m_start;
+        zone.end = ProfileTimestamp();
+        zone.thread = m_thread->index;
+        zone.depth = m_depth;
+        m_thread->depth--;
+        if (!m_thread->zones.TryPush(zone)) m_thread->dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name;
+    ProfileThread* m_thread;
+    uint64_t m_start = 0;
+    uint16_t m_depth = 0;
+};
+
+// One frame on the UI thread from construction to destruction
+class ProfileFrameScope {
+public:
+    ProfileFrameScope() { FrameProfiler::Instance().BeginFrame(); }
+    ~ProfileFrameScope() { FrameProfiler::Instance().EndFrame(); }
+
+    ProfileFrameScope(const ProfileFrameScope&) = delete;
+    ProfileFrameScope& operator=(const ProfileFrameScope&) = delete;
+};
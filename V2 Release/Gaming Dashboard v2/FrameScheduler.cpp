@@ -0,0 +1,87 @@
+#include "FrameScheduler.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+FrameScheduler::FrameScheduler()
+{
+#ifdef _WIN32
+    m_wakeEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+#endif
+}
+
+FrameScheduler::~FrameScheduler()
+{
+#ifdef _WIN32
+    if (m_wakeEvent) CloseHandle((HANDLE)m_wakeEvent);
+#endif
+}
+
+void FrameScheduler::Wakeup()
+{
+    m_woken = true;
+#ifdef _WIN32
+    SetEvent((HANDLE)m_wakeEvent);
+#else
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_wake.notify_one();
+#endif
+}
+
+void FrameScheduler::RequestFrames(int count)
+{
+    m_framesOwed = std::max(m_framesOwed, count);
+}
+
+void FrameScheduler::RequestFrameAfter(int delayMs)
+{
+    m_deadline = std::min(m_deadline, Clock::now() + std::chrono::milliseconds(delayMs));
+}
+
+void FrameScheduler::WaitForWork()
+{
+    if (m_framesOwed > 0 || m_woken) return;
+
+    Clock::time_point now = Clock::now();
+    if (m_deadline <= now) return;
+
+#ifdef _WIN32
+    DWORD timeout = INFINITE;
+    if (m_deadline != Clock::time_point::max()) {
+        timeout = (DWORD)std::chrono::ceil<std::chrono::milliseconds>(m_deadline - now).count();
+    }
+    HANDLE wakeEvent = (HANDLE)m_wakeEvent;
+    MsgWaitForMultipleObjectsEx(1, &wakeEvent, timeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+#else
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_deadline == Clock::time_point::max()) {
+        m_wake.wait(lock, [this]() { return m_woken.load(); });
+    }
+    else {
+        m_wake.wait_until(lock, m_deadline, [this]() { return m_woken.load(); });
+    }
+#endif
+    m_wakeups++;
+}
+
+bool FrameScheduler::BeginFrame()
+{
+    if (m_woken.exchange(false)) {
+        m_framesOwed = std::max(m_framesOwed, 1);
+    }
+    if (m_deadline <= Clock::now()) {
+        m_deadline = Clock::time_point::max();
+        m_framesOwed = std::max(m_framesOwed, 1);
+    }
+    if (m_framesOwed == 0) return false;
+
+    m_framesOwed--;
+    m_framesRendered++;
+    return true;
+}
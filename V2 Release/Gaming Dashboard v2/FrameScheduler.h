@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <condition_variable>
+#include <mutex>
+#endif
+
+// Decides when the UI thread should render. Between frames the thread sleeps in WaitForWork()
+// until window messages arrive, another thread calls Wakeup(), or a requested deadline passes.
+class FrameScheduler {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    // Frames rendered after input so ImGui hover/active states settle
+    static const int SETTLE_FRAMES = 3;
+
+    FrameScheduler();
+    ~FrameScheduler();
+
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    // Any thread: there is work for the UI thread (e.g. a queued launch result)
+    void Wakeup();
+
+    // UI thread only
+    void RequestFrames(int count);
+    void RequestFrameAfter(int delayMs);
+
+    // Blocks unless a frame is already owed. On Win32 also returns when messages are waiting.
+    void WaitForWork();
+    // True if a frame should be rendered now; consumes one owed frame
+    bool BeginFrame();
+
+    uint64_t FramesRendered() const { return m_framesRendered; }
+    uint64_t Wakeups() const { return m_wakeups; }
+
+private:
+    int m_framesOwed = SETTLE_FRAMES;
+    Clock::time_point m_deadline = Clock::time_point::max();
+    std::atomic<bool> m_woken{ false };
+    uint64_t m_framesRendered = 0;
+    uint64_t m_wakeups = 0;
+
+#ifdef _WIN32
+    void* m_wakeEvent = nullptr;
+#else
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+#endif
+};
@@ -0,0 +1,1430 @@
+#include "GamingDashboard.h"
+
+#include "IconLoader.h"
+#include "ImageResample.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+// strcpy_s is MSVC-only; truncates the same way
+template <size_t Size>
+static void CopyToBuffer(char (&buffer)[Size], const std::string& text)
+{
+    snprintf(buffer, Size, "%s", text.c_str());
+}
+
+// Time left until deadline, at least 1 ms so a wait that starts late still looks once
+static int RemainingMs(std::chrono::steady_clock::time_point deadline)
+{
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+    return left < 1 ? 1 : (int)left;
+}
+
+DashboardBackends CreatePlatformBackends()
+{
+    DashboardBackends backends;
+    backends.windowSystem = CreatePlatformWindowSystem();
+    backends.processLauncher = CreatePlatformProcessLauncher();
+    backends.resourceGovernor = CreatePlatformResourceGovernor();
+    backends.telemetryProvider = CreatePlatformTelemetryProvider();
+    backends.diskMonitor = CreatePlatformDiskMonitor();
+    backends.settingsStore = std::make_unique<FileSettingsStore>(DefaultSettingsPath());
+#ifdef _WIN32
+    backends.legacySettingsStore = std::make_unique<RegistrySettingsStore>();
+#endif
+    return backends;
+}
+
+void ApplyDashboardStyle()
+{
+    ImGui::StyleColorsDark();
+
+    // Custom gaming theme
+    ImGuiStyle& style = ImGui::GetStyle();
+    style.WindowRounding = 8.0f;
+    style.FrameRounding = 4.0f;
+    style.PopupRounding = 4.0f;
+    style.ScrollbarRounding = 4.0f;
+    style.GrabRounding = 4.0f;
+    style.TabRounding = 4.0f;
+
+    ImVec4* colors = style.Colors;
+    colors[ImGuiCol_WindowBg] = ImVec4(0.05f, 0.07f, 0.09f, 1.00f);
+    colors[ImGuiCol_ChildBg] = ImVec4(0.09f, 0.11f, 0.13f, 1.00f);
+    colors[ImGuiCol_PopupBg] = ImVec4(0.09f, 0.11f, 0.13f, 1.00f);
+    colors[ImGuiCol_Border] = ImVec4(0.19f, 0.22f, 0.24f, 1.00f);
+    colors[ImGuiCol_FrameBg] = ImVec4(0.13f, 0.15f, 0.17f, 1.00f);
+    colors[ImGuiCol_FrameBgHovered] = ImVec4(0.19f, 0.22f, 0.24f, 1.00f);
+    colors[ImGuiCol_FrameBgActive] = ImVec4(0.00f, 0.83f, 1.00f, 0.40f);
+    colors[ImGuiCol_TitleBg] = ImVec4(0.05f, 0.07f, 0.09f, 1.00f);
+    colors[ImGuiCol_TitleBgActive] = ImVec4(0.05f, 0.07f, 0.09f, 1.00f);
+    colors[ImGuiCol_MenuBarBg] = ImVec4(0.09f, 0.11f, 0.13f, 1.00f);
+    colors[ImGuiCol_ScrollbarBg] = ImVec4(0.05f, 0.07f, 0.09f, 1.00f);
+    colors[ImGuiCol_ScrollbarGrab] = ImVec4(0.19f, 0.22f, 0.24f, 1.00f);
+    colors[ImGuiCol_ScrollbarGrabHovered] = ImVec4(0.25f, 0.28f, 0.30f, 1.00f);
+    colors[ImGuiCol_ScrollbarGrabActive] = ImVec4(0.00f, 0.83f, 1.00f, 1.00f);
+    colors[ImGuiCol_CheckMark] = ImVec4(0.00f, 0.83f, 1.00f, 1.00f);
+    colors[ImGuiCol_SliderGrab] = ImVec4(0.00f, 0.83f, 1.00f, 1.00f);
+    colors[ImGuiCol_SliderGrabActive] = ImVec4(0.00f, 0.67f, 0.80f, 1.00f);
+    colors[ImGuiCol_Button] = ImVec4(0.18f, 0.18f, 0.19f, 1.00f);
+    colors[ImGuiCol_ButtonHovered] = ImVec4(0.25f, 0.25f, 0.25f, 1.00f);
+    colors[ImGuiCol_ButtonActive] = ImVec4(0.00f, 0.83f, 1.00f, 1.00f);
+    colors[ImGuiCol_Header] = ImVec4(0.18f, 0.18f, 0.19f, 1.00f);
+    colors[ImGuiCol_HeaderHovered] = ImVec4(0.25f, 0.25f, 0.25f, 1.00f);
+    colors[ImGuiCol_HeaderActive] = ImVec4(0.00f, 0.83f, 1.00f, 1.00f);
+}
+
+GamingDashboard::GamingDashboard(DashboardBackends backends)
+    : m_windowSystem(std::move(backends.windowSystem)),
+      m_processLauncher(std::move(backends.processLauncher)),
+      m_resourceGovernor(std::move(backends.resourceGovernor)),
+      m_iconCachePath(std::move(backends.iconCachePath)),
+      m_settingsStore(std::move(backends.settingsStore)),
+      m_settingsWriter(*m_settingsStore),
+      m_legacySettingsStore(std::move(backends.legacySettingsStore))
+{
+    m_windowIndex = std::make_unique<WindowIndex>(*m_windowSystem);
+    m_telemetrySampler = std::make_unique<TelemetrySampler>(std::move(backends.telemetryProvider));
+    m_telemetrySampler->SetChangesOnly(true);
+    m_telemetrySampler->SetOnPublish([this]() {
+        if (FrameScheduler* scheduler = m_frameScheduler.load()) scheduler->Wakeup();
+    });
+    m_launchScheduler = std::make_unique<LaunchScheduler>(m_launchExecutor, std::move(backends.diskMonitor));
+    m_chromeApp = m_apps.Add({ .name = "Chrome", .commandLine = "C:\\Program Files\\Google\\Chrome\\Application\\chrome.exe",
+        .iconPath = "icons/chrome.png", .windowTitle = "Chrome" });
+    // Games started from the Steam tab belong to its process tree and run in their own windows
+    m_steamApp = m_apps.Add({ .name = "Steam", .commandLine = "C:\\Program Files (x86)\\Steam\\Steam.exe", .iconPath = "icons/steam.png",
+        .windowTitle = "Steam", .throttleWhenHidden = false });
+    // Discord shows a small splash screen first - its real window is larger than 300x200
+    AppDesc discord = { .name = "Discord", .commandLine = "C:\\Users\\PC\\AppData\\Local\\Discord\\Update.exe --processStart Discord.exe",
+        .iconPath = "icons/discord.png", .windowTitle = "Discord" };
+    discord.readiness.minWidth = 301;
+    discord.readiness.minHeight = 201;
+    m_discordApp = m_apps.Add(discord);
+    LoadSettings();
+    CopyToBuffer(m_chromePathBuffer, m_apps.Info(m_chromeApp).commandLine);
+    CopyToBuffer(m_steamPathBuffer, m_apps.Info(m_steamApp).commandLine);
+    CopyToBuffer(m_discordPathBuffer, m_apps.Info(m_discordApp).commandLine);
+}
+
+GamingDashboard::~GamingDashboard()
+{
+    // Launches finishing during the shutdown below must not wait for a frame that never comes
+    m_shuttingDown = true;
+    // Stop pending launches before anything they reference goes away
+    m_apps.CancelAllLaunches();
+    m_launchExecutor.Shutdown();
+
+    // Embedded apps outlive the dashboard; do not leave them throttled
+    for (size_t i = 0; i < m_apps.Count(); i++) {
+        UnthrottleTab(m_apps.At(i));
+    }
+}
+
+void GamingDashboard::LoadIcons()
+{
+    // Sidebar decoration icons from the icons folder, then every app's icon
+    std::vector<std::string> paths = { "icons/controller.png", "icons/settings.png" };
+    std::vector<IconTexture*> targets = { &m_controllerIcon, &m_settingsIcon };
+    for (size_t i = 0; i < m_apps.Count(); i++) {
+        AppHandle app = m_apps.At(i);
+        if (!m_apps.Info(app).iconPath.empty()) {
+            paths.push_back(m_apps.Info(app).iconPath);
+            targets.push_back(&m_apps.Icon(app));
+        }
+    }
+
+    // Icons unchanged since the last run come straight out of the cache mapping
+    m_iconCache = std::make_unique<IconCache>(m_iconCachePath);
+    m_iconCache->Open();
+    std::vector<ImageView> views(paths.size());
+    std::vector<std::string> missingPaths;
+    std::vector<size_t> missing;
+    for (size_t i = 0; i < paths.size(); i++) {
+        views[i] = m_iconCache->Lookup(paths[i], ICON_TARGET_SIZE);
+        if (!views[i].IsValid()) {
+            missingPaths.push_back(paths[i]);
+            missing.push_back(i);
+        }
+    }
+
+    if (missing.empty()) {
+        for (size_t i = 0; i < paths.size(); i++) {
+            *targets[i] = m_iconAtlas.AddShared(views[i]);
+        }
+        return;
+    }
+
+    // Decode the rest in parallel, then pack everything into the atlas on this (render) thread
+    unsigned int threads = std::thread::hardware_concurrency();
+    Executor decodePool(threads > 1 ? (int)threads : 2);
+    std::vector<DecodedImage> images = DecodeImages(decodePool, missingPaths);
+    std::vector<ResampledImage> scaled(missing.size());
+    bool decodedAny = false;
+    for (size_t i = 0; i < missing.size(); i++) {
+        scaled[i] = ResampleToFit(images[i].View(), ICON_TARGET_SIZE, ResampleFilter::Lanczos3);
+        views[missing[i]] = scaled[i].View();
+        decodedAny = decodedAny || scaled[i].IsValid();
+    }
+    // Copied, because rewriting the cache below replaces the mapping
+    for (size_t i = 0; i < paths.size(); i++) {
+        *targets[i] = m_iconAtlas.Add(views[i]);
+    }
+
+    if (decodedAny) {
+        std::vector<IconCacheEntry> entries;
+        for (size_t i = 0; i < paths.size(); i++) {
+            entries.push_back({ paths[i], ICON_TARGET_SIZE, views[i] });
+        }
+        m_iconCache->Write(entries);
+    }
+}
+
+void GamingDashboard::OnWindowResize()
+{
+    m_layoutPending = true;
+}
+
+void GamingDashboard::ApplyPendingLayout()
+{
+    if (!m_layoutPending || !m_dashboardWindow) return;
+    m_layoutPending = false;
+
+    m_placements.clear();
+    for (size_t i = 0; i < m_apps.Count(); i++) {
+        WindowId window = m_apps.Window(m_apps.At(i));
+        if (window) m_placements.push_back(TabPlacement(window));
+    }
+    if (m_placements.empty()) return;
+    m_windowSystem->PlaceWindows(m_placements);
+    if (m_currentWindow) m_windowSystem->InvalidateWindow(m_currentWindow);
+}
+
+void GamingDashboard::LoadSettings()
+{
+    DashboardSettings settings = CurrentSettings();
+    if (!m_settingsStore->Load(settings)) {
+        if (m_settingsStore->Exists()) {
+            m_settingsReadOnly = true;
+            return;
+        }
+        if (!m_legacySettingsStore) return;
+        // First run with a settings file: bring over what older versions kept in the registry
+        if (!m_legacySettingsStore->Load(settings)) return;
+        m_settingsWriter.Save(settings);
+    }
+
+    m_apps.Info(m_chromeApp).commandLine = settings.chromePath;
+    m_apps.Info(m_steamApp).commandLine = settings.steamPath;
+    m_apps.Info(m_discordApp).commandLine = settings.discordPath;
+    for (size_t i = m_apps.Count(); i-- > 0;) {
+        if (m_apps.Info(m_apps.At(i)).custom) m_apps.Remove(m_apps.At(i));
+    }
+    for (const CustomAppSettings& saved : settings.customApps) {
+        m_apps.Add({ saved.name, saved.exePath, saved.iconPath, saved.windowTitle, true, saved.readiness, saved.throttleWhenHidden });
+    }
+    m_sessionTabs = settings.sessionTabs;
+    m_launchProfiles = settings.launchProfiles;
+    std::map<std::string, LaunchCost> costs;
+    for (const LaunchCostSettings& saved : settings.launchCosts) {
+        costs[saved.name] = { saved.readBytes, saved.startupMs };
+    }
+    m_launchScheduler->SetCosts(costs);
+    for (const LaunchLatencySettings& saved : settings.launchLatencies) {
+        LaunchLatency::AppHistograms& histograms = m_launchLatency.App(saved.name);
+        histograms[(size_t)LaunchPhase::ProcessStart].Parse(saved.processStart);
+        histograms[(size_t)LaunchPhase::FirstWindow].Parse(saved.firstWindow);
+        histograms[(size_t)LaunchPhase::WindowReady].Parse(saved.windowReady);
+        histograms[(size_t)LaunchPhase::Embedded].Parse(saved.embedded);
+        histograms[(size_t)LaunchPhase::Settle].Parse(saved.settle);
+    }
+}
+
+DashboardSettings GamingDashboard::CurrentSettings() const
+{
+    DashboardSettings settings;
+    settings.chromePath = m_apps.Info(m_chromeApp).commandLine;
+    settings.steamPath = m_apps.Info(m_steamApp).commandLine;
+    settings.discordPath = m_apps.Info(m_discordApp).commandLine;
+    for (size_t i = 0; i < m_apps.Count(); i++) {
+        AppHandle app = m_apps.At(i);
+        const AppInfo& info = m_apps.Info(app);
+        if (!info.custom) continue;
+        settings.customApps.push_back({ m_apps.Name(app), info.commandLine, info.iconPath, m_apps.WindowTitle(app),
+            info.readiness ? info.readiness->Rule() : ReadinessRule(), info.throttleWhenHidden });
+    }
+    settings.launchProfiles = m_launchProfiles;
+    for (const auto& cost : m_launchScheduler->Costs()) {
+        settings.launchCosts.push_back({ cost.first, cost.second.readBytes, cost.second.startupMs });
+    }
+    for (const auto& latency : m_launchLatency.Apps()) {
+        const LaunchLatency::AppHistograms& histograms = latency.second;
+        settings.launchLatencies.push_back({ latency.first, histograms[(size_t)LaunchPhase::ProcessStart].Format(),
+            histograms[(size_t)LaunchPhase::FirstWindow].Format(), histograms[(size_t)LaunchPhase::WindowReady].Format(),
+            histograms[(size_t)LaunchPhase::Embedded].Format(), histograms[(size_t)LaunchPhase::Settle].Format() });
+    }
+    // Embedded tabs, the current one first
+    auto addSessionTab = [&](AppHandle app) {
+        WindowInfo window;
+        if (!m_apps.Window(app) || !m_windowIndex->Lookup(m_apps.Window(app), window)) return;
+        settings.sessionTabs.push_back({ m_apps.Name(app), window.pid });
+    };
+    if (m_apps.Contains(m_currentApp)) addSessionTab(m_currentApp);
+    for (size_t i = 0; i < m_apps.Count(); i++) {
+        if (m_apps.At(i) != m_currentApp) addSessionTab(m_apps.At(i));
+    }
+    return settings;
+}
+
+void GamingDashboard::SaveSettings()
+{
+    if (m_settingsReadOnly) return;
+    m_settingsWriter.Save(CurrentSettings());
+}
+
+WindowId GamingDashboard::FindWindowByTitle(const std::string& titlePart)
+{
+    // Visible top-level windows only, served from the window index (no EnumWindows scan)
+    return m_windowIndex->FindByTitle(titlePart);
+}
+
+void GamingDashboard::EmbedWindow(WindowId childWindow, AppHandle app, std::shared_ptr<LaunchedProcess> process)
+{
+    if (!childWindow || !m_dashboardWindow) return;
+
+    // Windows we did not launch ourselves are tracked through their owning process
+    if (!process) {
+        WindowInfo info;
+        if (!m_windowSystem->QueryWindow(childWindow, info)) return;
+        process = m_processLauncher->Attach(info.pid);
+    }
+    TrackTabProcess(app, process);
+
+    // Reparent without the caption and frame
+    m_windowSystem->EmbedWindow(childWindow, m_dashboardWindow);
+
+    // Store the window
+    m_apps.SetWindow(app, childWindow);
+
+    // If this is the current tab, show it
+    if (app == m_currentApp) {
+        FormatWindowToFit(childWindow);
+        m_windowSystem->SetWindowVisible(childWindow, true);
+        m_currentWindow = childWindow;
+    }
+    else {
+        m_windowSystem->SetWindowVisible(childWindow, false);
+        ThrottleTab(app);
+    }
+}
+
+WindowPlacement GamingDashboard::TabPlacement(WindowId window) const
+{
+    int width = 0;
+    int height = 0;
+    m_windowSystem->ClientSize(m_dashboardWindow, width, height);
+
+    WindowPlacement placement;
+    placement.window = window;
+    placement.x = SIDEBAR_WIDTH;
+    placement.y = 0;
+    placement.width = width - SIDEBAR_WIDTH;
+    placement.height = height;
+
+    // Ensure minimum size
+    if (placement.width < 100) placement.width = 100;
+    if (placement.height < 100) placement.height = 100;
+    return placement;
+}
+
+void GamingDashboard::FormatWindowToFit(WindowId window)
+{
+    if (!window || !m_dashboardWindow || !m_windowSystem->IsWindowAlive(window)) return;
+
+    // Position the window
+    m_placements.clear();
+    m_placements.push_back(TabPlacement(window));
+    m_windowSystem->PlaceWindows(m_placements);
+
+    // Force redraw
+    m_windowSystem->InvalidateWindow(window);
+}
+
+void GamingDashboard::SwitchToTab(AppHandle app)
+{
+    // Hide current window
+    if (m_currentWindow && m_windowSystem->IsWindowAlive(m_currentWindow)) {
+        m_windowSystem->SetWindowVisible(m_currentWindow, false);
+    }
+    if (app != m_currentApp) ThrottleTab(m_currentApp);
+
+    m_currentApp = app;
+    UnthrottleTab(app);
+
+    // Show new tab if it exists
+    if (m_apps.Window(app)) {
+        WindowId tabWindow = m_apps.Window(app);
+        if (m_windowSystem->IsWindowAlive(tabWindow)) {
+            FormatWindowToFit(tabWindow);
+            m_windowSystem->SetWindowVisible(tabWindow, true);
+            m_currentWindow = tabWindow;
+        }
+    }
+    else {
+        m_currentWindow = 0;
+    }
+}
+
+void GamingDashboard::ThrottleTab(AppHandle app)
+{
+    if (!m_apps.Contains(app) || !m_apps.Process(app) || !m_apps.Info(app).throttleWhenHidden) return;
+    // The tab's own window is embedded, so any visible top-level window belongs to something else the
+    // tree started, like a game launched from the tab
+    m_windowIndex->VisibleWindowOwners(m_visibleOwners);
+    m_resourceGovernor->Throttle(*m_apps.Process(app), m_throttlePolicy, m_visibleOwners);
+}
+
+void GamingDashboard::UnthrottleTab(AppHandle app)
+{
+    if (!m_apps.Contains(app) || !m_apps.Process(app)) return;
+    m_resourceGovernor->Restore(*m_apps.Process(app));
+}
+
+void GamingDashboard::TrackTabProcess(AppHandle app, const std::shared_ptr<LaunchedProcess>& process)
+{
+    UnthrottleTab(app);
+    m_apps.Process(app) = process;
+    m_apps.Telemetry(app) = TelemetrySample();
+    if (!process) {
+        m_telemetrySampler->Untrack(m_apps.TelemetryKey(app));
+        return;
+    }
+    m_telemetrySampler->Track(m_apps.TelemetryKey(app), process);
+
+    const LaunchedProcess* key = process.get();
+    process->OnExit([this, app, key]() {
+        PostToUiThread([this, app, key]() { OnTabProcessExited(app, key); });
+    });
+}
+
+void GamingDashboard::OnTabProcessExited(AppHandle app, const LaunchedProcess* process)
+{
+    // Ignore exits of removed apps and of an earlier instance of a tab that has since been relaunched
+    if (!m_apps.Contains(app) || m_apps.Process(app).get() != process) return;
+    UnthrottleTab(app);
+    m_telemetrySampler->Untrack(m_apps.TelemetryKey(app));
+    m_apps.Process(app).reset();
+    m_apps.Telemetry(app) = TelemetrySample();
+
+    if (m_apps.Window(app) == m_currentWindow) m_currentWindow = 0;
+    m_apps.SetWindow(app, 0);
+}
+
+void GamingDashboard::PostToUiThread(std::function<void()> command)
+{
+    bool onUiThread = std::this_thread::get_id() == m_uiThread;
+    while (!m_uiCommands.TryPush(std::move(command))) {
+        if (onUiThread) {
+            // Nobody else will make room; run what is queued and then this, keeping the order
+            RunUiCommands();
+            command();
+            return;
+        }
+        // The UI thread stops draining the queue once the dashboard is being destroyed
+        if (m_shuttingDown) return;
+        std::this_thread::yield();
+    }
+    // The UI thread may be idle - make sure it renders a frame to run the command
+    if (FrameScheduler* scheduler = m_frameScheduler.load()) scheduler->Wakeup();
+}
+
+void GamingDashboard::RunUiCommands()
+{
+    std::function<void()> command;
+    while (m_uiCommands.TryPop(command)) {
+        command();
+    }
+}
+
+Task GamingDashboard::LaunchPipeline(AppHandle app, std::string name, std::string commandLine, std::string windowTitle,
+    std::shared_ptr<const ReadinessMatcher> readiness, LaunchTimeouts timeouts, bool activate, uint64_t priority, CancellationToken token)
+{
+    LaunchTimes times;
+    times.requested = LaunchTimes::Clock::now();
+    co_await m_launchExecutor.Schedule();
+
+    // Wait for the disk to have room for another cold start; the slot is held until the window is up
+    LaunchSlot slot = co_await m_launchScheduler->Admit(name, priority, token);
+    // Admitted, but cancelled since (or already before Admit queued it): give the slot back and start
+    // nothing. The UI thread still hears about it below, so the app stops showing as launching.
+    if (token.IsCancelled()) slot.Complete(false);
+
+    // Launch the application in its own job so its windows can be matched by process
+    std::shared_ptr<LaunchedProcess> process;
+    if (slot) {
+        GD_PROFILE_ZONE("Launch process");
+        process = m_processLauncher->Launch(commandLine);
+    }
+    WindowId window = 0;
+    if (process) {
+        times.processStarted = LaunchTimes::Clock::now();
+        auto deadline = times.processStarted + std::chrono::milliseconds(timeouts.windowMs);
+
+        // Wait for window to appear, woken by window create/show/rename events
+        WindowPredicate predicate = MatchProcessWindow(process, windowTitle);
+        window = co_await WaitForWindowAsync(m_launchExecutor, *m_windowIndex, predicate, timeouts.windowMs, token);
+        if (window) times.firstWindow = LaunchTimes::Clock::now();
+        if (window && readiness) {
+            // A splash screen or updater often comes first; wait for the window the app's rule accepts
+            predicate = [predicate, readiness](const WindowInfo& info) { return predicate(info) && readiness->Matches(info); };
+            window = co_await WaitForWindowAsync(m_launchExecutor, *m_windowIndex, predicate, RemainingMs(deadline), token);
+        }
+        if (window) times.windowMatched = times.windowReady = LaunchTimes::Clock::now();
+        slot.Complete(window != 0);
+
+        // Apps often resize or retitle their window while they finish starting; embed it once it goes
+        // quiet. A rule that asks for a stable window holds out until the window deadline; otherwise the
+        // settle limit learned from earlier launches bounds the wait.
+        bool requireStable = readiness && readiness->StableMs() > 0;
+        int quietMs = requireStable ? readiness->StableMs() : LaunchLatency::SETTLE_QUIET_MS;
+        auto settleDeadline = requireStable ? deadline : times.windowMatched + std::chrono::milliseconds(timeouts.settleMs);
+        bool stable = !requireStable;
+        WindowInfo settled;
+        if (window && (requireStable || timeouts.settleMs > 0) && m_windowIndex->Lookup(window, settled)) {
+            while (LaunchTimes::Clock::now() < settleDeadline) {
+                WindowPredicate changed = [settled](const WindowInfo& info) {
+                    return info.id == settled.id && (info.width != settled.width || info.height != settled.height || info.title != settled.title);
+                };
+                int waitMs = std::min(RemainingMs(settleDeadline), quietMs);
+                if (!co_await WaitForWindowAsync(m_launchExecutor, *m_windowIndex, changed, waitMs, token)) {
+                    // Quiet for the whole wait, unless the deadline cut it short
+                    stable = stable || waitMs == quietMs;
+                    break;
+                }
+                times.windowReady = LaunchTimes::Clock::now();
+                if (m_windowIndex->Lookup(window, settled) && predicate(settled)) continue;
+                // The window no longer passes the rule (or is gone); start over with one that does
+                window = co_await WaitForWindowAsync(m_launchExecutor, *m_windowIndex, predicate, RemainingMs(settleDeadline), token);
+                if (!window || !m_windowIndex->Lookup(window, settled)) break;
+                times.windowReady = LaunchTimes::Clock::now();
+            }
+        }
+        if (!stable || token.IsCancelled()) window = 0;
+        if (!window) times.windowMatched = times.windowReady = LaunchTimes::Clock::time_point();
+        if (!window && !token.IsCancelled()) times.windowTimedOut = LaunchTimes::Clock::now();
+    }
+
+    PostToUiThread([this, app, name, window, process, activate, times]() mutable {
+        GD_PROFILE_ZONE("Embed launched app");
+        // The app may have been deleted while it was launching
+        bool embedded = false;
+        if (m_apps.Contains(app)) {
+            m_apps.EndLaunch(app);
+            if (window) {
+                if (activate) SwitchToTab(app);
+                EmbedWindow(window, app, process);
+                embedded = true;
+            }
+        }
+        if (embedded) times.embedded = LaunchTimes::Clock::now();
+        // Only launches that started a process say anything about the app
+        if (process) {
+            m_launchLatency.Record(name, times);
+            SaveSettings();
+        }
+        OnLaunchFinished(app, embedded);
+    });
+}
+
+AppHandle GamingDashboard::AddCustomApp(const AppDesc& desc)
+{
+    AppHandle app = m_apps.Add(desc);
+    if (!desc.iconPath.empty()) {
+        DecodedImage image = DecodeImage(desc.iconPath);
+        m_apps.Icon(app) = m_iconAtlas.Add(ResampleToFit(image.View(), ICON_TARGET_SIZE, ResampleFilter::Lanczos3).View());
+    }
+    SaveSettings();
+    return app;
+}
+
+void GamingDashboard::RemoveCustomApp(AppHandle app)
+{
+    if (!m_apps.Contains(app) || !m_apps.Info(app).custom) return;
+
+    // A deleted app's window must not stay parented to the dashboard, hidden or throttled
+    UnthrottleTab(app);
+    WindowId window = m_apps.Window(app);
+    if (window) {
+        m_windowSystem->ReleaseWindow(window);
+        if (window == m_currentWindow) m_currentWindow = 0;
+        m_apps.SetWindow(app, 0);
+    }
+    if (app == m_currentApp) m_currentApp = AppHandle();
+
+    m_iconAtlas.Remove(m_apps.Icon(app));
+    m_telemetrySampler->Untrack(m_apps.TelemetryKey(app));
+    m_launchLatency.Remove(m_apps.Name(app));
+    // Also cancels a pending launch. The session tabs are taken from the registry, so the save below
+    // no longer lists the app.
+    m_apps.Remove(app);
+    SaveSettings();
+}
+
+void GamingDashboard::LaunchApp(AppHandle app, bool activate)
+{
+    LaunchApps({ app }, activate ? app : AppHandle());
+}
+
+void GamingDashboard::LaunchApps(const std::vector<AppHandle>& apps, AppHandle activate)
+{
+    std::vector<WindowId> windows;
+    FindRunningWindows(apps, {}, windows);
+    for (size_t i = 0; i < apps.size(); i++) {
+        LaunchResolved(apps[i], apps[i] == activate, windows[i]);
+    }
+}
+
+void GamingDashboard::FindRunningWindows(const std::vector<AppHandle>& apps, const std::vector<ProcessId>& pids,
+    std::vector<WindowId>& windows) const
+{
+    // One matcher entry per app that has no tab yet; its readiness rule keeps splash screens out
+    WindowMatcher matcher;
+    std::vector<int> entries(apps.size(), -1);
+    for (size_t i = 0; i < apps.size(); i++) {
+        if (!m_apps.Contains(apps[i]) || m_apps.Window(apps[i])) continue;
+        entries[i] = matcher.Add({ m_apps.WindowTitle(apps[i]), pids.empty() ? 0 : pids[i], m_apps.Info(apps[i]).readiness });
+    }
+    matcher.Build();
+    std::vector<WindowId> found;
+    m_windowIndex->Resolve(matcher, found);
+    windows.assign(apps.size(), 0);
+    for (size_t i = 0; i < apps.size(); i++) {
+        if (entries[i] >= 0) windows[i] = found[entries[i]];
+    }
+}
+
+void GamingDashboard::LaunchResolved(AppHandle app, bool activate, WindowId existingWindow)
+{
+    // Check if app is already embedded (exited apps are removed by OnTabProcessExited)
+    if (m_apps.Window(app)) {
+        if (activate) SwitchToTab(app);
+        OnLaunchFinished(app, true);
+        return;
+    }
+
+    // A launch already pending reports to OnLaunchFinished when it ends, and embeds the window it finds
+    // itself. Launching the app again while it is still queued (a click on its row) moves it to the
+    // front; an admitted launch stays as it is.
+    if (m_apps.IsLaunching(app)) {
+        if (activate) m_launchScheduler->Promote(m_apps.Name(app), ++m_launchClicks);
+        return;
+    }
+
+    // Check if app is running but not embedded. A profile member that finished earlier in the same
+    // batch may have taken the window since it was resolved.
+    WindowInfo existing;
+    if (existingWindow && m_windowSystem->QueryWindow(existingWindow, existing) && existing.parent == 0) {
+        if (activate) SwitchToTab(app);
+        EmbedWindow(existingWindow, app);
+        OnLaunchFinished(app, true);
+        return;
+    }
+
+    // Launch new app instance
+    uint64_t priority = activate ? ++m_launchClicks : 0;
+    CancellationToken token = m_apps.BeginLaunch(app);
+    const std::string& name = m_apps.Name(app);
+    const AppInfo& info = m_apps.Info(app);
+    Spawn(m_launchExecutor, LaunchPipeline(app, name, info.commandLine, m_apps.WindowTitle(app), info.readiness, m_launchLatency.Timeouts(name),
+        activate, priority, token));
+}
+
+int GamingDashboard::RestoreSession()
+{
+    std::vector<AppHandle> apps;
+    std::vector<ProcessId> pids;
+    for (const SessionTabSettings& tab : m_sessionTabs) {
+        AppHandle app = m_apps.Find(tab.name);
+        if (!app.IsValid()) continue;
+        apps.push_back(app);
+        pids.push_back(tab.pid);
+    }
+    std::vector<WindowId> windows;
+    FindRunningWindows(apps, pids, windows);
+
+    // The tabs were saved current first, so the first one found is the nearest to what was in front
+    int restored = 0;
+    for (size_t i = 0; i < apps.size(); i++) {
+        if (!windows[i] || m_apps.Window(apps[i])) continue;
+        if (restored == 0) SwitchToTab(apps[i]);
+        EmbedWindow(windows[i], apps[i]);
+        restored++;
+    }
+    return restored;
+}
+
+void GamingDashboard::ReleaseTabs()
+{
+    // Snapshot while the tabs are still embedded; the writer finishes it before the dashboard exits
+    SaveSettings();
+    for (size_t i = 0; i < m_apps.Count(); i++) {
+        AppHandle app = m_apps.At(i);
+        WindowId window = m_apps.Window(app);
+        if (!window) continue;
+        UnthrottleTab(app);
+        m_windowSystem->ReleaseWindow(window);
+    }
+}
+
+void GamingDashboard::AddLaunchProfile(LaunchProfileSettings profile)
+{
+    auto existing = std::find_if(m_launchProfiles.begin(), m_launchProfiles.end(),
+        [&profile](const LaunchProfileSettings& saved) { return saved.name == profile.name; });
+    if (existing != m_launchProfiles.end()) *existing = std::move(profile);
+    else m_launchProfiles.push_back(std::move(profile));
+    SaveSettings();
+}
+
+bool GamingDashboard::LaunchProfile(const std::string& name)
+{
+    auto profile = std::find_if(m_launchProfiles.begin(), m_launchProfiles.end(),
+        [&name](const LaunchProfileSettings& saved) { return saved.name == name; });
+    if (profile == m_launchProfiles.end()) return false;
+
+    // Members are matched to apps by name; a member whose app is gone fails, and so does whatever waits for it
+    auto launch = std::make_unique<ProfileLaunch>();
+    launch->name = name;
+    for (const LaunchProfileAppSettings& member : profile->apps) {
+        launch->plan.Add(m_apps.Find(member.name));
+    }
+    for (size_t i = 0; i < profile->apps.size(); i++) {
+        for (const std::string& dependency : profile->apps[i].after) {
+            auto dependsOn = std::find_if(profile->apps.begin(), profile->apps.end(),
+                [&dependency](const LaunchProfileAppSettings& member) { return member.name == dependency; });
+            if (dependsOn == profile->apps.end()) {
+                m_profileStatus = name + ": " + profile->apps[i].name + " starts after " + dependency + ", which is not in the profile";
+                return false;
+            }
+            launch->plan.AddDependency((int)i, (int)(dependsOn - profile->apps.begin()));
+        }
+    }
+    std::vector<int> cycle;
+    if (launch->plan.FindCycle(cycle)) {
+        m_profileStatus = name + ": circular dependency ";
+        for (int member : cycle) {
+            m_profileStatus += profile->apps[member].name + " -> ";
+        }
+        m_profileStatus += profile->apps[cycle[0]].name;
+        return false;
+    }
+
+    // Finished launches are dropped here; OnLaunchFinished may be iterating the list
+    m_profileLaunches.erase(std::remove_if(m_profileLaunches.begin(), m_profileLaunches.end(),
+        [](const std::unique_ptr<ProfileLaunch>& running) { return running->finished; }), m_profileLaunches.end());
+    launch->start = std::chrono::steady_clock::now();
+    m_profileStatus = "Starting " + name + "...";
+    m_profileLaunches.push_back(std::move(launch));
+    StartProfileMembers(*m_profileLaunches.back());
+    return true;
+}
+
+bool GamingDashboard::IsLaunchingProfile() const
+{
+    for (const auto& launch : m_profileLaunches) {
+        if (!launch->finished) return true;
+    }
+    return false;
+}
+
+void GamingDashboard::OnLaunchFinished(AppHandle app, bool ready)
+{
+    // By index: starting members can finish synchronously and land back here, but never add launches
+    for (size_t i = 0; i < m_profileLaunches.size(); i++) {
+        ProfileLaunch& launch = *m_profileLaunches[i];
+        bool finishedMember = false;
+        for (int member = 0; member < launch.plan.Count(); member++) {
+            if (launch.plan.App(member) == app && launch.plan.MemberState(member) == LaunchPlan::State::Starting) {
+                launch.plan.Finish(member, ready);
+                finishedMember = true;
+            }
+        }
+        if (finishedMember) StartProfileMembers(launch);
+    }
+}
+
+void GamingDashboard::StartProfileMembers(ProfileLaunch& launch)
+{
+    std::vector<int> startable;
+    launch.plan.TakeStartable(startable);
+    std::vector<AppHandle> apps;
+    AppHandle activate;
+    for (int member : startable) {
+        apps.push_back(launch.plan.App(member));
+        // The first app of the profile gets the tab; the others are embedded behind it
+        if (member == 0) activate = apps.back();
+    }
+    if (!apps.empty()) LaunchApps(apps, activate);
+
+    if (launch.finished || !launch.plan.Done()) return;
+    launch.finished = true;
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - launch.start).count();
+    char status[128];
+    if (launch.plan.FailedCount() == 0) {
+        snprintf(status, sizeof(status), ": %d apps ready in %.1f s", launch.plan.ReadyCount(), seconds);
+    }
+    else {
+        snprintf(status, sizeof(status), ": %d of %d apps ready in %.1f s, %d failed or skipped", launch.plan.ReadyCount(),
+            launch.plan.Count(), seconds, launch.plan.FailedCount());
+    }
+    m_profileStatus = launch.name + status;
+}
+
+void GamingDashboard::Render()
+{
+    ImGuiIO& io = ImGui::GetIO();
+
+    // Apply results from launch and watcher threads
+    {
+        GD_PROFILE_ZONE("Run UI commands");
+        RunUiCommands();
+    }
+    {
+        GD_PROFILE_ZONE("Apply layout");
+        ApplyPendingLayout();
+    }
+    m_iconAtlas.NewFrame();
+
+    // Latest telemetry; only atomics, no system calls
+    TelemetrySample sample;
+    while (m_telemetrySampler->TryPop(sample)) {
+        AppHandle app = m_apps.FromTelemetryKey(sample.key);
+        if (m_apps.Contains(app) && m_apps.Process(app)) m_apps.Telemetry(app) = sample;
+    }
+
+    // Keep the "(Loading...)" buttons ticking while launches are pending. Telemetry needs no timer: the
+    // sampler wakes the loop when it publishes a sample.
+    if (m_apps.AnyLaunching() && m_frameScheduler.load()) {
+        m_frameScheduler.load()->RequestFrameAfter(LOADING_REFRESH_MS);
+    }
+
+    // Set up docking
+    ImGuiID dockspace_id = ImGui::GetID("MyDockSpace");
+    ImGui::DockSpaceOverViewport(dockspace_id, ImGui::GetMainViewport(), ImGuiDockNodeFlags_PassthruCentralNode);
+
+    // Sidebar
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(SIDEBAR_WIDTH, io.DisplaySize.y));
+    ImGui::Begin("##Sidebar", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse);
+
+    ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.18f, 0.18f, 0.19f, 1.0f));
+    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.25f, 0.25f, 0.25f, 1.0f));
+
+    // Title with controller icon
+    if (m_controllerIcon.IsValid()) {
+        SidebarIcon(m_controllerIcon, 20);
+        ImGui::SameLine();
+    }
+    ImGui::Text("GAMING DASHBOARD");
+    ImGui::Separator();
+    ImGui::Spacing();
+
+    // App list: a scrolling child with fixed-height rows, so only the visible rows are submitted
+    const ImGuiStyle& style = ImGui::GetStyle();
+    // Everything below the list: spacing, separator, spacing, three footer buttons, plus the child's own item spacing
+    float footerHeight = 6 * style.ItemSpacing.y + 1.0f + 3 * SIDEBAR_FOOTER_BUTTON_HEIGHT;
+    ImGui::PushStyleColor(ImGuiCol_ChildBg, ImVec4(0.0f, 0.0f, 0.0f, 0.0f));
+    ImGui::BeginChild("##AppList", ImVec2(0, -footerHeight));
+    ImGuiListClipper clipper;
+    clipper.Begin(SidebarRowCount(), SIDEBAR_ROW_HEIGHT + style.ItemSpacing.y);
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+            ImGui::PushID(row);
+            RenderSidebarRow(row);
+            ImGui::PopID();
+        }
+    }
+    FlushSidebarIcons();
+    ImGui::EndChild();
+    ImGui::PopStyleColor();
+
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Spacing();
+
+    // Add App button
+    if (ImGui::Button("+ Add App", ImVec2(-1, SIDEBAR_FOOTER_BUTTON_HEIGHT))) {
+        m_showAddApp = true;
+    }
+
+    if (ImGui::Button("Launch Profiles", ImVec2(-1, SIDEBAR_FOOTER_BUTTON_HEIGHT))) {
+        m_showProfiles = !m_showProfiles;
+    }
+
+    // Settings button with icon
+    if (m_settingsIcon.IsValid()) {
+        SidebarIcon(m_settingsIcon, 20);
+        ImGui::SameLine();
+        ImGui::SetCursorPosY(ImGui::GetCursorPosY() - 2);
+    }
+    if (ImGui::Button("Settings", ImVec2(-1, SIDEBAR_FOOTER_BUTTON_HEIGHT))) {
+        m_showSettings = !m_showSettings;
+    }
+
+    ImGui::PopStyleColor(2);
+    FlushSidebarIcons();
+    ImGui::End();
+    // The tooltip shows exact figures, so it gets every sample; the sidebar only changes in whole units
+    m_telemetrySampler->SetChangesOnly(!m_telemetryTooltipOpen);
+    m_telemetryTooltipOpen = false;
+
+    // Add App Window
+    if (m_showAddApp) {
+        ImGui::SetNextWindowPos(ImVec2(220, 50));
+        ImGui::SetNextWindowSize(ImVec2(600, 500));
+        ImGui::Begin("Add Custom App", &m_showAddApp);
+
+        ImGui::Text("App Name:");
+        ImGui::InputText("##appname", m_newAppName, sizeof(m_newAppName));
+
+        ImGui::Text("Executable Path:");
+        ImGui::InputText("##apppath", m_newAppPath, sizeof(m_newAppPath));
+        ImGui::SameLine();
+        if (ImGui::Button("Browse##exe")) {
+            // Simple file dialog would go here - for now user types path
+        }
+
+        ImGui::Text("Icon Path (PNG file):");
+        ImGui::InputText("##appiconpath", m_newAppIcon, sizeof(m_newAppIcon));
+        ImGui::SameLine();
+        if (ImGui::Button("Browse##icon")) {
+            // Simple file dialog would go here - for now user types path
+        }
+
+        ImGui::Text("Window Title (part of title to find window):");
+        ImGui::InputText("##appwindowtitle", m_newAppWindowTitle, sizeof(m_newAppWindowTitle));
+
+        ImGui::TextWrapped("The app is embedded once its window stops resizing and retitling. How long to wait for it is learned from its earlier launches; see Launch Stats in Settings.");
+
+        // Only needed for apps that show a splash screen or updater window before the real one
+        if (ImGui::CollapsingHeader("Window readiness")) {
+            ImGui::InputInt("Min width", &m_newAppRule.minWidth);
+            ImGui::InputInt("Min height", &m_newAppRule.minHeight);
+            ImGui::InputText("Window class", m_newAppRuleClass, sizeof(m_newAppRuleClass));
+            ImGui::InputText("Title pattern (* and ?)", m_newAppRuleTitle, sizeof(m_newAppRuleTitle));
+            bool caption = (m_newAppRule.requiredStyle & WindowStyle::CAPTION) != 0;
+            if (ImGui::Checkbox("Has a title bar", &caption)) {
+                m_newAppRule.requiredStyle = caption ? WindowStyle::CAPTION : 0;
+            }
+            bool popup = (m_newAppRule.excludedStyle & WindowStyle::POPUP) != 0;
+            if (ImGui::Checkbox("Not a popup", &popup)) {
+                m_newAppRule.excludedStyle = popup ? WindowStyle::POPUP : 0;
+            }
+            ImGui::InputInt("Stable for (ms)", &m_newAppRule.stableMs, 100);
+        }
+        // Turn off for launchers: games they start would be slowed down along with them
+        ImGui::Checkbox("Throttle while in a hidden tab", &m_newAppThrottle);
+
+        ImGui::Spacing();
+        if (ImGui::Button("Add App")) {
+            if (strlen(m_newAppName) > 0 && strlen(m_newAppPath) > 0 && strlen(m_newAppWindowTitle) > 0) {
+                m_newAppRule.className = m_newAppRuleClass;
+                m_newAppRule.titlePattern = m_newAppRuleTitle;
+                AddCustomApp({ m_newAppName, m_newAppPath, m_newAppIcon, m_newAppWindowTitle, true, m_newAppRule, m_newAppThrottle });
+
+                // Clear form
+                memset(m_newAppName, 0, sizeof(m_newAppName));
+                memset(m_newAppPath, 0, sizeof(m_newAppPath));
+                memset(m_newAppIcon, 0, sizeof(m_newAppIcon));
+                memset(m_newAppWindowTitle, 0, sizeof(m_newAppWindowTitle));
+                memset(m_newAppRuleClass, 0, sizeof(m_newAppRuleClass));
+                memset(m_newAppRuleTitle, 0, sizeof(m_newAppRuleTitle));
+                m_newAppRule = ReadinessRule();
+                m_newAppThrottle = true;
+
+                m_showAddApp = false;
+            }
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Cancel")) {
+            m_showAddApp = false;
+        }
+
+        // Show existing custom apps with delete option
+        if (HasCustomApps()) {
+            ImGui::Separator();
+            ImGui::Text("Existing Custom Apps:");
+            for (size_t i = 0; i < m_apps.Count(); i++) {
+                AppHandle app = m_apps.At(i);
+                if (!m_apps.Info(app).custom) continue;
+                ImGui::Text("%s", m_apps.Name(app).c_str());
+                ImGui::SameLine();
+                ImGui::PushID((int)app.index);
+                if (ImGui::Button("Delete")) {
+                    RemoveCustomApp(app);
+                    i--; // Adjust index after deletion
+                }
+                ImGui::PopID();
+            }
+        }
+
+        ImGui::End();
+    }
+
+    // Settings Window
+    if (m_showSettings) {
+        ImGui::SetNextWindowPos(ImVec2(220, 50));
+        ImGui::SetNextWindowSize(ImVec2(600, 400));
+        ImGui::Begin("Settings", &m_showSettings);
+
+        if (m_settingsReadOnly) {
+            ImGui::TextWrapped("The settings file could not be read (it may be from a newer version). It is left as it is, and changes are not saved this session.");
+            ImGui::Spacing();
+        }
+        ImGui::Text("Application Paths");
+        ImGui::Separator();
+        ImGui::Spacing();
+
+        ImGui::Text("Chrome Path:");
+        ImGui::InputText("##chrome", m_chromePathBuffer, sizeof(m_chromePathBuffer));
+
+        ImGui::Text("Steam Path:");
+        ImGui::InputText("##steam", m_steamPathBuffer, sizeof(m_steamPathBuffer));
+
+        ImGui::Text("Discord Path (with args):");
+        ImGui::InputText("##discord", m_discordPathBuffer, sizeof(m_discordPathBuffer));
+
+        ImGui::Spacing();
+        ImGui::Checkbox("Show launch stats", &m_showLaunchStats);
+        if (ProfilingEnabled()) {
+            ImGui::Checkbox("Show frame profiler", &m_showProfiler);
+        }
+
+        ImGui::Spacing();
+        if (ImGui::Button("Save Settings")) {
+            m_apps.Info(m_chromeApp).commandLine = m_chromePathBuffer;
+            m_apps.Info(m_steamApp).commandLine = m_steamPathBuffer;
+            m_apps.Info(m_discordApp).commandLine = m_discordPathBuffer;
+            SaveSettings();
+            m_showSettings = false;
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Cancel")) {
+            CopyToBuffer(m_chromePathBuffer, m_apps.Info(m_chromeApp).commandLine);
+            CopyToBuffer(m_steamPathBuffer, m_apps.Info(m_steamApp).commandLine);
+            CopyToBuffer(m_discordPathBuffer, m_apps.Info(m_discordApp).commandLine);
+            m_showSettings = false;
+        }
+
+        ImGui::End();
+    }
+
+    if (m_showProfiles) {
+        RenderProfilesWindow();
+    }
+
+    if (m_showProfiler) {
+        RenderProfilerWindow();
+    }
+
+    if (m_showLaunchStats) {
+        RenderLaunchStatsWindow();
+    }
+
+    // Main content area
+    ImGui::SetNextWindowPos(ImVec2(SIDEBAR_WIDTH, 0));
+    ImGui::SetNextWindowSize(ImVec2(io.DisplaySize.x - SIDEBAR_WIDTH, io.DisplaySize.y));
+    ImGui::Begin("##MainContent", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse);
+
+    if (!m_apps.Contains(m_currentApp)) {
+        ImGui::SetCursorPos(ImVec2(ImGui::GetWindowSize().x * 0.5f - 100, ImGui::GetWindowSize().y * 0.5f));
+        ImGui::Text("Select an app to get started");
+    }
+
+    if (m_allocationMeter && AllocationCountingEnabled()) {
+        const AllocationStats& frame = m_allocationMeter->LastFrame();
+        ImGui::SetCursorPos(ImVec2(10, ImGui::GetWindowSize().y - ImGui::GetTextLineHeightWithSpacing() - 10));
+        ImGui::Text("Last frame: %llu allocations, %llu bytes (%llu clean frames)",
+            (unsigned long long)frame.count, (unsigned long long)frame.bytes, (unsigned long long)m_allocationMeter->CleanFrames());
+    }
+
+    ImGui::End();
+}
+
+void GamingDashboard::RenderProfilesWindow()
+{
+    ImGui::SetNextWindowPos(ImVec2(220, 50));
+    ImGui::SetNextWindowSize(ImVec2(600, 500));
+    ImGui::Begin("Launch Profiles", &m_showProfiles);
+
+    ImGui::TextWrapped("A profile starts all of its apps at once. An app set to start after another one waits until that app's window is up.");
+    if (!m_profileStatus.empty()) {
+        ImGui::Spacing();
+        ImGui::Text("%s", m_profileStatus.c_str());
+    }
+
+    for (size_t i = 0; i < m_launchProfiles.size(); i++) {
+        const LaunchProfileSettings& profile = m_launchProfiles[i];
+        ImGui::Separator();
+        ImGui::PushID((int)i);
+        ImGui::Text("%s", profile.name.c_str());
+        ImGui::SameLine();
+        bool launch = ImGui::Button("Launch");
+        ImGui::SameLine();
+        bool remove = ImGui::Button("Delete");
+        for (const LaunchProfileAppSettings& member : profile.apps) {
+            // Built in a stack buffer, so an open window does not allocate every frame
+            char line[256];
+            size_t length = 0;
+            auto append = [&](const char* text) {
+                if (length < sizeof(line)) length += snprintf(line + length, sizeof(line) - length, "%s", text);
+            };
+            append(member.name.c_str());
+            for (size_t j = 0; j < member.after.size(); j++) {
+                append(j == 0 ? " (after " : ", ");
+                append(member.after[j].c_str());
+            }
+            if (!member.after.empty()) append(")");
+            if (!m_apps.Find(member.name).IsValid()) append(" - missing");
+            ImGui::BulletText("%s", line);
+        }
+        ImGui::PopID();
+
+        if (launch) {
+            LaunchProfile(profile.name);
+        }
+        else if (remove) {
+            m_launchProfiles.erase(m_launchProfiles.begin() + i);
+            SaveSettings();
+            i--; // Adjust index after deletion
+        }
+    }
+
+    // New profile: tick the apps, optionally pick one each waits for
+    ImGui::Separator();
+    ImGui::Text("New Profile:");
+    ImGui::InputText("##profilename", m_newProfileName, sizeof(m_newProfileName));
+    m_newProfileMembers.resize(m_apps.Count(), 0);
+    m_newProfileAfter.resize(m_apps.Count(), -1);
+    for (int& after : m_newProfileAfter) {
+        if (after >= (int)m_apps.Count()) after = -1;
+    }
+    for (size_t i = 0; i < m_apps.Count(); i++) {
+        ImGui::PushID((int)i);
+        bool included = m_newProfileMembers[i] != 0;
+        if (ImGui::Checkbox(m_apps.Name(m_apps.At(i)).c_str(), &included)) m_newProfileMembers[i] = included;
+        if (included) {
+            int after = m_newProfileAfter[i];
+            char label[256];
+            snprintf(label, sizeof(label), "after %s", after >= 0 ? m_apps.Name(m_apps.At(after)).c_str() : "");
+            ImGui::SameLine(250);
+            ImGui::SetNextItemWidth(200);
+            if (ImGui::BeginCombo("##after", after >= 0 ? label : "right away")) {
+                if (ImGui::Selectable("right away", after < 0)) m_newProfileAfter[i] = -1;
+                for (size_t j = 0; j < m_apps.Count(); j++) {
+                    if (j == i || !m_newProfileMembers[j]) continue;
+                    snprintf(label, sizeof(label), "after %s", m_apps.Name(m_apps.At(j)).c_str());
+                    if (ImGui::Selectable(label, after == (int)j)) m_newProfileAfter[i] = (int)j;
+                }
+                ImGui::EndCombo();
+            }
+        }
+        ImGui::PopID();
+    }
+
+    if (ImGui::Button("Create Profile")) {
+        LaunchProfileSettings profile;
+        profile.name = m_newProfileName;
+        for (size_t i = 0; i < m_apps.Count(); i++) {
+            if (!m_newProfileMembers[i]) continue;
+            LaunchProfileAppSettings member;
+            member.name = m_apps.Name(m_apps.At(i));
+            int after = m_newProfileAfter[i];
+            if (after >= 0 && m_newProfileMembers[after]) member.after.push_back(m_apps.Name(m_apps.At(after)));
+            profile.apps.push_back(std::move(member));
+        }
+        if (!profile.name.empty() && !profile.apps.empty()) {
+            AddLaunchProfile(std::move(profile));
+
+            // Clear form
+            memset(m_newProfileName, 0, sizeof(m_newProfileName));
+            m_newProfileMembers.assign(m_apps.Count(), 0);
+            m_newProfileAfter.assign(m_apps.Count(), -1);
+        }
+    }
+
+    ImGui::End();
+}
+
+void GamingDashboard::RenderProfilerWindow()
+{
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    ImGui::SetNextWindowPos(ImVec2(240, 80), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(760, 480), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Frame Profiler", &m_showProfiler)) {
+        ImGui::End();
+        return;
+    }
+
+    const ProfileFrame& last = profiler.LastFrame();
+    ImGui::Text("Last frame: %.2f ms", profiler.TicksToMs(last.end - last.start));
+    ImGui::SameLine();
+    float budget = profiler.BudgetMs();
+    ImGui::SetNextItemWidth(200);
+    if (ImGui::SliderFloat("Budget", &budget, 5.0f, 100.0f, "%.1f ms")) {
+        profiler.SetBudgetMs(budget);
+    }
+    ImGui::PlotLines("##FrameHistory", profiler.History(), FrameProfiler::HISTORY_FRAMES, profiler.HistoryOffset(),
+        nullptr, 0.0f, budget * 2.0f, ImVec2(-1, 60));
+
+    // Frames kept for the timeline; labels go through a stack buffer so the panel does not allocate
+    if (m_profilerCapture >= profiler.CaptureCount()) m_profilerCapture = -1;
+    if (ImGui::RadioButton("Last frame", m_profilerCapture < 0)) m_profilerCapture = -1;
+    char label[64];
+    for (int i = 0; i < profiler.CaptureCount(); i++) {
+        const ProfileFrame& capture = profiler.Capture(i);
+        snprintf(label, sizeof(label), "#%llu: %.1f ms", (unsigned long long)capture.index, profiler.TicksToMs(capture.end - capture.start));
+        ImGui::SameLine();
+        if (ImGui::RadioButton(label, m_profilerCapture == i)) m_profilerCapture = i;
+    }
+
+    if (ImGui::Button("Export Chrome trace")) {
+        std::string path = DefaultSettingsPath();
+        size_t slash = path.find_last_of("\\/");
+        path = (slash == std::string::npos ? std::string() : path.substr(0, slash + 1)) + "trace.json";
+        m_profilerStatus = profiler.ExportChromeTrace(path) ? "Wrote " + path : "Could not write " + path;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Clear captures")) {
+        profiler.ClearCaptures();
+        m_profilerCapture = -1;
+    }
+    if (!m_profilerStatus.empty()) {
+        ImGui::SameLine();
+        ImGui::TextUnformatted(m_profilerStatus.c_str());
+    }
+
+    const ProfileFrame& frame = m_profilerCapture < 0 ? last : profiler.Capture(m_profilerCapture);
+    if (frame.droppedZones > 0) {
+        ImGui::Text("%llu zones dropped", (unsigned long long)frame.droppedZones);
+    }
+    ImGui::BeginChild("##Timeline", ImVec2(0, 0), ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar);
+    DrawProfileTimeline(frame);
+    ImGui::EndChild();
+
+    ImGui::End();
+}
+
+// "850 ms" below a second, "12.4 s" above
+static void FormatLatency(char (&buffer)[32], uint32_t ms)
+{
+    if (ms < 1000) snprintf(buffer, sizeof(buffer), "%u ms", ms);
+    else snprintf(buffer, sizeof(buffer), "%.1f s", ms / 1000.0);
+}
+
+void GamingDashboard::RenderLaunchStatsWindow()
+{
+    ImGui::SetNextWindowPos(ImVec2(240, 80), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(900, 360), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Launch Stats", &m_showLaunchStats)) {
+        ImGui::End();
+        return;
+    }
+
+    const std::map<std::string, LaunchLatency::AppHistograms>& apps = m_launchLatency.Apps();
+    if (apps.empty()) {
+        ImGui::TextWrapped("No launches recorded yet. Every launch records when its process started, when its first window showed, when the window was ready and when it was embedded.");
+        ImGui::End();
+        return;
+    }
+    ImGui::TextWrapped("Time from the click to each milestone, as p50 / p95 / p99. Settle is how long the window kept changing after it matched. "
+        "After %u launches an app waits for its window for twice its p99 ready time, and settles for twice its p99 settle time.",
+        LaunchLatency::MIN_SAMPLES);
+
+    const int phaseCount = (int)LaunchPhase::Count;
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingFixedFit;
+    if (ImGui::BeginTable("##LaunchStats", phaseCount + 4, flags)) {
+        ImGui::TableSetupScrollFreeze(1, 1);
+        ImGui::TableSetupColumn("App");
+        ImGui::TableSetupColumn("Launches");
+        for (int phase = 0; phase < phaseCount; phase++) {
+            ImGui::TableSetupColumn(LaunchPhaseName((LaunchPhase)phase));
+        }
+        ImGui::TableSetupColumn("Timeout");
+        ImGui::TableSetupColumn("Settle limit");
+        ImGui::TableHeadersRow();
+
+        // Stack buffers, so the panel does not allocate per frame
+        char p50[32];
+        char p95[32];
+        char p99[32];
+        for (const auto& entry : apps) {
+            const LaunchLatency::AppHistograms& histograms = entry.second;
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(entry.first.c_str());
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", histograms[(size_t)LaunchPhase::ProcessStart].Count());
+            for (const LatencyHistogram& histogram : histograms) {
+                ImGui::TableNextColumn();
+                if (histogram.Count() == 0) {
+                    ImGui::TextDisabled("-");
+                    continue;
+                }
+                FormatLatency(p50, histogram.Percentile(0.50));
+                FormatLatency(p95, histogram.Percentile(0.95));
+                FormatLatency(p99, histogram.Percentile(0.99));
+                ImGui::Text("%s / %s / %s", p50, p95, p99);
+            }
+            LaunchTimeouts timeouts = m_launchLatency.Timeouts(entry.first);
+            ImGui::TableNextColumn();
+            FormatLatency(p50, (uint32_t)timeouts.windowMs);
+            ImGui::TextUnformatted(p50);
+            ImGui::TableNextColumn();
+            if (timeouts.settleMs == 0) {
+                ImGui::TextUnformatted("none");
+            }
+            else {
+                FormatLatency(p50, (uint32_t)timeouts.settleMs);
+                ImGui::TextUnformatted(p50);
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+void GamingDashboard::DrawProfileTimeline(const ProfileFrame& frame)
+{
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    if (frame.end <= frame.start) return;
+
+    const float labelWidth = 110.0f;
+    const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    float barWidth = ImGui::GetContentRegionAvail().x - labelWidth;
+    if (barWidth < 100.0f) barWidth = 100.0f;
+    double frameTicks = (double)(frame.end - frame.start);
+    ImU32 textColor = ImGui::GetColorU32(ImGuiCol_Text);
+
+    float y = origin.y;
+    char threadLabel[32];
+    for (int thread = 0; thread < profiler.ThreadCount(); thread++) {
+        int maxDepth = -1;
+        for (const ProfileZone& zone : frame.zones) {
+            if (zone.thread == thread && zone.depth > maxDepth) maxDepth = zone.depth;
+        }
+        if (maxDepth < 0) continue;
+
+        const char* name = profiler.ThreadName(thread);
+        if (!name) {
+            snprintf(threadLabel, sizeof(threadLabel), "Thread %d", thread);
+            name = threadLabel;
+        }
+        drawList->AddText(ImVec2(origin.x, y + 2.0f), textColor, name);
+
+        for (const ProfileZone& zone : frame.zones) {
+            if (zone.thread != thread || zone.end < frame.start || zone.start > frame.end) continue;
+            uint64_t start = zone.start > frame.start ? zone.start : frame.start;
+            uint64_t end = zone.end < frame.end ? zone.end : frame.end;
+            float x0 = origin.x + labelWidth + (float)((start - frame.start) / frameTicks * barWidth);
+            float x1 = origin.x + labelWidth + (float)((end - frame.start) / frameTicks * barWidth);
+            if (x1 < x0 + 1.0f) x1 = x0 + 1.0f;
+            ImVec2 min(x0, y + zone.depth * rowHeight);
+            ImVec2 max(x1, min.y + rowHeight - 1.0f);
+            drawList->AddRectFilled(min, max, (ImU32)ImColor::HSV(0.55f + zone.depth * 0.12f, 0.45f, 0.65f));
+            ImVec4 clip(min.x, min.y, max.x, max.y);
+            drawList->AddText(ImGui::GetFont(), ImGui::GetFontSize(), ImVec2(min.x + 2.0f, min.y + 2.0f), textColor, zone.name, nullptr, 0.0f, &clip);
+            if (ImGui::IsWindowHovered() && ImGui::IsMouseHoveringRect(min, max)) {
+                ImGui::SetTooltip("%s\n%.3f ms", zone.name, profiler.TicksToMs(zone.end - zone.start));
+            }
+        }
+        y += (maxDepth + 1) * rowHeight + 6.0f;
+    }
+    ImGui::Dummy(ImVec2(labelWidth + barWidth, y - origin.y));
+}
+
+void GamingDashboard::SidebarIcon(IconTexture& icon, float size)
+{
+    m_iconAtlas.Resolve(icon);
+    ImGui::Dummy(ImVec2(size, size));
+    m_sidebarIcons.push_back({ ImGui::GetWindowDrawList(), ImGui::GetItemRectMin(), ImGui::GetItemRectMax(), icon.uv0, icon.uv1 });
+}
+
+void GamingDashboard::FlushSidebarIcons()
+{
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    size_t kept = 0;
+    for (const PendingIcon& icon : m_sidebarIcons) {
+        if (icon.drawList == drawList) drawList->AddImage(m_iconAtlas.TexRef(), icon.min, icon.max, icon.uv0, icon.uv1);
+        else m_sidebarIcons[kept++] = icon;
+    }
+    m_sidebarIcons.resize(kept);
+}
+
+bool GamingDashboard::HasCustomApps() const
+{
+    for (size_t i = 0; i < m_apps.Count(); i++) {
+        if (m_apps.Info(m_apps.At(i)).custom) return true;
+    }
+    return false;
+}
+
+int GamingDashboard::SidebarRowCount() const
+{
+    return (int)m_apps.Count();
+}
+
+void GamingDashboard::RenderSidebarRow(int row)
+{
+    AppHandle app = m_apps.At(row);
+    if (SidebarAppButton(app)) LaunchApp(app);
+}
+
+bool GamingDashboard::SidebarAppButton(AppHandle app)
+{
+    IconTexture& icon = m_apps.Icon(app);
+    const std::string& name = m_apps.Name(app);
+    float rowTop = ImGui::GetCursorPosY();
+    if (icon.IsValid()) {
+        ImGui::SetCursorPosY(rowTop + (SIDEBAR_ROW_HEIGHT - SIDEBAR_ICON_SIZE) * 0.5f);
+        SidebarIcon(icon, SIDEBAR_ICON_SIZE);
+        ImGui::SameLine();
+        ImGui::SetCursorPosY(rowTop);
+    }
+    if (m_apps.IsLaunching(app)) {
+        // Clicking the label of a launch still waiting for its turn moves it to the front; the button
+        // next to it cancels the launch
+        bool clicked = ImGui::Button(m_apps.LoadingLabel(app).c_str(), ImVec2(-(SIDEBAR_ICON_SIZE + ImGui::GetStyle().ItemSpacing.x), SIDEBAR_ROW_HEIGHT));
+        ImGui::SameLine();
+        if (ImGui::Button("X###cancel", ImVec2(SIDEBAR_ICON_SIZE, SIDEBAR_ROW_HEIGHT))) {
+            m_apps.CancelLaunch(app);
+            clicked = false;
+        }
+        ImGui::SetItemTooltip("Cancel launch");
+        return clicked;
+    }
+
+    // Formatted on the stack so the frame stays allocation-free; the "###" ID keeps the button
+    // the same widget while its text changes
+    char label[256];
+    const TelemetrySample& telemetry = m_apps.Telemetry(app);
+    if (telemetry.processCount > 0) {
+        snprintf(label, sizeof(label), "%s\n%.0f%% CPU  %.0f MB###app", name.c_str(), telemetry.cpuPercent, telemetry.privateBytes / (1024.0 * 1024.0));
+    }
+    else {
+        snprintf(label, sizeof(label), "%s###app", name.c_str());
+    }
+    bool clicked = ImGui::Button(label, ImVec2(-1, SIDEBAR_ROW_HEIGHT));
+    if (telemetry.processCount > 0 && ImGui::BeginItemTooltip()) {
+        ImGui::Text("CPU: %.1f%%\nPrivate memory: %.1f MB\nI/O: %.1f KB/s\nThreads: %u in %u processes",
+            telemetry.cpuPercent, telemetry.privateBytes / (1024.0 * 1024.0), telemetry.ioBytesPerSecond / 1024.0f,
+            telemetry.threadCount, telemetry.processCount);
+        ImGui::EndTooltip();
+        m_telemetryTooltipOpen = true;
+    }
+    return clicked;
+}
@@ -0,0 +1,335 @@
+#pragma once
+
+#include "AllocationCounter.h"
+#include "AppRegistry.h"
+#include "CommandQueue.h"
+#include "Executor.h"
+#include "FrameProfiler.h"
+#include "FrameScheduler.h"
+#include "IconAtlas.h"
+#include "IconCache.h"
+#include "LaunchLatency.h"
+#include "LaunchPlan.h"
+#include "LaunchScheduler.h"
+#include "ProcessLauncher.h"
+#include "ProcessTelemetry.h"
+#include "ResourceGovernor.h"
+#include "SettingsStore.h"
+#include "WindowIndex.h"
+#include "WindowSystem.h"
+#include "imgui.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Platform services behind the dashboard. CreatePlatformBackends() gives the real ones; headless runs
+// pass the Fake* backends and a MemorySettingsStore instead.
+struct DashboardBackends {
+    std::unique_ptr<WindowSystem> windowSystem;
+    std::unique_ptr<ProcessLauncher> processLauncher;
+    std::unique_ptr<ResourceGovernor> resourceGovernor;
+    std::unique_ptr<TelemetryProvider> telemetryProvider;
+    // Disk read counter for launch scheduling; may be null, which leaves only the per-app costs to go by
+    std::unique_ptr<DiskMonitor> diskMonitor;
+    std::unique_ptr<SettingsStore> settingsStore;
+    // Settings of older versions, imported when settingsStore has none yet; may be null
+    std::unique_ptr<SettingsStore> legacySettingsStore;
+    std::string iconCachePath = "icon_cache.bin";
+};
+
+DashboardBackends CreatePlatformBackends();
+
+// Dark theme with the dashboard's accent colours, applied to the current ImGui context
+void ApplyDashboardStyle();
+
+// The dashboard UI and its app model. Knows nothing about Win32 or D3D11: windows and processes go
+// through the backends, and Render() only builds ImGui draw data for whatever renderer the caller uses.
+class GamingDashboard {
+private:
+    WindowId m_currentWindow = 0;
+    AppHandle m_currentApp;
+    // The dashboard's own window, parent of the embedded ones
+    WindowId m_dashboardWindow = 0;
+    // Read from launch threads to wake the idle UI loop
+    std::atomic<FrameScheduler*> m_frameScheduler{ nullptr };
+    // Per-frame allocation counts, shown when built with GD_COUNT_ALLOCATIONS
+    const FrameAllocationMeter* m_allocationMeter = nullptr;
+
+    // Work posted by launch/watcher threads, run on the UI thread at the start of Render()
+    CommandQueue<std::function<void()>, 256> m_uiCommands;
+    // The thread that built the dashboard, renders it and destroys it
+    std::thread::id m_uiThread = std::this_thread::get_id();
+    // Set once the destructor starts; the UI thread no longer drains m_uiCommands then
+    std::atomic<bool> m_shuttingDown{ false };
+
+    // Window lifecycle events used to wait for launched apps, and batched positioning of embedded windows
+    std::unique_ptr<WindowSystem> m_windowSystem;
+    std::vector<WindowPlacement> m_placements;
+    bool m_layoutPending = false;
+    // Cached top-level windows, updated from m_windowSystem events
+    std::unique_ptr<WindowIndex> m_windowIndex;
+
+    // Process trees behind each tab are kept in m_apps
+    std::unique_ptr<ProcessLauncher> m_processLauncher;
+    // Throttles the process trees of hidden tabs
+    std::unique_ptr<ResourceGovernor> m_resourceGovernor;
+    ThrottlePolicy m_throttlePolicy = DefaultThrottlePolicy();
+    // Scratch for ThrottleTab: processes with a visible top-level window, which are never throttled
+    std::vector<ProcessId> m_visibleOwners;
+
+    // Built-in and custom apps with their tab and launch state
+    AppRegistry m_apps;
+    AppHandle m_chromeApp;
+    AppHandle m_steamApp;
+    AppHandle m_discordApp;
+    // Samples CPU, memory, I/O and threads of each tab's process tree off the UI thread
+    std::unique_ptr<TelemetrySampler> m_telemetrySampler;
+    // A sidebar row's telemetry tooltip was shown this frame
+    bool m_telemetryTooltipOpen = false;
+
+    // Launch coroutines share these few threads; each pending launch is a suspended frame, not a parked thread
+    Executor m_launchExecutor{ 2 };
+    // Admits cold starts one or a few at a time, by disk load and by priority
+    std::unique_ptr<LaunchScheduler> m_launchScheduler;
+    // Priority of the latest click; a later click outranks every earlier launch
+    uint64_t m_launchClicks = 0;
+    // How long each app took to start, embed and settle; drives the launch timeouts
+    LaunchLatency m_launchLatency;
+
+    // Tabs that were embedded when the dashboard last closed, for RestoreSession()
+    std::vector<SessionTabSettings> m_sessionTabs;
+
+    // Launch profiles from the settings, and the profiles currently starting
+    std::vector<LaunchProfileSettings> m_launchProfiles;
+    struct ProfileLaunch {
+        std::string name;
+        LaunchPlan plan;
+        std::chrono::steady_clock::time_point start;
+        bool finished = false;
+    };
+    // Pointers, so a launch stays put while the list grows
+    std::vector<std::unique_ptr<ProfileLaunch>> m_profileLaunches;
+    std::string m_profileStatus;
+
+    // Decoded icons from the last run; the atlas may point into its mapping, so it is declared first
+    std::string m_iconCachePath;
+    std::unique_ptr<IconCache> m_iconCache;
+    // Every icon lives in one atlas texture
+    IconAtlas m_iconAtlas;
+    struct PendingIcon {
+        ImDrawList* drawList;
+        ImVec2 min;
+        ImVec2 max;
+        ImVec2 uv0;
+        ImVec2 uv1;
+    };
+    // Sidebar icons laid out this frame, drawn together by FlushSidebarIcons()
+    std::vector<PendingIcon> m_sidebarIcons;
+
+    // Icon textures not tied to an app
+    IconTexture m_controllerIcon;
+    IconTexture m_settingsIcon;
+
+    // Settings file and the thread that writes it
+    std::unique_ptr<SettingsStore> m_settingsStore;
+    SettingsWriter m_settingsWriter;
+    // Older settings imported on the first run; may be null
+    std::unique_ptr<SettingsStore> m_legacySettingsStore;
+    // The settings file is there but could not be loaded (a newer build's, or damaged). Saving would
+    // replace it with the defaults, so nothing is saved this session.
+    bool m_settingsReadOnly = false;
+
+    // Settings
+    bool m_showSettings = false;
+    char m_chromePathBuffer[512];
+    char m_steamPathBuffer[512];
+    char m_discordPathBuffer[512];
+
+    // Frame profiler panel, only offered when built with GD_PROFILE
+    bool m_showProfiler = false;
+    int m_profilerCapture = -1;     // captured slow frame shown in the timeline, -1 for the last frame
+    std::string m_profilerStatus;
+
+    bool m_showLaunchStats = false;
+
+    // Launch Profiles window and its new-profile form
+    bool m_showProfiles = false;
+    char m_newProfileName[256] = "";
+    // By sidebar position: whether the app is in the new profile, and the position it starts after (-1 for none)
+    std::vector<unsigned char> m_newProfileMembers;
+    std::vector<int> m_newProfileAfter;
+
+    // Add App form
+    bool m_showAddApp = false;
+    char m_newAppName[256] = "";
+    char m_newAppPath[512] = "";
+    char m_newAppIcon[512] = "";
+    char m_newAppWindowTitle[256] = "";
+    // Readiness rule of the new app; its strings live in the buffers while the form is open
+    ReadinessRule m_newAppRule;
+    char m_newAppRuleClass[256] = "";
+    char m_newAppRuleTitle[256] = "";
+    bool m_newAppThrottle = true;
+
+    // Sidebar width constant
+    static const int SIDEBAR_WIDTH = 200;
+    // App rows are all the same height so only visible ones need submitting
+    static constexpr float SIDEBAR_ROW_HEIGHT = 40.0f;
+    static constexpr float SIDEBAR_ICON_SIZE = 24.0f;
+    static constexpr float SIDEBAR_FOOTER_BUTTON_HEIGHT = 35.0f;
+    // Redraw interval while something is loading and nothing else is happening
+    static const int LOADING_REFRESH_MS = 250;
+    // Icons are downscaled once at load to the largest size the sidebar draws them at
+    static const int ICON_TARGET_SIZE = 24;
+
+public:
+    explicit GamingDashboard(DashboardBackends backends);
+
+    ~GamingDashboard();
+
+    void LoadIcons();
+
+    void SetDashboardWindow(WindowId window) { m_dashboardWindow = window; }
+    void SetFrameScheduler(FrameScheduler* scheduler) { m_frameScheduler = scheduler; }
+    void SetAllocationMeter(const FrameAllocationMeter* meter) { m_allocationMeter = meter; }
+
+    // WM_SIZE only marks the layout dirty; a burst of resize messages becomes one ApplyPendingLayout()
+    void OnWindowResize();
+
+    // Fits every embedded window, hidden tabs included, to the content area in one batch.
+    // Runs at the start of each frame, and from a timer while the user drags the border (Windows
+    // runs its own modal loop then, so the frame loop is not running).
+    void ApplyPendingLayout();
+
+    void LoadSettings();
+
+    DashboardSettings CurrentSettings() const;
+
+    // Snapshot now, write on the settings thread
+    void SaveSettings();
+
+    WindowId FindWindowByTitle(const std::string& titlePart);
+
+    void EmbedWindow(WindowId childWindow, AppHandle app, std::shared_ptr<LaunchedProcess> process = nullptr);
+
+    // Content area to the right of the sidebar
+    WindowPlacement TabPlacement(WindowId window) const;
+
+    void FormatWindowToFit(WindowId window);
+
+    void SwitchToTab(AppHandle app);
+
+    // A hidden tab's process tree gets low priority, spare CPUs and (optionally) less memory until shown
+    // again, except for members showing a window of their own and apps that opted out
+    void ThrottleTab(AppHandle app);
+
+    // Also required before a tab lets go of its process, so the governor does not keep a dangling entry
+    void UnthrottleTab(AppHandle app);
+
+    void TrackTabProcess(AppHandle app, const std::shared_ptr<LaunchedProcess>& process);
+
+    // Drop a tab once its whole process tree has exited
+    void OnTabProcessExited(AppHandle app, const LaunchedProcess* process);
+
+    // Safe from any thread; the queue is bounded, so a burst waits for the next frame to drain it. On the
+    // UI thread a full queue is drained on the spot instead, and once the dashboard is being destroyed
+    // other threads drop what does not fit.
+    void PostToUiThread(std::function<void()> command);
+
+    void RunUiCommands();
+
+    // launch -> await window -> await window settled -> embed (on the UI thread)
+    // The registry is UI-thread only, so the pipeline gets its own copy of what it needs
+    Task LaunchPipeline(AppHandle app, std::string name, std::string commandLine, std::string windowTitle,
+        std::shared_ptr<const ReadinessMatcher> readiness, LaunchTimeouts timeouts, bool activate, uint64_t priority, CancellationToken token);
+
+    // Adds the app, loads its icon if it has one and saves the settings
+    AppHandle AddCustomApp(const AppDesc& desc);
+    // Gives its window back to the desktop if it has a tab, forgets the app and saves the settings
+    void RemoveCustomApp(AppHandle app);
+
+    // Embeds the app's window, launching the app first if it is not running. Without activate the tab
+    // is embedded hidden and the current tab stays in front. An activated launch counts as the user's
+    // latest click, so its cold start is admitted ahead of every launch already waiting.
+    void LaunchApp(AppHandle app, bool activate = true);
+    // LaunchApp for each app, with the windows of the ones already running found in a single pass
+    // over the window index. Only activate gets the tab.
+    void LaunchApps(const std::vector<AppHandle>& apps, AppHandle activate);
+
+    // Re-embeds the tabs of the last session whose windows are still open, matched by process id,
+    // title and readiness rule in one pass. The tab that was current is shown. Returns how many.
+    int RestoreSession();
+    // Saves the session, then gives every embedded window back to the desktop so the apps outlive the
+    // dashboard. The tabs stay as they are; call it just before the dashboard window is destroyed.
+    void ReleaseTabs();
+
+    LaunchScheduler& GetLaunchScheduler() { return *m_launchScheduler; }
+    const LaunchLatency& GetLaunchLatency() const { return m_launchLatency; }
+
+    // Adds the profile, replacing one of the same name, and saves the settings
+    void AddLaunchProfile(LaunchProfileSettings profile);
+    const std::vector<LaunchProfileSettings>& LaunchProfiles() const { return m_launchProfiles; }
+
+    // Starts every member of the profile whose dependencies are met, and each of the others as soon as
+    // the windows it waits for are up. The first member gets the tab. False if the profile is unknown or
+    // its dependencies are inconsistent; ProfileStatus() says why.
+    bool LaunchProfile(const std::string& name);
+    bool IsLaunchingProfile() const;
+    // Outcome of the last profile launch, for the Launch Profiles window
+    const std::string& ProfileStatus() const { return m_profileStatus; }
+
+    void Render();
+
+private:
+    // Every launch ends here, embedded or not, so profile members waiting on the app can start
+    void OnLaunchFinished(AppHandle app, bool ready);
+
+    void StartProfileMembers(ProfileLaunch& launch);
+
+    // windows[i] is the open, not yet embedded window of apps[i], or 0. With pids, apps[i] must also
+    // belong to process pids[i].
+    void FindRunningWindows(const std::vector<AppHandle>& apps, const std::vector<ProcessId>& pids,
+        std::vector<WindowId>& windows) const;
+
+    // LaunchApp once the app's running window, if any, is known
+    void LaunchResolved(AppHandle app, bool activate, WindowId existingWindow);
+
+    // Saved profiles with their members, and the form for a new one
+    void RenderProfilesWindow();
+
+    // Frame history, budget, captured slow frames and a per-thread timeline of the selected frame
+    void RenderProfilerWindow();
+
+    // p50/p95/p99 of each launch milestone per app, and the timeouts they give
+    void RenderLaunchStatsWindow();
+
+    // One lane per thread, nested zones stacked below their parent. Zones of other threads that
+    // overlap the frame are clipped to it.
+    void DrawProfileTimeline(const ProfileFrame& frame);
+
+    // Reserves room for an icon; the image itself is drawn later with the others
+    void SidebarIcon(IconTexture& icon, float size);
+
+    // Draws the current window's pending icons. Icons drawn back to back share the atlas texture and
+    // clip rect, so they merge into one ImDrawCmd instead of alternating with the font texture used
+    // by the buttons. Call before ending each window (or child) that reserved icons.
+    void FlushSidebarIcons();
+
+    bool HasCustomApps() const;
+
+    // Built-in apps first, then custom apps, in the order they were added
+    int SidebarRowCount() const;
+
+    void RenderSidebarRow(int row);
+
+    // Icon plus button, exactly SIDEBAR_ROW_HEIGHT tall so the list clipper can skip rows by arithmetic.
+    // Returns true when the app should launch, or when a pending launch was clicked (LaunchApp moves it
+    // up the queue); the pending row's cancel button cancels it instead.
+    bool SidebarAppButton(AppHandle app);
+};
+
@@ -0,0 +1,829 @@
+// Headless frame benchmark: the dashboard on fake window/process backends, drawn by the null renderer
+// or the software rasterizer. Not part of the Visual Studio project (it has its own main). On Linux,
+// from this folder (one command line):
+//
+//   g++ -std=c++20 -O2 -pthread -I. -o headless_benchmark HeadlessBenchmark.cpp NullRenderer.cpp
+//       SoftwareRenderer.cpp GamingDashboard.cpp AllocationCounter.cpp AppRegistry.cpp Executor.cpp
+//       FrameProfiler.cpp FrameScheduler.cpp IconAtlas.cpp IconCache.cpp IconLoader.cpp ImageResample.cpp
+//       LaunchLatency.cpp LaunchPlan.cpp LaunchScheduler.cpp ProcessLauncher.cpp ProcessTelemetry.cpp
+//       ResourceGovernor.cpp SettingsStore.cpp WindowIndex.cpp WindowMatcher.cpp WindowReadiness.cpp
+//       WindowSystem.cpp imgui.cpp imgui_draw.cpp imgui_tables.cpp imgui_widgets.cpp
+//
+//   ./headless_benchmark [frames] [apps] [--software [threads]] [--scalar] [--dump frame.ppm]
+//   ./headless_benchmark --profile [apps]
+//   ./headless_benchmark --io [apps]
+//   ./headless_benchmark --readiness
+//   ./headless_benchmark --restore [apps]
+//
+// --software rasterizes every frame at 1280x800 and also reports raster frames/s and megapixels/s.
+// --dump writes the last frame (software only), for use as a golden image.
+// --profile times a launch profile of fake apps that take 150-850 ms to show their window, started
+// concurrently as declared and then one at a time, and compares both with the apps' startup times.
+// --io launches a profile of fake apps that read 20-79 MB each from a simulated hard disk, then clicks one
+// more app, with the cold-start scheduler off, on without history, and on with the costs it learned.
+// --readiness replays scripted window traces (splash screens, launchers, retitles, resizes) with and without
+// each app's readiness rule, and reports which window was embedded and when, against when it was ready.
+// It exits non-zero if a rule let anything but the main window in, or let it in before it was ready.
+// --restore starts a dashboard whose saved session lists apps still running among thousands of other
+// windows, some of them second instances with the same title, and times RestoreSession against looking
+// each app up by title.
+// Add -DGD_PROFILE to measure with the profiler zones compiled in.
+
+#include "GamingDashboard.h"
+#include "NullRenderer.h"
+#include "SoftwareRenderer.h"
+#include "imgui.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const int WARMUP_FRAMES = 60;
+const float DISPLAY_WIDTH = 1280.0f;
+const float DISPLAY_HEIGHT = 800.0f;
+const char* const ICON_PATHS[] = { "icons/chrome.png", "icons/steam.png", "icons/discord.png", "" };
+
+struct BenchmarkOptions {
+    int frames = 2000;
+    int appCount = 50;
+    bool software = false;
+    int threads = 0;
+    bool scalar = false;
+    std::string dumpPath;
+    bool profile = false;
+    int profileApps = 8;
+    bool io = false;
+    int ioApps = 6;
+    bool readiness = false;
+    bool restore = false;
+    int restoreApps = 40;
+};
+
+struct FrameTotals {
+    uint64_t vertices = 0;
+    uint64_t drawCalls = 0;
+    uint64_t renderNs = 0;
+};
+
+// One frame as the Win32 loop does it, with the mouse sweeping up and down the sidebar
+template <typename Renderer>
+void RunFrame(GamingDashboard& dashboard, Renderer& renderer, int frame, FrameTotals& totals)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 60.0f;
+    io.AddMousePosEvent(100.0f, DISPLAY_HEIGHT * 0.5f * (1.0f + std::sin(frame * 0.05f)));
+
+    ImGui::NewFrame();
+    dashboard.Render();
+    ImGui::Render();
+    auto renderStart = Clock::now();
+    renderer.RenderDrawData(ImGui::GetDrawData());
+    totals.renderNs += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - renderStart).count();
+
+    totals.vertices += ImGui::GetDrawData()->TotalVtxCount;
+    totals.drawCalls += renderer.LastFrame().drawCalls;
+}
+
+void ReportRenderer(NullRenderer&, const BenchmarkOptions&, const FrameTotals&)
+{
+}
+
+void ReportRenderer(SoftwareRenderer& renderer, const BenchmarkOptions& options, const FrameTotals& totals)
+{
+    double seconds = totals.renderNs / 1e9;
+    double pixels = (double)renderer.Width() * renderer.Height() * options.frames;
+    printf("raster:           %dx%d, %d threads, %s\n", renderer.Width(), renderer.Height(), renderer.ThreadCount(),
+        renderer.SimdEnabled() ? "SSE2" : "scalar");
+    printf("raster ns/frame:  %.0f\n", (double)totals.renderNs / options.frames);
+    printf("raster frames/s:  %.0f\n", options.frames / seconds);
+    printf("raster Mpixels/s: %.0f framebuffer, %.0f shaded\n", pixels / seconds / 1e6,
+        (double)renderer.LastFrame().pixelsShaded * options.frames / seconds / 1e6);
+    printf("triangles/frame:  %d (%d binned, %d bin entries)\n", renderer.LastFrame().triangles,
+        renderer.LastFrame().binnedTriangles, renderer.LastFrame().binEntries);
+
+    // The last frame again on the other path; scalar and SSE2 must agree to the bit
+    std::vector<uint32_t> frame(renderer.Pixels(), renderer.Pixels() + (size_t)renderer.Width() * renderer.Height());
+    renderer.SetSimd(!renderer.SimdEnabled());
+    renderer.RenderDrawData(ImGui::GetDrawData());
+    bool identical = memcmp(frame.data(), renderer.Pixels(), frame.size() * sizeof(uint32_t)) == 0;
+    renderer.SetSimd(!renderer.SimdEnabled());
+    printf("scalar == SSE2:   %s\n", identical ? "yes" : "NO");
+
+    if (!options.dumpPath.empty()) {
+        renderer.RenderDrawData(ImGui::GetDrawData());
+        printf("dumped:           %s%s\n", options.dumpPath.c_str(), renderer.SavePpm(options.dumpPath) ? "" : " (failed)");
+    }
+}
+
+// The fake backends of one dashboard, owned by it
+struct FakeBackends {
+    FakeWindowSystem* windows = nullptr;
+    FakeProcessLauncher* launcher = nullptr;
+    FakeDiskMonitor* disk = nullptr;
+};
+
+// A dashboard on fresh fake backends, with its own window and icons loaded. With settings, it starts
+// from those as if they had been saved by an earlier run.
+std::unique_ptr<GamingDashboard> CreateDashboard(FakeBackends& fakes, const DashboardSettings* settings = nullptr)
+{
+    fakes.windows = new FakeWindowSystem();
+    fakes.launcher = new FakeProcessLauncher();
+    fakes.disk = new FakeDiskMonitor();
+    DashboardBackends backends;
+    backends.windowSystem.reset(fakes.windows);
+    backends.processLauncher.reset(fakes.launcher);
+    backends.diskMonitor.reset(fakes.disk);
+    backends.resourceGovernor = std::make_unique<FakeResourceGovernor>();
+    backends.telemetryProvider = std::make_unique<FakeTelemetryProvider>();
+    backends.settingsStore = std::make_unique<MemorySettingsStore>();
+    if (settings) backends.settingsStore->Save(*settings);
+    backends.iconCachePath = "headless_benchmark_icons.bin";
+    auto dashboard = std::make_unique<GamingDashboard>(std::move(backends));
+
+    WindowInfo dashboardWindow;
+    dashboardWindow.title = "Gaming Dashboard";
+    dashboardWindow.visible = true;
+    dashboardWindow.width = (int)DISPLAY_WIDTH;
+    dashboardWindow.height = (int)DISPLAY_HEIGHT;
+    dashboard->SetDashboardWindow(fakes.windows->AddWindow(dashboardWindow));
+    dashboard->LoadIcons();
+    return dashboard;
+}
+
+// Window of a fake app once it has started
+WindowInfo FakeAppWindow(ProcessId pid, const std::string& title)
+{
+    WindowInfo window;
+    window.pid = pid;
+    window.visible = true;
+    window.width = 800;
+    window.height = 600;
+    window.title = "Bench " + title;
+    window.className = "BenchWindow";
+    return window;
+}
+
+template <typename Renderer>
+void RunBenchmark(Renderer& renderer, const BenchmarkOptions& options)
+{
+    FakeBackends fakes;
+    std::unique_ptr<GamingDashboard> dashboardOwner = CreateDashboard(fakes);
+    GamingDashboard& dashboard = *dashboardOwner;
+    FakeWindowSystem* windows = fakes.windows;
+
+    // Each synthetic app already has a window, so launching it embeds that window as a tab
+    for (int i = 0; i < options.appCount; i++) {
+        AppDesc desc;
+        desc.name = "Bench App " + std::to_string(i);
+        desc.commandLine = "bench_app.exe";
+        desc.iconPath = ICON_PATHS[i % (sizeof(ICON_PATHS) / sizeof(ICON_PATHS[0]))];
+        // Brackets so "[app 1]" does not also match "[app 10]"
+        desc.windowTitle = "[app " + std::to_string(i) + "]";
+        desc.custom = true;
+
+        windows->AddWindow(FakeAppWindow(5000 + i, desc.windowTitle));
+
+        dashboard.LaunchApp(dashboard.AddCustomApp(desc));
+    }
+
+    FrameTotals totals;
+    for (int frame = 0; frame < WARMUP_FRAMES; frame++) {
+        RunFrame(dashboard, renderer, frame, totals);
+    }
+
+    totals = FrameTotals();
+    auto start = Clock::now();
+    for (int frame = 0; frame < options.frames; frame++) {
+        RunFrame(dashboard, renderer, WARMUP_FRAMES + frame, totals);
+    }
+    auto elapsed = Clock::now() - start;
+
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    printf("frames:           %d\n", options.frames);
+    printf("apps:             %d custom + 3 built-in\n", options.appCount);
+    printf("ns/frame:         %.0f\n", ns / options.frames);
+    printf("vertices/frame:   %.1f\n", (double)totals.vertices / options.frames);
+    printf("draw calls/frame: %.1f\n", (double)totals.drawCalls / options.frames);
+    ReportRenderer(renderer, options, totals);
+
+    // Like the Win32 loop: the renderer lets go of its textures before the dashboard deletes the atlas
+    renderer.Shutdown();
+}
+
+// Startup time of profile app i, spread over 150-850 ms
+int ProfileAppStartupMs(int i)
+{
+    return 150 + (i * 373) % 701;
+}
+
+// Every fourth app is an overlay that starts after app 0, the way an overlay waits for Steam
+bool ProfileAppWaitsForFirst(int i)
+{
+    return i % 4 == 3;
+}
+
+// Launches the profile and renders frames until every member is embedded; returns the wall time in ms
+double TimeProfileLaunch(NullRenderer& renderer, int appCount, bool oneAtATime)
+{
+    FakeBackends fakes;
+    std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes);
+    // These apps read nothing; this measures dependency ordering alone, --io measures the cold-start cap
+    dashboard->GetLaunchScheduler().SetEnabled(false);
+
+    // A fake app shows its window once its startup time has passed; the command line carries that time
+    FakeWindowSystem* windows = fakes.windows;
+    std::mutex appThreadsMutex;
+    std::vector<std::thread> appThreads;
+    fakes.launcher->SetLaunchHandler([windows, &appThreadsMutex, &appThreads](ProcessId pid, const std::string& commandLine) {
+        size_t space = commandLine.find(' ');
+        int startupMs = atoi(commandLine.c_str() + space + 1);
+        std::string title = commandLine.substr(commandLine.find(' ', space + 1) + 1);
+        std::lock_guard<std::mutex> lock(appThreadsMutex);
+        appThreads.emplace_back([windows, pid, startupMs, title]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(startupMs));
+            windows->AddWindow(FakeAppWindow(pid, title));
+        });
+    });
+
+    LaunchProfileSettings profile;
+    profile.name = oneAtATime ? "One at a time" : "Concurrent";
+    for (int i = 0; i < appCount; i++) {
+        AppDesc desc;
+        desc.name = "Profile App " + std::to_string(i);
+        desc.windowTitle = "[profile app " + std::to_string(i) + "]";
+        desc.commandLine = "bench_app.exe " + std::to_string(ProfileAppStartupMs(i)) + " " + desc.windowTitle;
+        desc.custom = true;
+        dashboard->AddCustomApp(desc);
+
+        LaunchProfileAppSettings member;
+        member.name = desc.name;
+        if (oneAtATime && i > 0) member.after.push_back("Profile App " + std::to_string(i - 1));
+        else if (!oneAtATime && ProfileAppWaitsForFirst(i)) member.after.push_back("Profile App 0");
+        profile.apps.push_back(member);
+    }
+    dashboard->AddLaunchProfile(profile);
+
+    FrameTotals totals;
+    auto start = Clock::now();
+    dashboard->LaunchProfile(profile.name);
+    for (int frame = 0; dashboard->IsLaunchingProfile(); frame++) {
+        RunFrame(*dashboard, renderer, frame, totals);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    printf("%-18s%.0f ms wall (%s)\n", (profile.name + ":").c_str(), ms, dashboard->ProfileStatus().c_str());
+
+    for (std::thread& thread : appThreads) thread.join();
+    renderer.Shutdown();
+    return ms;
+}
+
+void RunProfileBenchmark(const BenchmarkOptions& options)
+{
+    int sum = 0;
+    int slowest = 0;
+    int criticalPath = 0;
+    int overlays = 0;
+    for (int i = 0; i < options.profileApps; i++) {
+        int startup = ProfileAppStartupMs(i);
+        int finish = ProfileAppWaitsForFirst(i) ? ProfileAppStartupMs(0) + startup : startup;
+        sum += startup;
+        if (startup > slowest) slowest = startup;
+        if (finish > criticalPath) criticalPath = finish;
+        if (ProfileAppWaitsForFirst(i)) overlays++;
+    }
+    printf("profile apps:     %d (%d start after app 0)\n", options.profileApps, overlays);
+    printf("startup ms:       sum %d, slowest %d, critical path %d\n", sum, slowest, criticalPath);
+
+    NullRenderer renderer;
+    renderer.Init();
+    double concurrentMs = TimeProfileLaunch(renderer, options.profileApps, false);
+    renderer.Init();
+    double serialMs = TimeProfileLaunch(renderer, options.profileApps, true);
+    printf("speedup:          %.1fx (critical path overhead %.0f ms)\n", serialMs / concurrentMs, concurrentMs - criticalPath);
+}
+
+// A hard disk shared by the fake apps: each app starts once it has read its bytes. Readers seek against
+// each other, so the disk delivers less in total the more apps read at once.
+class SimulatedDisk {
+public:
+    static constexpr double BYTES_PER_SECOND = 120.0 * 1024 * 1024;
+    // Throughput lost per extra concurrent reader
+    static constexpr double SEEK_PENALTY = 0.3;
+    static const int STEP_MS = 2;
+
+    SimulatedDisk(FakeWindowSystem& windows, FakeDiskMonitor& monitor) : m_windows(windows), m_monitor(monitor) {
+        m_thread = std::thread([this]() { Run(); });
+    }
+
+    ~SimulatedDisk() {
+        m_stop = true;
+        m_thread.join();
+    }
+
+    void StartApp(ProcessId pid, uint64_t bytes, const std::string& title) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_readers.push_back(Reader{ pid, (double)bytes, title });
+    }
+
+    // Time the app's window showed up; false while it is still reading
+    bool StartedAt(const std::string& title, Clock::time_point& time) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_started.find(title);
+        if (it == m_started.end()) return false;
+        time = it->second;
+        return true;
+    }
+
+    int StartedCount() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return (int)m_started.size();
+    }
+
+private:
+    struct Reader {
+        ProcessId pid;
+        double remaining;
+        std::string title;
+    };
+
+    void Run() {
+        auto last = Clock::now();
+        while (!m_stop) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(STEP_MS));
+            auto now = Clock::now();
+            double seconds = std::chrono::duration<double>(now - last).count();
+            last = now;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_readers.empty()) continue;
+            double total = BYTES_PER_SECOND / (1.0 + SEEK_PENALTY * (m_readers.size() - 1)) * seconds;
+            double share = total / m_readers.size();
+            double read = 0.0;
+            for (size_t i = 0; i < m_readers.size();) {
+                Reader& reader = m_readers[i];
+                double bytes = std::min(share, reader.remaining);
+                reader.remaining -= bytes;
+                read += bytes;
+                if (reader.remaining > 0.0) {
+                    i++;
+                    continue;
+                }
+                m_windows.AddWindow(FakeAppWindow(reader.pid, reader.title));
+                m_started[reader.title] = now;
+                m_readers.erase(m_readers.begin() + i);
+            }
+            m_monitor.AddBytesRead((uint64_t)read);
+        }
+    }
+
+    FakeWindowSystem& m_windows;
+    FakeDiskMonitor& m_monitor;
+    std::mutex m_mutex;
+    std::vector<Reader> m_readers;
+    std::map<std::string, Clock::time_point> m_started;
+    std::atomic<bool> m_stop{ false };
+    std::thread m_thread;
+};
+
+// Bytes app i reads before its window shows: 20-79 MB
+uint64_t IoAppBytes(int i)
+{
+    return (uint64_t)(20 + (i * 97) % 60) * 1024 * 1024;
+}
+
+struct IoResult {
+    double totalMs = 0.0;
+    double clickedMs = 0.0;
+};
+
+// A profile of background apps starts, and 50 ms later the user clicks one more app. Returns the time until
+// every window is up and the time from the click to the clicked app's window.
+IoResult TimeIoLaunch(NullRenderer& renderer, int appCount, const char* label, bool schedule, std::map<std::string, LaunchCost>& costs)
+{
+    FakeBackends fakes;
+    std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes);
+    LaunchScheduler& scheduler = dashboard->GetLaunchScheduler();
+    scheduler.SetEnabled(schedule);
+    scheduler.SetCosts(costs);
+
+    SimulatedDisk disk(*fakes.windows, *fakes.disk);
+    fakes.launcher->SetLaunchHandler([&disk](ProcessId pid, const std::string& commandLine) {
+        size_t space = commandLine.find(' ');
+        uint64_t bytes = strtoull(commandLine.c_str() + space + 1, nullptr, 10);
+        disk.StartApp(pid, bytes, commandLine.substr(commandLine.find(' ', space + 1) + 1));
+    });
+
+    LaunchProfileSettings profile;
+    profile.name = "Background";
+    AppHandle clicked;
+    std::string clickedTitle;
+    for (int i = 0; i <= appCount; i++) {
+        AppDesc desc;
+        desc.name = "IO App " + std::to_string(i);
+        desc.windowTitle = "[io app " + std::to_string(i) + "]";
+        desc.commandLine = "bench_io.exe " + std::to_string(IoAppBytes(i)) + " " + desc.windowTitle;
+        desc.custom = true;
+        AppHandle app = dashboard->AddCustomApp(desc);
+        if (i == appCount) {
+            clicked = app;
+            clickedTitle = desc.windowTitle;
+            break;
+        }
+        LaunchProfileAppSettings member;
+        member.name = desc.name;
+        profile.apps.push_back(member);
+    }
+    dashboard->AddLaunchProfile(profile);
+
+    FrameTotals totals;
+    auto start = Clock::now();
+    auto clickTime = start + std::chrono::milliseconds(50);
+    bool clickedYet = false;
+    dashboard->LaunchProfile(profile.name);
+    for (int frame = 0; !clickedYet || dashboard->IsLaunchingProfile() || scheduler.StartingCount() > 0 || scheduler.QueuedCount() > 0; frame++) {
+        if (!clickedYet && Clock::now() >= clickTime) {
+            clickTime = Clock::now();
+            dashboard->LaunchApp(clicked, true);
+            clickedYet = true;
+        }
+        RunFrame(*dashboard, renderer, frame, totals);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    IoResult result;
+    Clock::time_point clickedStarted;
+    result.totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    if (disk.StartedAt(clickedTitle, clickedStarted)) {
+        result.clickedMs = std::chrono::duration<double, std::milli>(clickedStarted - clickTime).count();
+    }
+    printf("%-22s%6.0f ms all windows, %6.0f ms click to window (%d started)\n",
+        label, result.totalMs, result.clickedMs, disk.StartedCount());
+
+    costs = scheduler.Costs();
+    renderer.Shutdown();
+    return result;
+}
+
+void RunIoBenchmark(const BenchmarkOptions& options)
+{
+    uint64_t totalBytes = 0;
+    for (int i = 0; i <= options.ioApps; i++) totalBytes += IoAppBytes(i);
+    printf("io apps:              %d in a profile + 1 clicked, %.0f MB to read\n", options.ioApps, totalBytes / (1024.0 * 1024.0));
+    printf("simulated disk:       %.0f MB/s, %.0f%% lost per extra reader\n",
+        SimulatedDisk::BYTES_PER_SECOND / (1024.0 * 1024.0), SimulatedDisk::SEEK_PENALTY * 100.0);
+
+    NullRenderer renderer;
+    std::map<std::string, LaunchCost> costs;
+    renderer.Init();
+    TimeIoLaunch(renderer, options.ioApps, "unscheduled:", false, costs);
+    costs.clear();
+    renderer.Init();
+    TimeIoLaunch(renderer, options.ioApps, "scheduled, no history:", true, costs);
+    renderer.Init();
+    TimeIoLaunch(renderer, options.ioApps, "scheduled, learned:", true, costs);
+}
+
+// One step of a scripted window trace, at a time after the process started. Windows are numbered
+// in the order the trace creates them.
+struct TraceStep {
+    enum Action { CREATE, RESIZE, RETITLE, DESTROY };
+
+    int atMs;
+    Action action;
+    int window;
+    int width;
+    int height;
+    const char* title;
+    const char* className;
+    uint32_t style;
+};
+
+struct ReadinessTrace {
+    const char* name;
+    ReadinessRule rule;
+    std::vector<TraceStep> steps;
+    // The app's main window, and when it was ready to embed
+    int mainWindow;
+    int readyAtMs;
+};
+
+std::vector<ReadinessTrace> ReadinessTraces()
+{
+    const uint32_t splash = WindowStyle::POPUP;
+    const uint32_t framed = WindowStyle::CAPTION | WindowStyle::THICK_FRAME;
+    std::vector<ReadinessTrace> traces;
+
+    ReadinessTrace updater = { "small splash", {}, {}, 1, 900 };
+    updater.rule.minWidth = 301;
+    updater.rule.minHeight = 201;
+    updater.steps = {
+        { 100, TraceStep::CREATE, 0, 300, 350, "Trace Updater", "Chrome_WidgetWin_1", splash },
+        { 900, TraceStep::CREATE, 1, 940, 500, "Trace", "Chrome_WidgetWin_1", framed },
+        { 950, TraceStep::DESTROY, 0, 0, 0, nullptr, nullptr, 0 },
+    };
+    traces.push_back(updater);
+
+    ReadinessTrace launcher = { "launcher window", {}, {}, 1, 700 };
+    launcher.rule.className = "TraceMain";
+    launcher.steps = {
+        { 50, TraceStep::CREATE, 0, 800, 600, "Trace Launcher", "TraceLauncher", framed },
+        { 700, TraceStep::CREATE, 1, 1280, 720, "Trace", "TraceMain", framed },
+        { 750, TraceStep::DESTROY, 0, 0, 0, nullptr, nullptr, 0 },
+    };
+    traces.push_back(launcher);
+
+    ReadinessTrace loading = { "loading title", {}, {}, 0, 600 };
+    loading.rule.titlePattern = "trace - l?brary*";
+    loading.steps = {
+        { 50, TraceStep::CREATE, 0, 1024, 768, "Trace - Loading...", "TraceMain", framed },
+        { 600, TraceStep::RETITLE, 0, 0, 0, "Trace - Library (3 updates)", nullptr, 0 },
+    };
+    traces.push_back(loading);
+
+    ReadinessTrace bigSplash = { "large popup splash", {}, {}, 1, 500 };
+    bigSplash.rule.requiredStyle = WindowStyle::CAPTION;
+    bigSplash.rule.excludedStyle = WindowStyle::POPUP;
+    bigSplash.steps = {
+        { 50, TraceStep::CREATE, 0, 600, 400, "Trace", "TraceSplash", splash },
+        { 500, TraceStep::CREATE, 1, 1200, 800, "Trace", "TraceMain", framed },
+        { 520, TraceStep::DESTROY, 0, 0, 0, nullptr, nullptr, 0 },
+    };
+    traces.push_back(bigSplash);
+
+    ReadinessTrace growing = { "resizing window", {}, {}, 0, 800 };
+    growing.rule.stableMs = 400;
+    growing.steps = {
+        { 50, TraceStep::CREATE, 0, 640, 480, "Trace", "TraceMain", framed },
+        { 300, TraceStep::RESIZE, 0, 800, 600, nullptr, nullptr, 0 },
+        { 550, TraceStep::RESIZE, 0, 1024, 768, nullptr, nullptr, 0 },
+        { 800, TraceStep::RESIZE, 0, 1280, 720, nullptr, nullptr, 0 },
+    };
+    traces.push_back(growing);
+    return traces;
+}
+
+// Launches an app whose process plays the trace, and reports the window embedded and when. False if the
+// app's rule was applied and the main window was not the one embedded once it was ready.
+bool ReplayReadinessTrace(NullRenderer& renderer, const ReadinessTrace& trace, bool withRule)
+{
+    FakeBackends fakes;
+    std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes);
+    FakeWindowSystem* windows = fakes.windows;
+
+    // Only the player touches these until it is joined
+    std::vector<WindowId> traceWindows;
+    int destroyedEmbedded = -1;
+    Clock::time_point processStart;
+    std::thread player;
+    fakes.launcher->SetLaunchHandler([&](ProcessId pid, const std::string&) {
+        processStart = Clock::now();
+        player = std::thread([&trace, &traceWindows, &destroyedEmbedded, windows, pid, start = processStart]() {
+            for (const TraceStep& step : trace.steps) {
+                std::this_thread::sleep_until(start + std::chrono::milliseconds(step.atMs));
+                switch (step.action) {
+                case TraceStep::CREATE: {
+                    WindowInfo window;
+                    window.pid = pid;
+                    window.visible = true;
+                    window.width = step.width;
+                    window.height = step.height;
+                    window.style = step.style;
+                    window.title = step.title;
+                    window.className = step.className;
+                    traceWindows.push_back(windows->AddWindow(window));
+                    break;
+                }
+                case TraceStep::RESIZE: windows->SetSize(traceWindows[step.window], step.width, step.height); break;
+                case TraceStep::RETITLE: windows->SetTitle(traceWindows[step.window], step.title); break;
+                case TraceStep::DESTROY: {
+                    // A splash embedded by mistake is gone by the end; note it on the way out
+                    WindowInfo info;
+                    if (windows->QueryWindow(traceWindows[step.window], info) && info.parent != 0) destroyedEmbedded = step.window;
+                    windows->RemoveWindow(traceWindows[step.window]);
+                    break;
+                }
+                }
+            }
+        });
+    });
+
+    AppDesc desc;
+    desc.name = "Trace App";
+    desc.commandLine = "trace_app.exe";
+    desc.windowTitle = "Trace";
+    desc.custom = true;
+    if (withRule) desc.readiness = trace.rule;
+    dashboard->AddCustomApp(desc);
+    LaunchProfileSettings profile;
+    profile.name = "Trace";
+    profile.apps.push_back({ desc.name, {} });
+    dashboard->AddLaunchProfile(profile);
+
+    FrameTotals totals;
+    dashboard->LaunchProfile(profile.name);
+    for (int frame = 0; dashboard->IsLaunchingProfile(); frame++) {
+        RunFrame(*dashboard, renderer, frame, totals);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double embeddedMs = std::chrono::duration<double, std::milli>(Clock::now() - processStart).count();
+
+    // The embedded window is the one with a parent once the trace has played out, or the one destroyed with one
+    if (player.joinable()) player.join();
+    int embedded = destroyedEmbedded;
+    for (size_t i = 0; i < traceWindows.size(); i++) {
+        WindowInfo info;
+        if (windows->QueryWindow(traceWindows[i], info) && info.parent != 0) embedded = (int)i;
+    }
+    bool early = embedded == trace.mainWindow && embeddedMs < trace.readyAtMs;
+    const char* verdict = embedded < 0 ? "nothing embedded" : embedded != trace.mainWindow ? "WRONG WINDOW (splash)" :
+        early ? "main window, before it was ready" : "main window";
+    bool passed = !withRule || (embedded == trace.mainWindow && !early);
+    printf("%-20s %-8s %6.0f ms (ready at %4d ms): %s%s\n", trace.name, withRule ? "rule" : "no rule", embeddedMs, trace.readyAtMs,
+        verdict, passed ? "" : " - FAILED");
+    renderer.Shutdown();
+    return passed;
+}
+
+// Number of traces whose rule did not hold out for the main window
+int RunReadinessBenchmark()
+{
+    NullRenderer renderer;
+    int failures = 0;
+    for (const ReadinessTrace& trace : ReadinessTraces()) {
+        for (bool withRule : { false, true }) {
+            renderer.Init();
+            if (!ReplayReadinessTrace(renderer, trace, withRule)) failures++;
+        }
+    }
+    return failures;
+}
+
+const int RESTORE_OTHER_WINDOWS = 5000;
+const ProcessId RESTORE_FIRST_PID = 20000;
+
+// Every saved tab's app is running, behind RESTORE_OTHER_WINDOWS unrelated windows opened since. Every
+// third app also has a second instance with the same title, opened after the one that was the tab.
+void RunRestoreBenchmark(const BenchmarkOptions& options)
+{
+    DashboardSettings saved;
+    for (int i = 0; i < options.restoreApps; i++) {
+        CustomAppSettings app;
+        app.name = "Restore App " + std::to_string(i);
+        app.exePath = "restore_app_" + std::to_string(i) + ".exe";
+        app.windowTitle = "Bench Restore " + std::to_string(i) + " ";
+        // Half the apps keep splash screens out with a rule
+        if (i % 2 == 0) app.readiness.minWidth = 400;
+        saved.customApps.push_back(app);
+        saved.sessionTabs.push_back({ app.name, RESTORE_FIRST_PID + (ProcessId)i });
+    }
+
+    FakeBackends fakes;
+    std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes, &saved);
+    std::vector<WindowId> tabWindows;
+    for (int i = 0; i < options.restoreApps; i++) {
+        tabWindows.push_back(fakes.windows->AddWindow(FakeAppWindow(RESTORE_FIRST_PID + i, "Restore " + std::to_string(i) + " - Main")));
+    }
+    for (int i = 0; i < options.restoreApps; i += 3) {
+        fakes.windows->AddWindow(FakeAppWindow(RESTORE_FIRST_PID + 10000 + i, "Restore " + std::to_string(i) + " (other instance)"));
+    }
+    for (int i = 0; i < RESTORE_OTHER_WINDOWS; i++) {
+        WindowInfo window = FakeAppWindow(100 + i, "Document " + std::to_string(i) + " - Editor");
+        window.className = "Editor";
+        fakes.windows->AddWindow(window);
+    }
+
+    // The lookup this replaces: one scan of the index per app, by title alone
+    auto scanStart = Clock::now();
+    int scanRight = 0;
+    for (int i = 0; i < options.restoreApps; i++) {
+        if (dashboard->FindWindowByTitle(saved.customApps[i].windowTitle) == tabWindows[i]) scanRight++;
+    }
+    double scanMs = std::chrono::duration<double, std::milli>(Clock::now() - scanStart).count();
+
+    auto restoreStart = Clock::now();
+    int restored = dashboard->RestoreSession();
+    double restoreMs = std::chrono::duration<double, std::milli>(Clock::now() - restoreStart).count();
+    int restoreRight = 0;
+    for (WindowId window : tabWindows) {
+        WindowInfo info;
+        if (fakes.windows->QueryWindow(window, info) && info.parent != 0) restoreRight++;
+    }
+
+    printf("windows:          %d (%d saved tabs)\n", RESTORE_OTHER_WINDOWS + options.restoreApps + (options.restoreApps + 2) / 3,
+        options.restoreApps);
+    printf("title per app:    %.2f ms lookups only, %d of %d right windows\n", scanMs, scanRight, options.restoreApps);
+    printf("RestoreSession:   %.2f ms one pass and embedding, %d restored, %d right windows\n", restoreMs, restored, restoreRight);
+}
+
+bool ParseOptions(int argc, char** argv, BenchmarkOptions& options)
+{
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--software") == 0) {
+            options.software = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') options.threads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--profile") == 0) {
+            options.profile = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') options.profileApps = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--io") == 0) {
+            options.io = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') options.ioApps = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--readiness") == 0) {
+            options.readiness = true;
+        }
+        else if (strcmp(argv[i], "--restore") == 0) {
+            options.restore = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') options.restoreApps = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--scalar") == 0) {
+            options.scalar = true;
+        }
+        else if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc) {
+            options.dumpPath = argv[++i];
+        }
+        else if (argv[i][0] != '-' && positional == 0) {
+            options.frames = atoi(argv[i]);
+            positional++;
+        }
+        else if (argv[i][0] != '-' && positional == 1) {
+            options.appCount = atoi(argv[i]);
+            positional++;
+        }
+        else {
+            return false;
+        }
+    }
+    return options.frames > 0 && options.appCount >= 0 && options.threads >= 0 && options.profileApps > 0 && options.ioApps > 0 &&
+        options.restoreApps > 0;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        fprintf(stderr, "usage: %s [frames] [apps] [--software [threads]] [--scalar] [--dump frame.ppm]\n", argv[0]);
+        fprintf(stderr, "       %s --profile [apps]\n", argv[0]);
+        fprintf(stderr, "       %s --io [apps]\n", argv[0]);
+        fprintf(stderr, "       %s --readiness\n", argv[0]);
+        fprintf(stderr, "       %s --restore [apps]\n", argv[0]);
+        return 1;
+    }
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+    io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    ApplyDashboardStyle();
+
+    int exitCode = 0;
+    if (options.profile) {
+        RunProfileBenchmark(options);
+    }
+    else if (options.io) {
+        RunIoBenchmark(options);
+    }
+    else if (options.readiness) {
+        if (RunReadinessBenchmark() > 0) exitCode = 1;
+    }
+    else if (options.restore) {
+        RunRestoreBenchmark(options);
+    }
+    else if (options.software) {
+        SoftwareRenderer renderer(options.threads);
+        renderer.SetClearColor(ImVec4(0.05f, 0.07f, 0.09f, 1.00f));
+        renderer.SetSimd(!options.scalar);
+        renderer.Init();
+        RunBenchmark(renderer, options);
+    }
+    else {
+        NullRenderer renderer;
+        renderer.Init();
+        RunBenchmark(renderer, options);
+    }
+
+    ImGui::DestroyContext();
+    remove("headless_benchmark_icons.bin");
+    return exitCode;
+}
@@ -0,0 +1,2764 @@
+// Headless checks: the dashboard's parts on fake backends, each condition checked and every failure
+// listed. Exits non-zero if any check fails. Not part of the Visual Studio project (it has its own main).
+// Built like HeadlessBenchmark.cpp, with this file in its place. On Linux, from this folder (one
+// command line):
+//
+//   g++ -std=c++20 -O2 -pthread -I. -DGD_COUNT_ALLOCATIONS -o headless_checks HeadlessChecks.cpp NullRenderer.cpp
+//       SoftwareRenderer.cpp GamingDashboard.cpp AllocationCounter.cpp AppRegistry.cpp Executor.cpp
+//       FrameProfiler.cpp FrameScheduler.cpp IconAtlas.cpp IconCache.cpp IconLoader.cpp ImageResample.cpp
+//       LaunchLatency.cpp LaunchPlan.cpp LaunchScheduler.cpp ProcessLauncher.cpp ProcessTelemetry.cpp
+//       ResourceGovernor.cpp SettingsStore.cpp WindowIndex.cpp WindowMatcher.cpp WindowReadiness.cpp
+//       WindowSystem.cpp imgui.cpp imgui_draw.cpp imgui_tables.cpp imgui_widgets.cpp
+//
+//   ./headless_checks [check ...]
+//
+// With no arguments every check runs; otherwise only the named ones. GD_COUNT_ALLOCATIONS is what lets
+// frame-allocations count. Add -fsanitize=thread to the command line to have the concurrency checks
+// (command-queue, spsc-ring, coroutines, telemetry) report data races as well.
+
+#include "AllocationCounter.h"
+#include "CommandQueue.h"
+#include "Executor.h"
+#include "FrameProfiler.h"
+#include "GamingDashboard.h"
+#include "IconAtlas.h"
+#include "IconCache.h"
+#include "IconLoader.h"
+#include "ImageResample.h"
+#include "LaunchLatency.h"
+#include "NullRenderer.h"
+#include "ProcessLauncher.h"
+#include "ProcessTelemetry.h"
+#include "ResourceGovernor.h"
+#include "SettingsStore.h"
+#include "SpscRing.h"
+#include "WindowIndex.h"
+#include "WindowReadiness.h"
+#include "WindowSystem.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const float DISPLAY_WIDTH = 1280.0f;
+const float DISPLAY_HEIGHT = 800.0f;
+const char* const ICON_CACHE_PATH = "headless_checks_icons.bin";
+const char* const ICON_PATHS[] = { "icons/chrome.png", "icons/steam.png", "icons/discord.png", "icons/controller.png",
+    "icons/settings.png" };
+const int ICON_PATH_COUNT = (int)(sizeof(ICON_PATHS) / sizeof(ICON_PATHS[0]));
+
+int g_failures = 0;
+
+// Records a failure and carries on, so one run reports every failed condition
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            g_failures++; \
+        } \
+    } while (0)
+
+double MsSince(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+WindowInfo TopLevelWindow(const std::string& title)
+{
+    WindowInfo window;
+    window.pid = 100;
+    window.visible = true;
+    window.width = 800;
+    window.height = 600;
+    window.title = title;
+    window.className = "CheckWindow";
+    return window;
+}
+
+// The fake backends of one dashboard, owned by it
+struct FakeBackends {
+    FakeWindowSystem* windows = nullptr;
+    FakeProcessLauncher* launcher = nullptr;
+    FakeResourceGovernor* governor = nullptr;
+    MemorySettingsStore* settings = nullptr;
+};
+
+// A dashboard on fresh fake backends, with its own window and icons loaded. Declare its renderer after
+// it, so the renderer lets go of its textures before the dashboard deletes the atlas. A given store
+// replaces the in-memory one, and fakes.settings stays null.
+std::unique_ptr<GamingDashboard> CreateDashboard(FakeBackends& fakes, const DashboardSettings* settings = nullptr,
+    std::unique_ptr<SettingsStore> store = nullptr)
+{
+    fakes.windows = new FakeWindowSystem();
+    fakes.launcher = new FakeProcessLauncher();
+    DashboardBackends backends;
+    backends.windowSystem.reset(fakes.windows);
+    backends.processLauncher.reset(fakes.launcher);
+    fakes.governor = new FakeResourceGovernor();
+    backends.resourceGovernor.reset(fakes.governor);
+    backends.telemetryProvider = std::make_unique<FakeTelemetryProvider>();
+    if (store) {
+        fakes.settings = nullptr;
+        backends.settingsStore = std::move(store);
+    }
+    else {
+        fakes.settings = new MemorySettingsStore();
+        backends.settingsStore.reset(fakes.settings);
+        if (settings) fakes.settings->Save(*settings);
+    }
+    backends.iconCachePath = ICON_CACHE_PATH;
+    auto dashboard = std::make_unique<GamingDashboard>(std::move(backends));
+
+    WindowInfo dashboardWindow = TopLevelWindow("Gaming Dashboard");
+    dashboardWindow.width = (int)DISPLAY_WIDTH;
+    dashboardWindow.height = (int)DISPLAY_HEIGHT;
+    dashboard->SetDashboardWindow(fakes.windows->AddWindow(dashboardWindow));
+    dashboard->LoadIcons();
+    return dashboard;
+}
+
+// One frame as the Win32 loop does it
+void RunFrame(GamingDashboard& dashboard, NullRenderer& renderer)
+{
+    ImGui::GetIO().DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+    dashboard.Render();
+    ImGui::Render();
+    renderer.RenderDrawData(ImGui::GetDrawData());
+}
+
+// The polling loop this replaced looked once a second; an event-driven wait wakes within a few ms
+const double DISCOVERY_LIMIT_MS = 50.0;
+
+// Wait blocks on one of the two waiters below until a window titled "Target" turns up
+template <typename Wait>
+void CheckDiscovery(const char* waiter, FakeWindowSystem& windows, Wait wait)
+{
+    // Already on screen: found without waiting for an event
+    WindowId existing = windows.AddWindow(TopLevelWindow("Existing Target"));
+    Clock::time_point start = Clock::now();
+    CHECK(wait(MatchWindowTitle("Existing Target"), 1000) == existing);
+    CHECK(MsSince(start) < DISCOVERY_LIMIT_MS);
+
+    // Created while waiting
+    Clock::time_point created;
+    WindowId appeared = 0;
+    std::thread creator([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        created = Clock::now();
+        appeared = windows.AddWindow(TopLevelWindow("New Target"));
+    });
+    WindowId found = wait(MatchWindowTitle("New Target"), 2000);
+    double latencyMs = MsSince(created);
+    creator.join();
+    CHECK(found != 0 && found == appeared);
+    CHECK(latencyMs < DISCOVERY_LIMIT_MS);
+    printf("  %s: window found %.2f ms after it was created\n", waiter, latencyMs);
+
+    // Hidden, then retitled, then shown: only the last event makes it match
+    WindowInfo hidden = TopLevelWindow("Loading");
+    hidden.visible = false;
+    WindowId late = windows.AddWindow(hidden);
+    std::thread changer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        windows.SetTitle(late, "Late Target");
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        windows.SetVisible(late, true);
+    });
+    CHECK(wait(MatchWindowTitle("Late Target"), 2000) == late);
+    changer.join();
+
+    // Nothing matches: 0 once the timeout has passed, not before
+    start = Clock::now();
+    CHECK(wait(MatchWindowTitle("Never"), 100) == 0);
+    CHECK(MsSince(start) >= 100.0);
+
+    windows.RemoveWindow(existing);
+    windows.RemoveWindow(appeared);
+    windows.RemoveWindow(late);
+}
+
+void CheckWindowDiscovery()
+{
+    FakeWindowSystem windows;
+    CheckDiscovery("WaitForWindow", windows, [&](const WindowPredicate& predicate, int timeoutMs) {
+        return WaitForWindow(windows, predicate, timeoutMs);
+    });
+
+    WindowIndex index(windows);
+    CheckDiscovery("WindowIndex::WaitFor", windows, [&](const WindowPredicate& predicate, int timeoutMs) {
+        return index.WaitFor(predicate, timeoutMs);
+    });
+}
+
+// The first window in z-order the way the EnumWindows scan found it: query every window, top first
+WindowId ScanForTitle(FakeWindowSystem& windows, const std::string& titlePart)
+{
+    std::vector<WindowId> all;
+    windows.EnumerateWindows(all);
+    WindowPredicate predicate = MatchWindowTitle(titlePart);
+    for (WindowId window : all) {
+        WindowInfo info;
+        if (windows.QueryWindow(window, info) && predicate(info)) return window;
+    }
+    return 0;
+}
+
+// Every window the system has, as the system sees it, and nothing else
+void CheckIndexMatchesSystem(FakeWindowSystem& windows, const WindowIndex& index)
+{
+    std::vector<WindowId> all;
+    windows.EnumerateWindows(all);
+    CHECK(index.Size() == all.size());
+    for (WindowId window : all) {
+        WindowInfo expected, indexed;
+        CHECK(windows.QueryWindow(window, expected));
+        CHECK(index.Lookup(window, indexed));
+        CHECK(indexed.id == window && indexed.title == expected.title && indexed.visible == expected.visible &&
+            indexed.width == expected.width && indexed.height == expected.height && indexed.parent == expected.parent);
+    }
+}
+
+void CheckWindowIndex()
+{
+    FakeWindowSystem windows;
+    std::mt19937 random(2);
+    std::vector<WindowId> live;
+    auto title = [&]() { return "Window " + std::to_string(random() % 40); };
+    for (int i = 0; i < 50; i++) {
+        live.push_back(windows.AddWindow(TopLevelWindow(title())));
+    }
+
+    // Seeded from the windows already open, then kept current by events alone
+    WindowIndex index(windows);
+    CheckIndexMatchesSystem(windows, index);
+    for (int step = 0; step < 5000; step++) {
+        WindowId window = live[random() % live.size()];
+        switch (random() % 6) {
+        case 0: live.push_back(windows.AddWindow(TopLevelWindow(title()))); break;
+        case 1: windows.SetTitle(window, title()); break;
+        case 2: windows.SetVisible(window, random() % 2 == 0); break;
+        case 3: windows.SetSize(window, 100 + random() % 900, 100 + random() % 700); break;
+        case 4:
+            if (random() % 2 == 0) windows.EmbedWindow(window, live[0]);
+            else windows.ReleaseWindow(window);
+            break;
+        case 5:
+            if (live.size() > 10) {
+                windows.RemoveWindow(window);
+                live.erase(std::find(live.begin(), live.end(), window));
+            }
+            break;
+        }
+    }
+    CheckIndexMatchesSystem(windows, index);
+
+    // Where several windows match, the newest wins, as the top-most did in the scan
+    for (int i = 0; i < 40; i++) {
+        std::string part = "Window " + std::to_string(i);
+        CHECK(index.FindByTitle(part) == ScanForTitle(windows, part));
+    }
+    WindowId older = windows.AddWindow(TopLevelWindow("Twin"));
+    WindowId newer = windows.AddWindow(TopLevelWindow("Twin"));
+    CHECK(index.FindByTitle("Twin") == newer);
+    windows.SetTitle(older, "Twin");
+    CHECK(index.FindByTitle("Twin") == newer);
+    windows.RemoveWindow(newer);
+    CHECK(index.FindByTitle("Twin") == older);
+
+    // A window embedded in a tab, or hidden there, is no longer a top-level candidate until released
+    WindowMatcher matcher;
+    matcher.Add({ "Twin", 0, nullptr });
+    matcher.Build();
+    std::vector<WindowId> resolved;
+    CHECK(windows.EmbedWindow(older, live[0]));
+    CHECK(index.FindByTitle("Twin") == 0);
+    index.Resolve(matcher, resolved);
+    CHECK(resolved[0] == 0);
+    windows.SetWindowVisible(older, false);
+    windows.SetWindowVisible(older, true);
+    CHECK(index.FindByTitle("Twin") == 0);
+    windows.ReleaseWindow(older);
+    CHECK(index.FindByTitle("Twin") == older);
+    index.Resolve(matcher, resolved);
+    CHECK(resolved[0] == older);
+    windows.RemoveWindow(older);
+
+    // Lookup cost against the scan, for the record
+    for (int count : { 10, 100, 1000 }) {
+        FakeWindowSystem sized;
+        for (int i = 0; i < count; i++) {
+            sized.AddWindow(TopLevelWindow("Window " + std::to_string(i)));
+        }
+        WindowIndex sizedIndex(sized);
+        const int LOOKUPS = 1000;
+        Clock::time_point start = Clock::now();
+        for (int i = 0; i < LOOKUPS; i++) {
+            CHECK(ScanForTitle(sized, "Missing") == 0);
+        }
+        double scanUs = MsSince(start) * 1000.0 / LOOKUPS;
+        start = Clock::now();
+        for (int i = 0; i < LOOKUPS; i++) {
+            CHECK(sizedIndex.FindByTitle("Missing") == 0);
+        }
+        double indexUs = MsSince(start) * 1000.0 / LOOKUPS;
+        printf("  %4d windows: scan %.2f us, index %.2f us per missed lookup\n", count, scanUs, indexUs);
+    }
+}
+
+template <typename Condition>
+bool WaitUntil(Condition condition, int timeoutMs)
+{
+    Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!condition()) {
+        if (Clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return true;
+}
+
+#ifndef _WIN32
+
+// Neither running nor left as a zombie
+bool ProcessGone(ProcessId pid)
+{
+    struct stat info;
+    return stat(("/proc/" + std::to_string(pid)).c_str(), &info) != 0;
+}
+
+// Real child processes through the platform launcher
+void CheckProcessReaping()
+{
+    std::unique_ptr<ProcessLauncher> launcher = CreatePlatformProcessLauncher();
+
+    // Held: reports its exit, and is reaped
+    std::shared_ptr<LaunchedProcess> held = launcher->Launch("sleep 0.1");
+    CHECK(held != nullptr);
+    if (!held) return;
+    std::atomic<bool> exited(false);
+    held->OnExit([&]() { exited = true; });
+    CHECK(WaitUntil([&]() { return exited.load(); }, 3000));
+    CHECK(held->HasExited());
+    CHECK(WaitUntil([&]() { return ProcessGone(held->Pid()); }, 1000));
+
+    // Dropped while still running, as a timed-out launch does: still reaped once it exits
+    std::shared_ptr<LaunchedProcess> dropped = launcher->Launch("sleep 0.2");
+    CHECK(dropped != nullptr);
+    if (!dropped) return;
+    ProcessId droppedPid = dropped->Pid();
+    dropped.reset();
+    CHECK(WaitUntil([&]() { return ProcessGone(droppedPid); }, 3000));
+}
+
+int NiceOf(ProcessId pid)
+{
+    errno = 0;
+    int nice = getpriority(PRIO_PROCESS, (id_t)pid);
+    return errno == 0 ? nice : -100;
+}
+
+bool SameAffinity(ProcessId pid, const cpu_set_t& expected)
+{
+    cpu_set_t cpus;
+    return sched_getaffinity((pid_t)pid, sizeof(cpus), &cpus) == 0 && CPU_EQUAL(&cpus, &expected);
+}
+
+// The platform governor on a real child: throttling lowers its priority and pins it, restoring puts
+// back exactly what it had, and a tree that has exited restores without touching anything
+void CheckProcessThrottling()
+{
+    std::unique_ptr<ProcessLauncher> launcher = CreatePlatformProcessLauncher();
+    std::unique_ptr<ResourceGovernor> governor = CreatePlatformResourceGovernor();
+    std::shared_ptr<LaunchedProcess> process = launcher->Launch("sleep 30");
+    CHECK(process != nullptr);
+    if (!process) return;
+    ProcessId pid = process->Pid();
+    int originalNice = NiceOf(pid);
+    cpu_set_t originalCpus;
+    CHECK(sched_getaffinity((pid_t)pid, sizeof(originalCpus), &originalCpus) == 0);
+    // Without CAP_SYS_NICE a lowered nice value could never be raised again, so the governor uses
+    // SCHED_BATCH instead
+    bool canRestoreNice = geteuid() == 0;
+    if (!canRestoreNice) printf("  not root: expecting SCHED_BATCH rather than nice\n");
+
+    ThrottlePolicy policy;
+    policy.cpus = { 0 };
+    CHECK(!governor->IsThrottled(*process));
+    governor->Throttle(*process, policy, {});
+    CHECK(governor->IsThrottled(*process));
+    if (canRestoreNice) CHECK(NiceOf(pid) == 10);
+    else CHECK(sched_getscheduler((pid_t)pid) == SCHED_BATCH);
+    cpu_set_t cpuZero;
+    CPU_ZERO(&cpuZero);
+    CPU_SET(0, &cpuZero);
+    CHECK(SameAffinity(pid, cpuZero));
+
+    // Throttling again keeps the first saved settings, so restoring still gets the originals
+    governor->Throttle(*process, policy, {});
+    CHECK(governor->Restore(*process));
+    CHECK(!governor->IsThrottled(*process));
+    CHECK(NiceOf(pid) == originalNice);
+    CHECK(sched_getscheduler((pid_t)pid) == SCHED_OTHER);
+    CHECK(SameAffinity(pid, originalCpus));
+    // Restoring a tree that is not throttled changes nothing
+    CHECK(governor->Restore(*process));
+
+    ThrottlePolicy efficiency;
+    efficiency.efficiencyMode = true;
+    governor->Throttle(*process, efficiency, {});
+    if (canRestoreNice) CHECK(NiceOf(pid) == 19);
+    CHECK(SameAffinity(pid, originalCpus));
+    CHECK(governor->Restore(*process) && NiceOf(pid) == originalNice);
+
+    // A spared process is put back by the next Throttle and then left alone
+    governor->Throttle(*process, policy, {});
+    governor->Throttle(*process, policy, { pid });
+    CHECK(NiceOf(pid) == originalNice);
+    CHECK(sched_getscheduler((pid_t)pid) == SCHED_OTHER);
+    CHECK(SameAffinity(pid, originalCpus));
+    CHECK(governor->Restore(*process));
+
+    // Gone while throttled
+    governor->Throttle(*process, policy, {});
+    // The tree is the child's process group
+    kill(-(pid_t)pid, SIGKILL);
+    CHECK(WaitUntil([&]() { return process->HasExited() && ProcessGone(pid); }, 3000));
+    CHECK(governor->Restore(*process));
+    CHECK(!governor->IsThrottled(*process));
+}
+
+#endif
+
+// Many producers against the dashboard's UI-thread queue: every command runs once, in its producer's
+// order, and nothing is lost when the ring fills up
+void CheckCommandQueue()
+{
+    const int PRODUCERS = 8;
+    const int COMMANDS_PER_PRODUCER = 100000;
+    CommandQueue<std::function<void()>, 1024> queue;
+    std::vector<int> lastSeen(PRODUCERS, -1);
+    int outOfOrder = 0;
+    std::atomic<int> producersDone(0);
+    std::atomic<int> retries(0);
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < PRODUCERS; producer++) {
+        producers.emplace_back([&, producer]() {
+            for (int i = 0; i < COMMANDS_PER_PRODUCER; i++) {
+                std::function<void()> command = [&, producer, i]() {
+                    if (lastSeen[producer] + 1 != i) outOfOrder++;
+                    lastSeen[producer] = i;
+                };
+                while (!queue.TryPush(std::move(command))) {
+                    retries++;
+                    std::this_thread::yield();
+                }
+            }
+            producersDone++;
+        });
+    }
+
+    int executed = 0;
+    std::function<void()> command;
+    for (;;) {
+        bool done = producersDone.load() == PRODUCERS;
+        while (queue.TryPop(command)) {
+            command();
+            executed++;
+        }
+        if (done) break;
+        std::this_thread::yield();
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    CHECK(executed == PRODUCERS * COMMANDS_PER_PRODUCER);
+    CHECK(outOfOrder == 0);
+    for (int producer = 0; producer < PRODUCERS; producer++) {
+        CHECK(lastSeen[producer] == COMMANDS_PER_PRODUCER - 1);
+    }
+    printf("  %d commands from %d threads, %d pushes retried on a full ring\n", executed, PRODUCERS, retries.load());
+
+    // Commands still queued are destroyed with the queue
+    auto owned = std::make_shared<int>(0);
+    {
+        CommandQueue<std::function<void()>, 16> unread;
+        for (int i = 0; i < 10; i++) {
+            CHECK(unread.TryPush([owned]() {}));
+        }
+        CHECK(owned.use_count() == 11);
+    }
+    CHECK(owned.use_count() == 1);
+
+    // A full ring refuses the push and keeps what it has
+    CommandQueue<int, 4> small;
+    for (int i = 0; i < 4; i++) {
+        CHECK(small.TryPush(int(i)));
+    }
+    CHECK(!small.TryPush(4));
+    int value = -1;
+    CHECK(small.TryPop(value) && value == 0);
+    CHECK(small.TryPush(4));
+
+    // The UI thread posting to its own full queue runs everything at once, in order, instead of
+    // waiting for itself
+    const int BURST = 1000;
+    {
+        FakeBackends fakes;
+        std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes);
+        std::vector<int> ran;
+        for (int i = 0; i < BURST; i++) {
+            dashboard->PostToUiThread([&ran, i]() { ran.push_back(i); });
+        }
+        dashboard->RunUiCommands();
+        CHECK((int)ran.size() == BURST);
+        CHECK(std::is_sorted(ran.begin(), ran.end()));
+    }
+
+    // A launch thread stuck on the full queue gives up once the dashboard is being destroyed, rather
+    // than holding up its executor's shutdown forever
+    {
+        FakeBackends fakes;
+        std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes);
+        GamingDashboard* target = dashboard.get();
+        std::atomic<int> posted(0);
+        std::atomic<bool> returned(false);
+        fakes.launcher->SetLaunchHandler([&, target](ProcessId, const std::string&) {
+            for (int i = 0; i < BURST; i++) {
+                target->PostToUiThread([]() {});
+                posted++;
+            }
+            returned = true;
+        });
+        AppDesc desc;
+        desc.name = "Flood";
+        desc.commandLine = "flood.exe";
+        desc.windowTitle = "Flood";
+        desc.custom = true;
+        dashboard->LaunchApp(dashboard->AddCustomApp(desc));
+        CHECK(WaitUntil([&]() { return posted.load() >= 200; }, 5000));
+        dashboard.reset();
+        CHECK(returned.load());
+        CHECK(posted.load() == BURST);
+    }
+}
+
+// The telemetry and profiler rings: one producer and one consumer, values in order, none lost or repeated
+void CheckSpscRing()
+{
+    const uint64_t VALUES = 2000000;
+    SpscRing<uint64_t, 256> ring;
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < VALUES; i++) {
+            while (!ring.TryPush(i)) std::this_thread::yield();
+        }
+    });
+    uint64_t expected = 0;
+    int wrong = 0;
+    while (expected < VALUES) {
+        uint64_t value;
+        if (!ring.TryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (value != expected) wrong++;
+        expected++;
+    }
+    producer.join();
+    CHECK(wrong == 0);
+    uint64_t extra;
+    CHECK(!ring.TryPop(extra));
+}
+
+// Outcome of one coroutine: 0 while it runs, then 1 if its wait completed, 2 if it came back empty
+enum TaskOutcome { RUNNING, COMPLETED, EMPTY };
+
+Task DelayTask(Executor& executor, int delayMs, CancellationToken token, std::atomic<int>& outcome)
+{
+    bool elapsed = co_await Delay(executor, delayMs, token);
+    outcome = elapsed ? COMPLETED : EMPTY;
+}
+
+Task WindowTask(Executor& executor, WindowIndex& index, std::string title, CancellationToken token,
+    std::atomic<WindowId>& found, std::atomic<int>& outcome)
+{
+    WindowId window = co_await WaitForWindowAsync(executor, index, MatchWindowTitle(title), 5000, token);
+    found = window;
+    outcome = window ? COMPLETED : EMPTY;
+}
+
+// Launch coroutines parked on timers and window waits while other threads cancel them, complete them
+// and shut the executor down
+void CheckCoroutines()
+{
+    const int TASKS = 400;
+
+    // Delays cancelled while their timers fire: each task ends exactly once, and cancelled before
+    // it started means it never completes
+    {
+        Executor executor(4);
+        std::vector<CancellationSource> sources(TASKS);
+        std::vector<std::atomic<int>> outcomes(TASKS);
+        for (int i = 0; i < TASKS; i++) {
+            if (i % 4 == 0) sources[i].Cancel();
+            Spawn(executor, DelayTask(executor, 1 + i % 20, sources[i].Token(), outcomes[i]));
+        }
+        std::thread canceller([&]() {
+            for (int i = 1; i < TASKS; i += 2) {
+                sources[i].Cancel();
+                if (i % 16 == 1) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        canceller.join();
+        executor.Shutdown();
+        for (int i = 0; i < TASKS; i++) {
+            CHECK(outcomes[i] != RUNNING);
+            if (i % 4 == 0) CHECK(outcomes[i] == EMPTY);
+            if (i % 2 == 0 && i % 4 != 0) CHECK(outcomes[i] == COMPLETED);
+        }
+    }
+
+    // Window waits racing window creation and cancellation
+    {
+        FakeWindowSystem windows;
+        WindowIndex index(windows);
+        Executor executor(4);
+        std::vector<CancellationSource> sources(TASKS);
+        std::vector<std::atomic<int>> outcomes(TASKS);
+        std::vector<std::atomic<WindowId>> found(TASKS);
+        std::vector<WindowId> created(TASKS, 0);
+        for (int i = 0; i < TASKS; i++) {
+            Spawn(executor, WindowTask(executor, index, "Async " + std::to_string(i) + ".", sources[i].Token(), found[i], outcomes[i]));
+        }
+        std::thread creator([&]() {
+            for (int i = 0; i < TASKS; i++) {
+                created[i] = windows.AddWindow(TopLevelWindow("Async " + std::to_string(i) + "."));
+            }
+        });
+        std::thread canceller([&]() {
+            for (int i = 0; i < TASKS; i += 3) {
+                sources[i].Cancel();
+            }
+        });
+        creator.join();
+        canceller.join();
+        Clock::time_point start = Clock::now();
+        executor.Shutdown();
+        // Nothing was left waiting out its 5 s timeout
+        CHECK(MsSince(start) < 2000.0);
+        for (int i = 0; i < TASKS; i++) {
+            CHECK(outcomes[i] != RUNNING);
+            // A cancelled wait may still have seen its window first; an uncancelled one always does
+            CHECK(found[i] == 0 || found[i] == created[i]);
+            if (i % 3 != 0) CHECK(found[i] == created[i]);
+        }
+    }
+
+    // Shutdown with everything parked on long delays: cancel, and it returns promptly
+    {
+        Executor executor(2);
+        CancellationSource source;
+        std::vector<std::atomic<int>> outcomes(TASKS);
+        for (int i = 0; i < TASKS; i++) {
+            Spawn(executor, DelayTask(executor, 60000, source.Token(), outcomes[i]));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        Clock::time_point start = Clock::now();
+        source.Cancel();
+        executor.Shutdown();
+        CHECK(MsSince(start) < 1000.0);
+        for (int i = 0; i < TASKS; i++) {
+            CHECK(outcomes[i] == EMPTY);
+        }
+    }
+}
+
+bool WriteFile(const std::string& path, const std::string& bytes)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool written = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    return fclose(file) == 0 && written;
+}
+
+bool SamePixels(const ImageView& a, const ImageView& b)
+{
+    return a.width == b.width && a.height == b.height && memcmp(a.pixels, b.pixels, (size_t)a.width * a.height * 4) == 0;
+}
+
+// The startup decode: every icon on the executor's workers, results in request order, and the same
+// pixels as decoding them one by one
+void CheckDecodePool()
+{
+    const std::string corruptPath = "headless_checks_corrupt.png";
+    CHECK(WriteFile(corruptPath, std::string("\x89PNG\r\n\x1a\n", 8) + "not really a png"));
+
+    std::vector<std::string> paths;
+    for (int i = 0; i < 200; i++) {
+        paths.push_back(ICON_PATHS[i % ICON_PATH_COUNT]);
+        if (i == 50) paths.push_back("icons/missing.png");
+        if (i == 120) paths.push_back(corruptPath);
+    }
+
+    Clock::time_point start = Clock::now();
+    std::vector<DecodedImage> expected;
+    for (const std::string& path : paths) {
+        expected.push_back(DecodeImage(path));
+    }
+    double sequentialMs = MsSince(start);
+
+    Executor executor(4);
+    start = Clock::now();
+    std::vector<DecodedImage> decoded = DecodeImages(executor, paths);
+    double parallelMs = MsSince(start);
+    executor.Shutdown();
+
+    CHECK(decoded.size() == paths.size());
+    int valid = 0;
+    for (size_t i = 0; i < paths.size() && i < decoded.size(); i++) {
+        CHECK(decoded[i].IsValid() == expected[i].IsValid());
+        if (!decoded[i].IsValid() || !expected[i].IsValid()) continue;
+        CHECK(SamePixels(decoded[i].View(), expected[i].View()));
+        valid++;
+    }
+    CHECK(valid == 200);
+    CHECK(!decoded[51].IsValid());
+    CHECK(!decoded[122].IsValid());
+    printf("  %d icons: %.1f ms one by one, %.1f ms on 4 workers\n", (int)paths.size(), sequentialMs, parallelMs);
+
+    // Nothing to decode
+    Executor idle(2);
+    CHECK(DecodeImages(idle, {}).empty());
+    idle.Shutdown();
+    remove(corruptPath.c_str());
+}
+
+std::string ReadFile(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Pixels unique to one icon, so a misplaced or overwritten icon shows up
+std::vector<unsigned char> IconPattern(int icon, int width, int height)
+{
+    std::vector<unsigned char> pixels((size_t)width * height * 4);
+    for (size_t i = 0; i < pixels.size(); i++) {
+        pixels[i] = (unsigned char)(icon * 37 + i * 11 + (i >> 9));
+    }
+    return pixels;
+}
+
+// Every live icon's pixels are where its UVs point, and its padded rectangle is inside the atlas and
+// clear of every other icon's
+void CheckAtlasContents(const IconAtlas& atlas, std::vector<IconTexture>& icons,
+    const std::vector<std::vector<unsigned char>>& patterns)
+{
+    ImTextureData* texture = atlas.TexRef()._TexData;
+    CHECK(texture != nullptr);
+    if (!texture) return;
+    struct Rect {
+        int x0, y0, x1, y1;
+    };
+    std::vector<Rect> rects;
+    for (size_t i = 0; i < icons.size(); i++) {
+        IconTexture& icon = icons[i];
+        if (!icon.IsValid()) continue;
+        atlas.Resolve(icon);
+        int x = (int)(icon.uv0.x * atlas.Width() + 0.5f);
+        int y = (int)(icon.uv0.y * atlas.Height() + 0.5f);
+        Rect rect = { x - IconAtlas::PADDING, y - IconAtlas::PADDING, x + icon.width + IconAtlas::PADDING,
+            y + icon.height + IconAtlas::PADDING };
+        CHECK(rect.x0 >= 0 && rect.y0 >= 0 && rect.x1 <= atlas.Width() && rect.y1 <= atlas.Height());
+        if (rect.x0 < 0 || rect.y0 < 0 || rect.x1 > atlas.Width() || rect.y1 > atlas.Height()) continue;
+        for (int row = 0; row < icon.height; row++) {
+            CHECK(memcmp(texture->GetPixelsAt(x, y + row), patterns[i].data() + (size_t)row * icon.width * 4,
+                (size_t)icon.width * 4) == 0);
+        }
+        rects.push_back(rect);
+    }
+    int overlaps = 0;
+    for (size_t a = 0; a < rects.size(); a++) {
+        for (size_t b = a + 1; b < rects.size(); b++) {
+            if (rects[a].x0 < rects[b].x1 && rects[b].x0 < rects[a].x1 && rects[a].y0 < rects[b].y1 && rects[b].y0 < rects[a].y1) overlaps++;
+        }
+    }
+    CHECK(overlaps == 0);
+}
+
+// ImDrawCmds that draw something in the sidebar's draw lists, its own and its app list child's. Icons
+// come from the atlas; everything else from the font texture.
+struct SidebarCommands {
+    int commands = 0;
+    int iconCommands = 0;
+    int appListCommands = 0;
+    int appListIconCommands = 0;
+};
+
+SidebarCommands CountSidebarCommands()
+{
+    SidebarCommands counts;
+    ImTextureData* font = ImGui::GetIO().Fonts->TexRef._TexData;
+    for (ImGuiWindow* window : ImGui::GetCurrentContext()->Windows) {
+        if (strncmp(window->Name, "##Sidebar", 9) != 0 || !window->Active) continue;
+        bool appList = strstr(window->Name, "##AppList") != nullptr;
+        for (const ImDrawCmd& command : window->DrawList->CmdBuffer) {
+            if (command.ElemCount == 0) continue;
+            bool icon = command.TexRef._TexData != font;
+            counts.commands++;
+            counts.iconCommands += icon;
+            counts.appListCommands += appList;
+            counts.appListIconCommands += appList && icon;
+        }
+    }
+    return counts;
+}
+
+// The frame's draw calls for a dashboard with this many custom apps, each with an icon, and the
+// sidebar's share of them
+int SidebarDrawCalls(int appCount, SidebarCommands& sidebar)
+{
+    FakeBackends fakes;
+    std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes);
+    NullRenderer renderer;
+    renderer.Init();
+    for (int i = 0; i < appCount; i++) {
+        AppDesc desc;
+        desc.name = "Atlas App " + std::to_string(i);
+        desc.commandLine = "atlas_app.exe";
+        desc.iconPath = ICON_PATHS[i % ICON_PATH_COUNT];
+        desc.windowTitle = "[atlas " + std::to_string(i) + "]";
+        desc.custom = true;
+        dashboard->AddCustomApp(desc);
+    }
+    for (int frame = 0; frame < 5; frame++) {
+        RunFrame(*dashboard, renderer);
+    }
+    sidebar = CountSidebarCommands();
+    return renderer.LastFrame().drawCalls;
+}
+
+// All icons in one texture: packed without overlap, grown and repacked without losing any, and drawn
+// with the same number of draw calls however many apps there are
+void CheckIconAtlas()
+{
+    IconAtlas atlas;
+    std::mt19937 random(8);
+    std::vector<IconTexture> icons;
+    std::vector<std::vector<unsigned char>> patterns;
+    for (int i = 0; i < 300; i++) {
+        int width = 4 + random() % 45;
+        int height = 4 + random() % 45;
+        patterns.push_back(IconPattern(i, width, height));
+        icons.push_back(atlas.Add({ patterns.back().data(), width, height }));
+        CHECK(icons.back().IsValid());
+    }
+    CHECK(atlas.IconCount() == 300);
+    CHECK(atlas.Width() > IconAtlas::INITIAL_SIZE || atlas.Height() > IconAtlas::INITIAL_SIZE);
+    CheckAtlasContents(atlas, icons, patterns);
+    int grownWidth = atlas.Width();
+    int grownHeight = atlas.Height();
+
+    // Removing most icons shrinks the atlas at the next frame; the rest keep their pixels
+    for (int i = 0; i < 300; i++) {
+        if (i % 5 != 0) atlas.Remove(icons[i]);
+        CHECK(icons[i].IsValid() == (i % 5 == 0));
+    }
+    atlas.NewFrame();
+    CHECK(atlas.IconCount() == 60);
+    CHECK(atlas.Width() * atlas.Height() < grownWidth * grownHeight);
+    CheckAtlasContents(atlas, icons, patterns);
+
+    // Freed slots are reused; an empty image is refused
+    CHECK(!atlas.Add({ patterns[0].data(), 0, 16 }).IsValid());
+    for (int i = 1; i < 300; i += 2) {
+        if (icons[i].IsValid()) continue;
+        patterns[i] = IconPattern(1000 + i, 16, 16);
+        icons[i] = atlas.Add({ patterns[i].data(), 16, 16 });
+        CHECK(icons[i].IsValid() && icons[i].atlasId < 300);
+    }
+    CheckAtlasContents(atlas, icons, patterns);
+
+    // Larger than the atlas can ever be
+    std::vector<unsigned char> huge((size_t)IconAtlas::MAX_SIZE * 4 * 4);
+    CHECK(!atlas.Add({ huge.data(), IconAtlas::MAX_SIZE, 4 }).IsValid());
+    CheckAtlasContents(atlas, icons, patterns);
+
+    // Every app icon in one command, the footer's icons in one more; neither grows with the apps
+    SidebarCommands fewSidebar, manySidebar;
+    int few = SidebarDrawCalls(10, fewSidebar);
+    int many = SidebarDrawCalls(300, manySidebar);
+    CHECK(few == many);
+    for (const SidebarCommands& sidebar : { fewSidebar, manySidebar }) {
+        CHECK(sidebar.appListIconCommands == 1);
+        CHECK(sidebar.iconCommands == 2);
+    }
+    CHECK(fewSidebar.commands == manySidebar.commands && fewSidebar.appListCommands == manySidebar.appListCommands);
+    printf("  draw calls per frame: %d with 10 apps, %d with 300; sidebar %d (app list %d, its icons 1)\n", few, many,
+        manySidebar.commands, manySidebar.appListCommands);
+}
+
+const int CLIPPER_APP_COUNT = 10000;
+// GamingDashboard's fixed sidebar row height
+const float SIDEBAR_ROW_HEIGHT = 40.0f;
+
+struct SidebarFrame {
+    int vertices = 0;
+    int drawCalls = 0;
+    double renderMs = 0.0;
+};
+
+ImGuiWindow* FindAppList()
+{
+    for (ImGuiWindow* window : ImGui::GetCurrentContext()->Windows) {
+        if (strstr(window->Name, "##AppList")) return window;
+    }
+    return nullptr;
+}
+
+// Steady-state cost of the sidebar with appCount custom apps, scrolled to the top or the bottom
+SidebarFrame MeasureSidebar(int appCount, bool scrollToEnd)
+{
+    // Loaded from settings as at startup; adding them one by one decodes and saves per app
+    DashboardSettings settings;
+    for (int i = 0; i < appCount; i++) {
+        CustomAppSettings app;
+        app.name = "Clip App " + std::to_string(i);
+        app.exePath = "clip_app_" + std::to_string(i) + ".exe";
+        app.iconPath = ICON_PATHS[i % ICON_PATH_COUNT];
+        app.windowTitle = "[clip " + std::to_string(i) + "]";
+        settings.customApps.push_back(app);
+    }
+    FakeBackends fakes;
+    std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes, &settings);
+    NullRenderer renderer;
+    renderer.Init();
+    for (int frame = 0; frame < 3; frame++) {
+        RunFrame(*dashboard, renderer);
+    }
+    ImGuiWindow* list = FindAppList();
+    CHECK(list != nullptr);
+    if (!list) return SidebarFrame();
+    // The clipper still sizes the list for every row, so the scrollbar covers all of them
+    float rowPitch = SIDEBAR_ROW_HEIGHT + ImGui::GetStyle().ItemSpacing.y;
+    float expected = (appCount + 3) * rowPitch;
+    CHECK(list->ContentSize.y > expected - 2 * rowPitch && list->ContentSize.y < expected + rowPitch);
+    if (scrollToEnd) {
+        ImGui::SetScrollY(list, list->ScrollMax.y);
+        for (int frame = 0; frame < 3; frame++) {
+            RunFrame(*dashboard, renderer);
+        }
+        CHECK(list->Scroll.y > 0.0f && list->Scroll.y == list->ScrollMax.y);
+    }
+
+    SidebarFrame measured;
+    const int frames = 20;
+    Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        RunFrame(*dashboard, renderer);
+        measured.vertices = std::max(measured.vertices, renderer.LastFrame().vertices);
+        measured.drawCalls = std::max(measured.drawCalls, renderer.LastFrame().drawCalls);
+    }
+    measured.renderMs = MsSince(start) / frames;
+
+    if (scrollToEnd && appCount > 0) {
+        // The bottom row on screen is the last app: clicking it launches that app
+        std::mutex mutex;
+        std::string launched;
+        fakes.launcher->SetLaunchHandler([&](ProcessId, const std::string& commandLine) {
+            std::lock_guard<std::mutex> lock(mutex);
+            launched = commandLine;
+        });
+        ImVec2 target((list->InnerRect.Min.x + list->InnerRect.Max.x) / 2, list->InnerRect.Max.y - rowPitch / 2);
+        ImGuiIO& io = ImGui::GetIO();
+        io.AddMousePosEvent(target.x, target.y);
+        RunFrame(*dashboard, renderer);
+        io.AddMouseButtonEvent(0, true);
+        RunFrame(*dashboard, renderer);
+        io.AddMouseButtonEvent(0, false);
+        std::string expectedLaunch = "clip_app_" + std::to_string(appCount - 1) + ".exe";
+        Clock::time_point deadline = Clock::now() + std::chrono::seconds(2);
+        bool done = false;
+        while (!done && Clock::now() < deadline) {
+            RunFrame(*dashboard, renderer);
+            std::lock_guard<std::mutex> lock(mutex);
+            done = !launched.empty();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (launched != expectedLaunch) fprintf(stderr, "  clicked the last row, launched '%s'\n", launched.c_str());
+        CHECK(launched == expectedLaunch);
+        io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+        fakes.launcher->SetLaunchHandler(nullptr);
+    }
+    return measured;
+}
+
+// The sidebar with 10k apps: only the visible rows are submitted, so vertices and draw calls match a
+// short list and the frame stays cheap, at the top of the list and scrolled to its end
+void CheckSidebarClipper()
+{
+    SidebarFrame few = MeasureSidebar(10, false);
+    SidebarFrame top = MeasureSidebar(CLIPPER_APP_COUNT, false);
+    SidebarFrame end = MeasureSidebar(CLIPPER_APP_COUNT, true);
+    printf("  10 apps: %d vertices, %d draw calls, %.2f ms\n", few.vertices, few.drawCalls, few.renderMs);
+    printf("  %d apps: %d vertices, %d draw calls, %.2f ms at the top; %d vertices, %.2f ms at the end\n",
+        CLIPPER_APP_COUNT, top.vertices, top.drawCalls, top.renderMs, end.vertices, end.renderMs);
+    CHECK(top.drawCalls == few.drawCalls && end.drawCalls == few.drawCalls);
+    // The visible rows are the same count whatever the list length; allow for label length and the scrollbar
+    CHECK(top.vertices < few.vertices * 2);
+    CHECK(end.vertices < few.vertices * 2);
+    // Submitting every row took tens of milliseconds a frame at this size
+    CHECK(top.renderMs < few.renderMs * 5 + 2.0);
+    CHECK(end.renderMs < few.renderMs * 5 + 2.0);
+}
+
+// IconCache's file layout, for building damaged files: a 32-byte header (magic, version, record count,
+// file size, index checksum) and 48-byte records, pixel offset last
+const size_t CACHE_HEADER_BYTES = 32;
+const size_t CACHE_VERSION_OFFSET = 8;
+const size_t CACHE_CHECKSUM_OFFSET = 24;
+const size_t CACHE_RECORD_BYTES = 48;
+const size_t CACHE_RECORD_PIXEL_OFFSET = 40;
+
+// The index checksum of IconCache.cpp, so a damaged record can still pass it
+uint64_t CacheChecksum(const std::string& bytes, size_t begin, size_t end)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = begin; i < end; i++) {
+        hash ^= (unsigned char)bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// A damaged cache file opens as an empty cache: no entries, every lookup misses
+void CheckRejected(const char* what, const std::string& cachePath, const std::string& bytes,
+    const std::vector<std::string>& sources)
+{
+    if (!WriteFile(cachePath, bytes)) {
+        CHECK(!"could not write the damaged cache");
+        return;
+    }
+    IconCache cache(cachePath);
+    bool opened = cache.Open();
+    if (opened) fprintf(stderr, "  damaged cache accepted: %s\n", what);
+    CHECK(!opened);
+    CHECK(!cache.IsOpen() && cache.EntryCount() == 0);
+    for (const std::string& source : sources) {
+        CHECK(!cache.Lookup(source, 0).IsValid());
+    }
+}
+
+// The decoded-icon cache: round trip, invalidation when a source changes, and every kind of damaged
+// file behaving like an empty cache
+void CheckIconCache()
+{
+    namespace fs = std::filesystem;
+    const std::string cachePath = "headless_checks_cache.bin";
+    std::vector<std::string> sources;
+    std::vector<std::vector<unsigned char>> patterns;
+    std::vector<IconCacheEntry> entries;
+    for (int i = 0; i < 3; i++) {
+        sources.push_back("headless_checks_icon_" + std::to_string(i) + ".png");
+        fs::copy_file(ICON_PATHS[i], sources.back(), fs::copy_options::overwrite_existing);
+        patterns.push_back(IconPattern(i, 20 + i, 24));
+    }
+    for (int i = 0; i < 3; i++) {
+        entries.push_back({ sources[i], 0, { patterns[i].data(), 20 + i, 24 } });
+        entries.push_back({ sources[i], 32, { patterns[(i + 1) % 3].data(), 20 + (i + 1) % 3, 24 } });
+    }
+    // Duplicates and empty images are skipped, as are sources that do not exist
+    entries.push_back({ sources[0], 0, { patterns[2].data(), 22, 24 } });
+    entries.push_back({ sources[1], 64, ImageView() });
+    entries.push_back({ "headless_checks_missing.png", 0, { patterns[0].data(), 20, 24 } });
+
+    IconCache cache(cachePath);
+    CHECK(!cache.Open());
+    CHECK(cache.Write(entries));
+    CHECK(cache.Open());
+    CHECK(cache.EntryCount() == 6);
+    for (int i = 0; i < 3; i++) {
+        CHECK(SamePixels(cache.Lookup(sources[i], 0), { patterns[i].data(), 20 + i, 24 }));
+        CHECK(SamePixels(cache.Lookup(sources[i], 32), { patterns[(i + 1) % 3].data(), 20 + (i + 1) % 3, 24 }));
+        CHECK(!cache.Lookup(sources[i], 64).IsValid());
+        CHECK((reinterpret_cast<uintptr_t>(cache.Lookup(sources[i], 0).pixels) & 15) == 0);
+    }
+    CHECK(!cache.Lookup("headless_checks_missing.png", 0).IsValid());
+
+    // Rewriting from views into the open mapping
+    std::vector<IconCacheEntry> rewrite;
+    for (int i = 0; i < 3; i++) {
+        rewrite.push_back({ sources[i], 0, cache.Lookup(sources[i], 0) });
+    }
+    CHECK(cache.Write(rewrite));
+    CHECK(!cache.IsOpen());
+    CHECK(cache.Open() && cache.EntryCount() == 3);
+    for (int i = 0; i < 3; i++) {
+        CHECK(SamePixels(cache.Lookup(sources[i], 0), { patterns[i].data(), 20 + i, 24 }));
+    }
+
+    // A source that changed or went away misses; the others still hit
+    fs::last_write_time(sources[0], fs::last_write_time(sources[0]) + std::chrono::seconds(10));
+    CHECK(!cache.Lookup(sources[0], 0).IsValid());
+    {
+        std::ofstream grow(sources[1], std::ios::binary | std::ios::app);
+        grow.put(0);
+    }
+    CHECK(!cache.Lookup(sources[1], 0).IsValid());
+    CHECK(cache.Lookup(sources[2], 0).IsValid());
+    fs::remove(sources[2]);
+    CHECK(!cache.Lookup(sources[2], 0).IsValid());
+    cache.Close();
+
+    // Damaged files
+    for (int i = 0; i < 3; i++) {
+        fs::copy_file(ICON_PATHS[i], sources[i], fs::copy_options::overwrite_existing);
+    }
+    CHECK(cache.Write(entries));
+    const std::string good = ReadFile(cachePath);
+    CHECK(good.size() > CACHE_HEADER_BYTES + 6 * CACHE_RECORD_BYTES);
+    if (good.size() <= CACHE_HEADER_BYTES + 6 * CACHE_RECORD_BYTES) return;
+    size_t indexEnd = good.rfind(sources[2]) + sources[2].size();
+    auto withChecksum = [&](std::string bytes) {
+        uint64_t checksum = CacheChecksum(bytes, CACHE_HEADER_BYTES, indexEnd);
+        memcpy(&bytes[CACHE_CHECKSUM_OFFSET], &checksum, sizeof(checksum));
+        return bytes;
+    };
+    CHECK(withChecksum(good) == good);
+
+    CheckRejected("empty", cachePath, "", sources);
+    CheckRejected("shorter than the header", cachePath, good.substr(0, CACHE_HEADER_BYTES - 1), sources);
+    CheckRejected("header only", cachePath, good.substr(0, CACHE_HEADER_BYTES), sources);
+    CheckRejected("truncated by a byte", cachePath, good.substr(0, good.size() - 1), sources);
+    CheckRejected("truncated in the index", cachePath, good.substr(0, CACHE_HEADER_BYTES + 100), sources);
+    CheckRejected("appended to", cachePath, good + "x", sources);
+    std::string bytes = good;
+    bytes[0] = 'X';
+    CheckRejected("wrong magic", cachePath, bytes, sources);
+    bytes = good;
+    bytes[CACHE_VERSION_OFFSET]++;
+    CheckRejected("newer version", cachePath, bytes, sources);
+    bytes = good;
+    bytes[CACHE_HEADER_BYTES + 3] ^= 0x10;
+    CheckRejected("record byte flipped", cachePath, bytes, sources);
+    bytes = good;
+    bytes[indexEnd - 1] ^= 0x01;
+    CheckRejected("path byte flipped", cachePath, bytes, sources);
+    bytes = good;
+    uint64_t farAway = good.size() + 4096;
+    memcpy(&bytes[CACHE_HEADER_BYTES + CACHE_RECORD_PIXEL_OFFSET], &farAway, sizeof(farAway));
+    CheckRejected("pixels past the end, checksum fixed up", cachePath, withChecksum(bytes), sources);
+    bytes = good;
+    uint64_t misaligned = 0;
+    memcpy(&misaligned, &bytes[CACHE_HEADER_BYTES + CACHE_RECORD_PIXEL_OFFSET], sizeof(misaligned));
+    misaligned += 4;
+    memcpy(&bytes[CACHE_HEADER_BYTES + CACHE_RECORD_PIXEL_OFFSET], &misaligned, sizeof(misaligned));
+    CheckRejected("misaligned pixels, checksum fixed up", cachePath, withChecksum(bytes), sources);
+    bytes = good;
+    uint32_t recordCount = 1000000;
+    memcpy(&bytes[CACHE_VERSION_OFFSET + 4], &recordCount, sizeof(recordCount));
+    CheckRejected("record count past the end", cachePath, bytes, sources);
+
+    // Random damage anywhere in the index: never a crash, and never a hit with the wrong pixels
+    std::mt19937 random(9);
+    for (int i = 0; i < 500; i++) {
+        bytes = good;
+        size_t at = random() % indexEnd;
+        bytes[at] = (char)(bytes[at] ^ (1 + random() % 255));
+        WriteFile(cachePath, bytes);
+        IconCache damaged(cachePath);
+        if (!damaged.Open()) continue;
+        ImageView view = damaged.Lookup(sources[0], 0);
+        CHECK(!view.IsValid() || SamePixels(view, { patterns[0].data(), 20, 24 }));
+    }
+
+    remove(cachePath.c_str());
+    for (const std::string& source : sources) {
+        remove(source.c_str());
+    }
+}
+
+bool SameImage(const ResampledImage& a, const ResampledImage& b)
+{
+    return a.width == b.width && a.height == b.height && a.pixels == b.pixels;
+}
+
+// Every SIMD backend the CPU has gives byte-identical output to the scalar reference, including odd
+// widths that leave SIMD tails, upscales, and transparent pixels
+void CheckResampleBackends()
+{
+    std::vector<ResampleBackend> backends;
+    ResampleBackend best = BestResampleBackend();
+    if (best == ResampleBackend::SSE2 || best == ResampleBackend::AVX2) backends.push_back(ResampleBackend::SSE2);
+    if (best == ResampleBackend::AVX2) backends.push_back(ResampleBackend::AVX2);
+    printf("  comparing against scalar:");
+    for (ResampleBackend backend : backends) printf(" %s", ResampleBackendName(backend));
+    printf("%s\n", backends.empty() ? " none, this CPU only has scalar" : "");
+    CHECK(ResampleBackendName(ResampleBackend::Auto) == ResampleBackendName(best));
+
+    std::mt19937 random(10);
+    const ResampleFilter filters[] = { ResampleFilter::Box, ResampleFilter::Lanczos3 };
+    int compared = 0;
+    for (int i = 0; i < 60; i++) {
+        int width = 1 + random() % 97;
+        int height = 1 + random() % 97;
+        std::vector<unsigned char> pixels((size_t)width * height * 4);
+        for (unsigned char& byte : pixels) byte = (unsigned char)random();
+        // Some fully transparent and fully opaque pixels, which take their own paths when unpremultiplying
+        for (size_t p = 0; p < pixels.size(); p += 4 * (1 + random() % 5)) {
+            pixels[p + 3] = (random() % 2) ? 0 : 255;
+        }
+        ImageView source = { pixels.data(), width, height };
+        int targetWidth = 1 + random() % 80;
+        int targetHeight = 1 + random() % 80;
+        int maxSize = 1 + random() % 64;
+
+        for (ResampleFilter filter : filters) {
+            ResampledImage reference = Resample(source, targetWidth, targetHeight, filter, ResampleBackend::Scalar);
+            ResampledImage fitted = ResampleToFit(source, maxSize, filter, ResampleBackend::Scalar);
+            CHECK(reference.width == targetWidth && reference.height == targetHeight);
+            CHECK(reference.pixels.size() == (size_t)targetWidth * targetHeight * 4);
+            CHECK(fitted.width <= std::max(maxSize, 1) && fitted.height <= std::max(maxSize, 1));
+            CHECK(fitted.width <= width && fitted.height <= height);
+            CHECK(fitted.width == std::min(maxSize, width) || fitted.height == std::min(maxSize, height));
+            for (ResampleBackend backend : backends) {
+                bool same = SameImage(Resample(source, targetWidth, targetHeight, filter, backend), reference);
+                if (!same) {
+                    fprintf(stderr, "  %s differs from scalar: %dx%d -> %dx%d\n", ResampleBackendName(backend),
+                        width, height, targetWidth, targetHeight);
+                }
+                CHECK(same);
+                CHECK(SameImage(ResampleToFit(source, maxSize, filter, backend), fitted));
+                compared += 2;
+            }
+        }
+
+        std::vector<ResampledImage> chain = BuildMipChain(source, ResampleBackend::Scalar);
+        if (width > 1 || height > 1) {
+            CHECK(!chain.empty() && chain.back().width == 1 && chain.back().height == 1);
+            CHECK(!chain.empty() && chain[0].width == std::max(1, width / 2) && chain[0].height == std::max(1, height / 2));
+        }
+        for (ResampleBackend backend : backends) {
+            std::vector<ResampledImage> simd = BuildMipChain(source, backend);
+            CHECK(simd.size() == chain.size());
+            for (size_t level = 0; level < std::min(simd.size(), chain.size()); level++) {
+                CHECK(SameImage(simd[level], chain[level]));
+            }
+        }
+    }
+    printf("  %d resamples compared\n", compared);
+
+    // A solid colour stays that colour through the box filter, in every backend
+    std::vector<unsigned char> solid(37 * 23 * 4);
+    for (size_t p = 0; p < solid.size(); p += 4) {
+        solid[p] = 200;
+        solid[p + 1] = 100;
+        solid[p + 2] = 50;
+        solid[p + 3] = 255;
+    }
+    backends.push_back(ResampleBackend::Scalar);
+    for (ResampleBackend backend : backends) {
+        ResampledImage small = Resample({ solid.data(), 37, 23 }, 11, 7, ResampleFilter::Box, backend);
+        CHECK(small.IsValid());
+        for (size_t p = 0; p < small.pixels.size(); p += 4) {
+            CHECK(memcmp(&small.pixels[p], solid.data(), 4) == 0);
+        }
+    }
+
+    // Empty sources and sizes produce nothing rather than a crash
+    CHECK(!Resample(ImageView(), 10, 10, ResampleFilter::Box).IsValid());
+    CHECK(!Resample({ solid.data(), 37, 23 }, 0, 10, ResampleFilter::Lanczos3).IsValid());
+    CHECK(!ResampleToFit({ solid.data(), 37, 23 }, 0, ResampleFilter::Box).IsValid());
+    CHECK(BuildMipChain(ImageView()).empty());
+}
+
+bool SameSettings(const DashboardSettings& a, const DashboardSettings& b)
+{
+    auto sameRule = [](const ReadinessRule& x, const ReadinessRule& y) {
+        return x.minWidth == y.minWidth && x.minHeight == y.minHeight && x.className == y.className &&
+            x.titlePattern == y.titlePattern && x.requiredStyle == y.requiredStyle &&
+            x.excludedStyle == y.excludedStyle && x.stableMs == y.stableMs;
+    };
+    if (a.chromePath != b.chromePath || a.steamPath != b.steamPath || a.discordPath != b.discordPath) return false;
+    if (a.customApps.size() != b.customApps.size() || a.launchProfiles.size() != b.launchProfiles.size()) return false;
+    if (a.launchCosts.size() != b.launchCosts.size() || a.launchLatencies.size() != b.launchLatencies.size()) return false;
+    if (a.sessionTabs.size() != b.sessionTabs.size()) return false;
+    for (size_t i = 0; i < a.customApps.size(); i++) {
+        const CustomAppSettings& x = a.customApps[i];
+        const CustomAppSettings& y = b.customApps[i];
+        if (x.name != y.name || x.exePath != y.exePath || x.iconPath != y.iconPath || x.windowTitle != y.windowTitle) return false;
+        if (!sameRule(x.readiness, y.readiness) || x.throttleWhenHidden != y.throttleWhenHidden) return false;
+    }
+    for (size_t i = 0; i < a.launchProfiles.size(); i++) {
+        const LaunchProfileSettings& x = a.launchProfiles[i];
+        const LaunchProfileSettings& y = b.launchProfiles[i];
+        if (x.name != y.name || x.apps.size() != y.apps.size()) return false;
+        for (size_t m = 0; m < x.apps.size(); m++) {
+            if (x.apps[m].name != y.apps[m].name || x.apps[m].after != y.apps[m].after) return false;
+        }
+    }
+    for (size_t i = 0; i < a.launchCosts.size(); i++) {
+        const LaunchCostSettings& x = a.launchCosts[i];
+        const LaunchCostSettings& y = b.launchCosts[i];
+        if (x.name != y.name || x.readBytes != y.readBytes || x.startupMs != y.startupMs) return false;
+    }
+    for (size_t i = 0; i < a.launchLatencies.size(); i++) {
+        const LaunchLatencySettings& x = a.launchLatencies[i];
+        const LaunchLatencySettings& y = b.launchLatencies[i];
+        if (x.name != y.name || x.processStart != y.processStart || x.firstWindow != y.firstWindow ||
+            x.windowReady != y.windowReady || x.embedded != y.embedded || x.settle != y.settle) return false;
+    }
+    for (size_t i = 0; i < a.sessionTabs.size(); i++) {
+        if (a.sessionTabs[i].name != b.sessionTabs[i].name || a.sessionTabs[i].pid != b.sessionTabs[i].pid) return false;
+    }
+    return true;
+}
+
+const int SETTINGS_APP_COUNT = 10000;
+
+// The settings file: a 10k-app round trip with every field and awkward characters, files from newer
+// builds refused and never overwritten, unknown keys and sections skipped, and the background writer
+// landing the last save
+void CheckSettings()
+{
+    const std::string path = "headless_checks_settings.txt";
+    remove(path.c_str());
+    FileSettingsStore store(path);
+    DashboardSettings untouched;
+    CHECK(!store.Exists() && !store.Load(untouched));
+
+    DashboardSettings saved;
+    saved.chromePath = "C:\\Program Files\\Chrome\\chrome.exe";
+    saved.steamPath = "/usr/bin/steam";
+    saved.discordPath = "line one\nline two\r=[App]";
+    for (int i = 0; i < SETTINGS_APP_COUNT; i++) {
+        CustomAppSettings app;
+        app.name = "App " + std::to_string(i) + (i % 7 == 0 ? " [App]\n=x\\" : "");
+        app.exePath = "C:\\Games\\app" + std::to_string(i) + ".exe";
+        app.iconPath = i % 3 == 0 ? "" : "icons/app" + std::to_string(i) + ".png";
+        app.windowTitle = "Window " + std::to_string(i);
+        if (i % 5 == 0) {
+            app.readiness.minWidth = 640 + i % 100;
+            app.readiness.minHeight = 480;
+            app.readiness.className = "Class" + std::to_string(i);
+            app.readiness.titlePattern = "*app " + std::to_string(i) + "?*";
+            app.readiness.requiredStyle = WindowStyle::CAPTION;
+            app.readiness.excludedStyle = WindowStyle::POPUP;
+            app.readiness.stableMs = 250;
+        }
+        app.throttleWhenHidden = i % 4 != 0;
+        saved.customApps.push_back(app);
+    }
+    saved.launchProfiles.push_back({ "Evening", { { "Discord", {} }, { "App 1", { "Discord" } }, { "App 2", { "Discord", "App 1" } } } });
+    saved.launchProfiles.push_back({ "Solo", { { "Steam", {} } } });
+    saved.launchCosts.push_back({ "Steam", 123456789012ull, 2500 });
+    saved.launchLatencies.push_back({ "Steam", "1 2 3", "4 5", "6", "7 8 9", "10" });
+    saved.sessionTabs.push_back({ "Discord", 4242 });
+    saved.sessionTabs.push_back({ "App 3", 77 });
+
+    Clock::time_point start = Clock::now();
+    CHECK(store.Save(saved));
+    double saveMs = MsSince(start);
+    CHECK(store.Exists());
+    DashboardSettings loaded;
+    start = Clock::now();
+    CHECK(store.Load(loaded));
+    double loadMs = MsSince(start);
+    printf("  %d apps: save %.1f ms, load %.1f ms, %zu bytes\n", SETTINGS_APP_COUNT, saveMs, loadMs, ReadFile(path).size());
+    CHECK(SameSettings(loaded, saved));
+    DashboardSettings reloaded;
+    CHECK(store.Save(loaded) && store.Load(reloaded) && SameSettings(reloaded, saved));
+
+    // Files from a newer build are refused and leave the settings alone, as are files that are not settings
+    const std::string header = "GamingDashboardSettings ";
+    const char* const refused[] = {
+        "GamingDashboardSettings 3\nChromePath=newer\n\n[App]\nName=Newer\nPath=newer.exe\n",
+        "GamingDashboardSettings 0\nChromePath=zero\n",
+        "GamingDashboardSettings\nChromePath=no version\n",
+        "SomethingElse 2\nChromePath=other\n",
+        "",
+    };
+    for (const char* bytes : refused) {
+        CHECK(WriteFile(path, bytes));
+        DashboardSettings kept = saved;
+        bool accepted = store.Load(kept);
+        if (accepted) fprintf(stderr, "  refused file loaded: %.30s\n", bytes);
+        CHECK(!accepted);
+        CHECK(SameSettings(kept, saved));
+    }
+
+    // A dashboard started on a newer build's file leaves it byte for byte alone, through a launch and
+    // the saves an added app and a tab switch would make
+    const std::string newer = header + std::to_string(FileSettingsStore::VERSION + 1) +
+        "\nChromePath=newer\n\n[App]\nName=Newer\nPath=newer.exe\n\n[Future]\nKey=value\n";
+    CHECK(WriteFile(path, newer));
+    {
+        FakeBackends fakes;
+        std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes, nullptr, std::make_unique<FileSettingsStore>(path));
+        NullRenderer renderer;
+        renderer.Init();
+        FakeWindowSystem* windows = fakes.windows;
+        std::atomic<WindowId> launched(0);
+        fakes.launcher->SetLaunchHandler([windows, &launched](ProcessId pid, const std::string&) {
+            WindowInfo window = TopLevelWindow("Kept window [kept]");
+            window.pid = pid;
+            launched = windows->AddWindow(window);
+        });
+        AppDesc desc;
+        desc.name = "Kept";
+        desc.commandLine = "kept.exe";
+        desc.windowTitle = "[kept]";
+        desc.custom = true;
+        AppHandle app = dashboard->AddCustomApp(desc);
+        dashboard->LaunchApp(app);
+        CHECK(WaitUntil([&]() {
+            RunFrame(*dashboard, renderer);
+            WindowInfo info;
+            return launched != 0 && windows->QueryWindow(launched, info) && info.parent != 0;
+        }, 5000));
+        renderer.Shutdown();
+    }
+    CHECK(ReadFile(path) == newer);
+
+    // Unknown keys are skipped; an unknown section's keys do not land in the section before it
+    CHECK(WriteFile(path, header + std::to_string(FileSettingsStore::VERSION) + "\r\n"
+        "SteamPath=steam\r\nFutureKey=1\r\n# a comment\r\nnot a key\r\n"
+        "\n[App]\nName=Kept\nPath=kept.exe\nFutureKey=2\n"
+        "\n[FutureSection]\nName=Wrong\nPath=wrong.exe\nApp=Wrong\n"
+        "\n[App]\nName=No path\n"
+        "\n[Session]\nApp=Kept\nPid=12\nApp=No pid\nFuture=3\n"
+        "\n[FutureSection2]\nApp=Wrong\nPid=13\n"));
+    DashboardSettings mixed = saved;
+    CHECK(store.Load(mixed));
+    // Fields missing from the file keep their values
+    CHECK(mixed.chromePath == saved.chromePath && mixed.steamPath == "steam");
+    CHECK(mixed.customApps.size() == 1 && mixed.customApps[0].name == "Kept" && mixed.customApps[0].exePath == "kept.exe");
+    CHECK(mixed.customApps.size() == 1 && mixed.customApps[0].readiness.IsEmpty());
+    CHECK(mixed.sessionTabs.size() == 1 && mixed.sessionTabs[0].name == "Kept" && mixed.sessionTabs[0].pid == 12);
+    CHECK(mixed.launchProfiles.empty() && mixed.launchCosts.empty() && mixed.launchLatencies.empty());
+
+    // Version 1 files, from before profiles, still load
+    CHECK(WriteFile(path, header + "1\nChromePath=old\n\n[App]\nName=Old\nPath=old.exe\nDelay=500\n"));
+    DashboardSettings old;
+    CHECK(store.Load(old) && old.chromePath == "old" && old.customApps.size() == 1 && old.customApps[0].name == "Old");
+
+    // Back-to-back saves collapse, and the last one is what ends up on disk, also without a Flush
+    {
+        SettingsWriter writer(store);
+        for (int i = 0; i < 50; i++) {
+            DashboardSettings snapshot = saved;
+            snapshot.chromePath = "save " + std::to_string(i);
+            writer.Save(std::move(snapshot));
+        }
+        writer.Flush();
+        DashboardSettings flushed;
+        CHECK(store.Load(flushed) && flushed.chromePath == "save 49" && flushed.customApps.size() == saved.customApps.size());
+        DashboardSettings last = saved;
+        last.chromePath = "at exit";
+        writer.Save(std::move(last));
+    }
+    DashboardSettings atExit;
+    CHECK(store.Load(atExit) && atExit.chromePath == "at exit");
+    CHECK(!std::filesystem::exists(path + ".tmp"));
+
+    remove(path.c_str());
+}
+
+// A launch whose process started at startMs after the click, and whose window was ready (or the wait for
+// it ran out) readyMs after that; a negative readyMs leaves both unset, as a cancelled launch does
+LaunchTimes LaunchAt(int startMs, int readyMs, bool timedOut)
+{
+    LaunchTimes times;
+    times.requested = LaunchTimes::Clock::now();
+    times.processStarted = times.requested + std::chrono::milliseconds(startMs);
+    if (readyMs < 0) return times;
+    LaunchTimes::Clock::time_point ready = times.processStarted + std::chrono::milliseconds(readyMs);
+    if (timedOut) {
+        times.windowTimedOut = ready;
+    } else {
+        times.firstWindow = times.windowMatched = times.windowReady = times.embedded = ready;
+    }
+    return times;
+}
+
+void CheckLaunchTimeouts()
+{
+    LaunchLatency latency;
+    const int defaultMs = LaunchLatency::DEFAULT_WINDOW_TIMEOUT_MS;
+    CHECK(latency.Timeouts("slow").windowMs == defaultMs);
+
+    // Each timeout is a ready sample at the deadline, and doubles the next wait up to the limit
+    int expectedMs = defaultMs;
+    for (int i = 0; i < 5; i++) {
+        latency.Record("slow", LaunchAt(100, latency.Timeouts("slow").windowMs, true));
+        expectedMs = std::min(expectedMs * 2, (int)LaunchLatency::MAX_WINDOW_TIMEOUT_MS);
+        CHECK(latency.Timeouts("slow").windowMs == expectedMs);
+    }
+    const LatencyHistogram& ready = latency.Apps().at("slow")[(size_t)LaunchPhase::WindowReady];
+    CHECK(ready.Count() == 5);
+    CHECK(ready.Percentile(0.0) >= (uint32_t)(100 + defaultMs));
+    CHECK(ready.Percentile(1.0) >= (uint32_t)LaunchLatency::MAX_WINDOW_TIMEOUT_MS);
+    CHECK(latency.Apps().at("slow")[(size_t)LaunchPhase::Embedded].Count() == 0);
+
+    // A cancelled launch says nothing; a successful one ends the backoff
+    latency.Record("flaky", LaunchAt(100, defaultMs, true));
+    CHECK(latency.Timeouts("flaky").windowMs == 2 * defaultMs);
+    latency.Record("flaky", LaunchAt(100, -1, false));
+    CHECK(latency.Timeouts("flaky").windowMs == 2 * defaultMs);
+    CHECK(latency.Apps().at("flaky")[(size_t)LaunchPhase::WindowReady].Count() == 1);
+    latency.Record("flaky", LaunchAt(100, 2000, false));
+    CHECK(latency.Timeouts("flaky").windowMs == defaultMs);
+
+    // A window that matched but never went quiet before the deadline is a timeout, not a ready window
+    const LaunchLatency::AppHistograms& unsettled = latency.Apps().at("flaky");
+    uint32_t settleCount = unsettled[(size_t)LaunchPhase::Settle].Count();
+    LaunchTimes restless = LaunchAt(100, defaultMs, true);
+    restless.firstWindow = restless.windowMatched = restless.windowReady = restless.processStarted + std::chrono::milliseconds(500);
+    latency.Record("flaky", restless);
+    CHECK(latency.Timeouts("flaky").windowMs == 2 * defaultMs);
+    CHECK(unsettled[(size_t)LaunchPhase::Settle].Count() == settleCount);
+    CHECK(unsettled[(size_t)LaunchPhase::WindowReady].Count() == 3);
+    CHECK(unsettled[(size_t)LaunchPhase::WindowReady].Percentile(1.0) >= (uint32_t)(100 + defaultMs));
+    latency.Record("flaky", LaunchAt(100, 2000, false));
+
+    // A learned timeout backs off from itself, not from the default
+    for (int i = 0; i < (int)LaunchLatency::MIN_SAMPLES; i++) {
+        latency.Record("fast", LaunchAt(50, 950, false));
+    }
+    int learnedMs = latency.Timeouts("fast").windowMs;
+    CHECK(learnedMs == LaunchLatency::MIN_WINDOW_TIMEOUT_MS);
+    latency.Record("fast", LaunchAt(50, learnedMs, true));
+    CHECK(latency.Timeouts("fast").windowMs >= 2 * learnedMs && latency.Timeouts("fast").windowMs < defaultMs);
+
+    latency.Remove("slow");
+    CHECK(latency.Timeouts("slow").windowMs == defaultMs);
+}
+
+bool TitleMatches(const char* pattern, const char* title)
+{
+    ReadinessRule rule;
+    rule.titlePattern = pattern;
+    WindowInfo info;
+    info.title = title;
+    return ReadinessMatcher(rule).Matches(info);
+}
+
+void CheckReadinessMatcher()
+{
+    struct TitleCase {
+        const char* pattern;
+        const char* title;
+        bool matches;
+    };
+    const TitleCase cases[] = {
+        // No stars: the whole title, case-insensitive
+        { "steam", "Steam", true },
+        { "steam", "Steam - News", false },
+        { "steam", "My Steam", false },
+        { "steam", "", false },
+        // Anchored at one end only
+        { "steam*", "Steam - News", true },
+        { "steam*", "My Steam", false },
+        { "*steam", "My Steam", true },
+        { "*steam", "Steam - News", false },
+        { "*steam*", "My Steam - News", true },
+        { "*steam*", "Stea", false },
+        // Stars alone match anything, the empty title too
+        { "*", "", true },
+        { "**", "Anything", true },
+        // ? is one character, never none
+        { "l?brary", "Library", true },
+        { "l?brary", "Lbrary", false },
+        { "l?brary", "Li_brary", false },
+        { "?", "", false },
+        { "???", "abc", true },
+        { "*?", "", false },
+        { "a*?", "ab", true },
+        // Middle parts go leftmost, in order
+        { "a*b*c", "abc", true },
+        { "a*b*c", "axxbxxc", true },
+        { "a*b*c", "acb", false },
+        { "*b*b*", "abab", true },
+        { "*b*b*", "ab", false },
+        // The first and last parts may not share characters
+        { "ab*ba", "aba", false },
+        { "ab*ba", "abba", true },
+        { "ab*ba", "abxba", true },
+        { "a*a", "a", false },
+        { "a*a", "aa", true },
+        { "*ab*ab", "xab", false },
+        { "*ab*ab", "abab", true },
+        { "trace - l?brary*", "Trace - Library (3 updates)", true },
+        { "trace - l?brary*", "Trace - Loading...", false },
+    };
+    for (const TitleCase& c : cases) {
+        bool matches = TitleMatches(c.pattern, c.title);
+        if (matches != c.matches) printf("  \"%s\" against \"%s\": %s\n", c.pattern, c.title, matches ? "matched" : "did not match");
+        CHECK(matches == c.matches);
+    }
+
+    // The other conditions hold alongside the title
+    ReadinessRule rule;
+    rule.titlePattern = "discord*";
+    rule.minWidth = 301;
+    rule.minHeight = 201;
+    rule.className = "Chrome_WidgetWin_1";
+    rule.excludedStyle = WindowStyle::POPUP;
+    ReadinessMatcher matcher(rule);
+    WindowInfo window;
+    window.title = "Discord";
+    window.className = "Chrome_WidgetWin_1";
+    window.width = 940;
+    window.height = 500;
+    window.style = WindowStyle::CAPTION;
+    CHECK(matcher.Matches(window));
+    WindowInfo splash = window;
+    splash.width = 300;
+    CHECK(!matcher.Matches(splash));
+    splash = window;
+    splash.style = WindowStyle::POPUP;
+    CHECK(!matcher.Matches(splash));
+    splash = window;
+    splash.className = "Chrome_WidgetWin_0";
+    CHECK(!matcher.Matches(splash));
+    splash = window;
+    splash.title = "Discord Updater";
+    CHECK(matcher.Matches(splash));
+    splash.title = "Updater - Discord";
+    CHECK(!matcher.Matches(splash));
+}
+
+// What the settings writer saved last, once it matches condition; the writer runs on its own thread
+template <typename Condition>
+bool WaitForSaved(MemorySettingsStore& store, DashboardSettings& saved, Condition condition)
+{
+    Clock::time_point deadline = Clock::now() + std::chrono::seconds(2);
+    while (Clock::now() < deadline) {
+        saved = DashboardSettings();
+        if (store.Load(saved) && condition(saved)) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return false;
+}
+
+// The window CreateDashboard made for the dashboard itself
+WindowId DashboardWindow(FakeWindowSystem& windows)
+{
+    std::vector<WindowId> existing;
+    windows.EnumerateWindows(existing);
+    for (WindowId window : existing) {
+        WindowInfo info;
+        if (windows.QueryWindow(window, info) && info.title == "Gaming Dashboard") return window;
+    }
+    return 0;
+}
+
+bool HasWindowParent(FakeWindowSystem& windows, WindowId window, WindowId parent, bool visible)
+{
+    WindowInfo info;
+    return windows.QueryWindow(window, info) && info.parent == parent && info.visible == visible;
+}
+
+// Deleting a custom app that has a tab: its window goes back to the desktop visible and unthrottled,
+// the dashboard stops laying it out, and the saved session no longer has it
+void CheckRemoveApp()
+{
+    FakeBackends fakes;
+    std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes);
+    NullRenderer renderer;
+    renderer.Init();
+    WindowId dashboardWindow = DashboardWindow(*fakes.windows);
+    CHECK(dashboardWindow != 0);
+
+    AppHandle apps[3];
+    WindowId windows[3];
+    for (int i = 0; i < 3; i++) {
+        AppDesc desc;
+        desc.name = "Removable " + std::to_string(i);
+        desc.commandLine = "removable_" + std::to_string(i) + ".exe";
+        desc.iconPath = ICON_PATHS[i];
+        desc.windowTitle = "[removable " + std::to_string(i) + "]";
+        desc.custom = true;
+        apps[i] = dashboard->AddCustomApp(desc);
+        WindowInfo window = TopLevelWindow("Removable window [removable " + std::to_string(i) + "]");
+        window.pid = 200 + i;
+        windows[i] = fakes.windows->AddWindow(window);
+    }
+    // Running already, so each is embedded straight away; the first one ends up current
+    dashboard->LaunchApp(apps[1], false);
+    dashboard->LaunchApp(apps[2], false);
+    dashboard->LaunchApp(apps[0]);
+    RunFrame(*dashboard, renderer);
+    CHECK(HasWindowParent(*fakes.windows, windows[0], dashboardWindow, true));
+    CHECK(HasWindowParent(*fakes.windows, windows[1], dashboardWindow, false));
+    CHECK(HasWindowParent(*fakes.windows, windows[2], dashboardWindow, false));
+    CHECK(fakes.governor->ThrottledCount() == 2);
+
+    // A background tab
+    dashboard->RemoveCustomApp(apps[1]);
+    CHECK(HasWindowParent(*fakes.windows, windows[1], 0, true));
+    CHECK(fakes.governor->ThrottledCount() == 1);
+    // The current tab
+    dashboard->RemoveCustomApp(apps[0]);
+    CHECK(HasWindowParent(*fakes.windows, windows[0], 0, true));
+    CHECK(HasWindowParent(*fakes.windows, windows[2], dashboardWindow, false));
+    CHECK(fakes.governor->ThrottledCount() == 1);
+
+    // Only the remaining tab is laid out
+    int placedBefore = fakes.windows->PlacedWindows();
+    dashboard->OnWindowResize();
+    dashboard->ApplyPendingLayout();
+    CHECK(fakes.windows->PlacedWindows() == placedBefore + 1);
+    for (int frame = 0; frame < 3; frame++) {
+        RunFrame(*dashboard, renderer);
+    }
+
+    DashboardSettings saved;
+    bool dropped = WaitForSaved(*fakes.settings, saved, [](const DashboardSettings& s) {
+        return s.customApps.size() == 1 && s.sessionTabs.size() == 1;
+    });
+    CHECK(dropped);
+    CHECK(dropped && saved.customApps[0].name == "Removable 2" && saved.sessionTabs[0].name == "Removable 2");
+
+    // Switching to the remaining tab shows it; the released windows stay where they are
+    dashboard->LaunchApp(apps[2]);
+    RunFrame(*dashboard, renderer);
+    CHECK(HasWindowParent(*fakes.windows, windows[2], dashboardWindow, true));
+    CHECK(HasWindowParent(*fakes.windows, windows[0], 0, true));
+    CHECK(fakes.governor->ThrottledCount() == 0);
+
+    // Handles of removed apps are ignored
+    dashboard->RemoveCustomApp(apps[0]);
+    dashboard->RemoveCustomApp(AppHandle());
+    CHECK(HasWindowParent(*fakes.windows, windows[2], dashboardWindow, true));
+}
+
+bool HasSize(FakeWindowSystem& windows, WindowId window, int width, int height)
+{
+    WindowInfo info;
+    return windows.QueryWindow(window, info) && info.width == width && info.height == height;
+}
+
+const int LAYOUT_SIDEBAR_WIDTH = 200;
+const int LAYOUT_TAB_COUNT = 5;
+
+// A burst of resize messages becomes one PlaceWindows batch with every tab in it, hidden ones included,
+// at the next frame or layout timer tick; frames and ticks without a resize place nothing
+void CheckBatchedLayout()
+{
+    FakeBackends fakes;
+    std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes);
+    NullRenderer renderer;
+    renderer.Init();
+    WindowId dashboardWindow = DashboardWindow(*fakes.windows);
+    CHECK(dashboardWindow != 0);
+
+    // Nothing embedded: a resize has nothing to place
+    fakes.windows->SetSize(dashboardWindow, 1000, 700);
+    dashboard->OnWindowResize();
+    RunFrame(*dashboard, renderer);
+    CHECK(fakes.windows->PlaceCalls() == 0);
+
+    std::vector<AppHandle> apps;
+    std::vector<WindowId> tabs;
+    for (int i = 0; i < LAYOUT_TAB_COUNT; i++) {
+        AppDesc desc;
+        desc.name = "Layout " + std::to_string(i);
+        desc.commandLine = "layout_" + std::to_string(i) + ".exe";
+        desc.windowTitle = "[layout " + std::to_string(i) + "]";
+        desc.custom = true;
+        apps.push_back(dashboard->AddCustomApp(desc));
+        WindowInfo window = TopLevelWindow("Layout window [layout " + std::to_string(i) + "]");
+        window.pid = 400 + i;
+        tabs.push_back(fakes.windows->AddWindow(window));
+    }
+    for (int i = LAYOUT_TAB_COUNT - 1; i >= 0; i--) {
+        dashboard->LaunchApp(apps[i], i == 0);
+    }
+    RunFrame(*dashboard, renderer);
+    for (WindowId tab : tabs) {
+        CHECK(HasWindowParent(*fakes.windows, tab, dashboardWindow, tab == tabs[0]));
+    }
+
+    // A burst during one frame: no placement until the frame, then one batch of every tab
+    int calls = fakes.windows->PlaceCalls();
+    int placed = fakes.windows->PlacedWindows();
+    for (int i = 0; i < 100; i++) {
+        fakes.windows->SetSize(dashboardWindow, 900 + i * 3, 600 + i);
+        dashboard->OnWindowResize();
+    }
+    CHECK(fakes.windows->PlaceCalls() == calls);
+    RunFrame(*dashboard, renderer);
+    CHECK(fakes.windows->PlaceCalls() == calls + 1);
+    CHECK(fakes.windows->PlacedWindows() == placed + LAYOUT_TAB_COUNT);
+    for (WindowId tab : tabs) {
+        CHECK(HasSize(*fakes.windows, tab, 900 + 99 * 3 - LAYOUT_SIDEBAR_WIDTH, 600 + 99));
+    }
+    for (int frame = 0; frame < 5; frame++) {
+        RunFrame(*dashboard, renderer);
+    }
+    CHECK(fakes.windows->PlaceCalls() == calls + 1);
+
+    // Dragging the border: the modal loop's timer applies whatever piled up since its last tick
+    calls = fakes.windows->PlaceCalls();
+    int batches = 0;
+    int width = 0;
+    for (int tick = 0; tick < 20; tick++) {
+        // Every fourth tick the border did not move
+        if (tick % 4 != 3) {
+            for (int i = 0; i < 10; i++) {
+                width = 1100 + tick * 10 + i;
+                fakes.windows->SetSize(dashboardWindow, width, 720);
+                dashboard->OnWindowResize();
+            }
+            batches++;
+        }
+        dashboard->ApplyPendingLayout();
+        CHECK(fakes.windows->PlaceCalls() == calls + batches);
+        CHECK(HasSize(*fakes.windows, tabs[LAYOUT_TAB_COUNT - 1], width - LAYOUT_SIDEBAR_WIDTH, 720));
+    }
+    // WM_EXITSIZEMOVE with nothing pending
+    dashboard->ApplyPendingLayout();
+    CHECK(fakes.windows->PlaceCalls() == calls + batches);
+
+    // Too small a window still leaves the tabs usable
+    fakes.windows->SetSize(dashboardWindow, LAYOUT_SIDEBAR_WIDTH + 20, 40);
+    dashboard->OnWindowResize();
+    RunFrame(*dashboard, renderer);
+    for (WindowId tab : tabs) {
+        CHECK(HasSize(*fakes.windows, tab, 100, 100));
+    }
+}
+
+// A process tree whose members the check sets
+class ScriptedProcess : public LaunchedProcess {
+public:
+    explicit ScriptedProcess(std::vector<ProcessId> tree) : m_tree(std::move(tree)) {}
+
+    ProcessId Pid() const override { return m_tree.empty() ? 0 : m_tree[0]; }
+    std::vector<ProcessId> ProcessTree() const override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_tree;
+    }
+    bool Contains(ProcessId pid) const override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return std::find(m_tree.begin(), m_tree.end(), pid) != m_tree.end();
+    }
+    bool HasExited() const override { return false; }
+    void OnExit(std::function<void()>) override {}
+
+    void SetTree(std::vector<ProcessId> tree) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tree = std::move(tree);
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<ProcessId> m_tree;
+};
+
+// Counters that grow at a fixed rate per process from when the process is added; readable until removed
+class ScriptedTelemetryProvider : public TelemetryProvider {
+public:
+    struct Rates {
+        double cores = 0.0;
+        double ioBytesPerSecond = 0.0;
+        uint64_t privateBytes = 0;
+        uint32_t threadCount = 0;
+        // Counters it already had when it joined, which must not show up as a burst of usage
+        uint64_t initialCpuTimeNs = 0;
+    };
+
+    void BeginPass() override { m_passes++; }
+    bool Read(ProcessId pid, ProcessCounters& counters) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_processes.find(pid);
+        if (it == m_processes.end()) return false;
+        double seconds = std::chrono::duration<double>(Clock::now() - it->second.second).count();
+        const Rates& rates = it->second.first;
+        counters.cpuTimeNs = rates.initialCpuTimeNs + (uint64_t)(seconds * rates.cores * 1e9);
+        counters.ioBytes = (uint64_t)(seconds * rates.ioBytesPerSecond);
+        counters.privateBytes = rates.privateBytes;
+        counters.threadCount = rates.threadCount;
+        return true;
+    }
+
+    void Add(ProcessId pid, Rates rates) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_processes[pid] = { rates, Clock::now() };
+    }
+    void Remove(ProcessId pid) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_processes.erase(pid);
+    }
+    int Passes() const { return m_passes.load(); }
+
+private:
+    std::mutex m_mutex;
+    std::map<ProcessId, std::pair<Rates, Clock::time_point>> m_processes;
+    std::atomic<int> m_passes{ 0 };
+};
+
+// The next sample for key, skipping other keys; false if none arrives within timeoutMs
+bool NextSample(TelemetrySampler& sampler, uint64_t key, TelemetrySample& sample, int timeoutMs)
+{
+    Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (Clock::now() < deadline) {
+        while (sampler.TryPop(sample)) {
+            if (sample.key == key) return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return false;
+}
+
+bool Near(double value, double expected, double tolerance)
+{
+    return value > expected - tolerance && value < expected + tolerance;
+}
+
+const int TELEMETRY_INTERVAL_MS = 20;
+
+// The sampler on scripted counters: whole-tree sums and rates, members joining and leaving, untracking,
+// and a consumer that stops draining losing samples rather than blocking the sampler
+void CheckTelemetry()
+{
+    auto scripted = std::make_unique<ScriptedTelemetryProvider>();
+    ScriptedTelemetryProvider& provider = *scripted;
+    TelemetrySampler sampler(std::move(scripted), TELEMETRY_INTERVAL_MS);
+    CHECK(!sampler.IsTracking());
+    // Nothing tracked: the sampler thread sleeps
+    std::this_thread::sleep_for(std::chrono::milliseconds(5 * TELEMETRY_INTERVAL_MS));
+    CHECK(provider.Passes() == 0);
+
+    provider.Add(11, { 0.25, 1e6, 100ull << 20, 10, 0 });
+    provider.Add(12, { 0.5, 2e6, 50ull << 20, 5, 0 });
+    auto process = std::make_shared<ScriptedProcess>(std::vector<ProcessId>{ 11, 12 });
+    const uint64_t key = 7;
+    sampler.Track(key, process);
+    CHECK(sampler.IsTracking());
+
+    TelemetrySample sample;
+    CHECK(NextSample(sampler, key, sample, 1000));
+    CHECK(sample.processCount == 2 && sample.threadCount == 15 && sample.privateBytes == (150ull << 20));
+    for (int i = 0; i < 3; i++) {
+        CHECK(NextSample(sampler, key, sample, 1000));
+    }
+    printf("  two processes: %.1f%% CPU, %.2f MB/s I/O\n", sample.cpuPercent, sample.ioBytesPerSecond / 1e6);
+    CHECK(Near(sample.cpuPercent, 75.0, 15.0));
+    CHECK(Near(sample.ioBytesPerSecond, 3e6, 0.6e6));
+
+    // A member joins with a lot of CPU time behind it: counted, but its history is not a burst of usage
+    provider.Add(13, { 0.0, 0.0, 10ull << 20, 1, 3600ull * 1000000000ull });
+    process->SetTree({ 11, 12, 13 });
+    for (int i = 0; i < 4; i++) {
+        CHECK(NextSample(sampler, key, sample, 1000));
+        CHECK(sample.cpuPercent < 100.0f);
+    }
+    CHECK(sample.processCount == 3 && sample.threadCount == 16 && sample.privateBytes == (160ull << 20));
+
+    // A member that can no longer be read drops out
+    provider.Remove(12);
+    for (int i = 0; i < 3; i++) {
+        CHECK(NextSample(sampler, key, sample, 1000));
+    }
+    CHECK(sample.processCount == 2 && sample.threadCount == 11 && sample.privateBytes == (110ull << 20));
+    CHECK(Near(sample.cpuPercent, 25.0, 10.0));
+
+    // Changes only: a steady tree publishes nothing, and a new reading is published along with the callback
+    std::atomic<int> published(0);
+    sampler.SetOnPublish([&]() { published++; });
+    sampler.SetChangesOnly(true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2 * TELEMETRY_INTERVAL_MS));
+    while (sampler.TryPop(sample)) {}
+    published = 0;
+    int quietFrom = provider.Passes();
+    CHECK(WaitUntil([&]() { return provider.Passes() >= quietFrom + 5; }, 5000));
+    CHECK(!sampler.TryPop(sample) && published == 0);
+    provider.Add(11, { 0.25, 1e6, 300ull << 20, 10, 0 });
+    CHECK(NextSample(sampler, key, sample, 1000) && sample.privateBytes == (310ull << 20));
+    CHECK(published > 0);
+    sampler.SetChangesOnly(false);
+    sampler.SetOnPublish(nullptr);
+
+    // Untracked: after what was already queued, no more samples
+    sampler.Untrack(key);
+    CHECK(!sampler.IsTracking());
+    std::this_thread::sleep_for(std::chrono::milliseconds(2 * TELEMETRY_INTERVAL_MS));
+    while (sampler.TryPop(sample)) {}
+    CHECK(!NextSample(sampler, key, sample, 5 * TELEMETRY_INTERVAL_MS));
+
+    // Nobody draining: the ring fills, the rest are counted as dropped, and the sampler keeps going
+    for (uint64_t other = 100; other < 108; other++) {
+        sampler.Track(other, process);
+    }
+    int passes = provider.Passes();
+    CHECK(WaitUntil([&]() { return sampler.DroppedSamples() > 0; }, 5000));
+    CHECK(provider.Passes() > passes);
+    size_t drained = 0;
+    while (sampler.TryPop(sample)) drained++;
+    CHECK(drained <= TelemetrySampler::RING_CAPACITY && drained >= TelemetrySampler::RING_CAPACITY - 8);
+    printf("  ring full: %zu samples kept, %llu dropped\n", drained, (unsigned long long)sampler.DroppedSamples());
+    for (uint64_t other = 100; other < 108; other++) {
+        sampler.Untrack(other);
+    }
+
+#ifndef _WIN32
+    // The platform provider on this process
+    std::unique_ptr<TelemetryProvider> platform = CreatePlatformTelemetryProvider();
+    ProcessCounters before;
+    platform->BeginPass();
+    CHECK(platform->Read((ProcessId)getpid(), before));
+    CHECK(before.privateBytes > 0 && before.threadCount >= 2);
+    volatile uint64_t spin = 0;
+    Clock::time_point start = Clock::now();
+    while (MsSince(start) < 50.0) spin = spin + 1;
+    ProcessCounters after;
+    platform->BeginPass();
+    CHECK(platform->Read((ProcessId)getpid(), after));
+    CHECK(after.cpuTimeNs >= before.cpuTimeNs + 20000000ull);
+    CHECK(!platform->Read((ProcessId)0x7FFFFFF0, after));
+#endif
+}
+
+// Just enough JSON to read a trace back: a strict parser that fails on anything malformed
+struct JsonValue {
+    enum Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT } type = NUL;
+    double number = 0.0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    const JsonValue* Member(const char* key) const {
+        for (const auto& member : members) {
+            if (member.first == key) return &member.second;
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : m_text(text) {}
+
+    bool Parse(JsonValue& value) {
+        if (!ParseValue(value, 0)) return false;
+        SkipSpace();
+        return m_at == m_text.size();
+    }
+
+private:
+    void SkipSpace() {
+        while (m_at < m_text.size() && strchr(" \t\r\n", m_text[m_at])) m_at++;
+    }
+
+    bool Literal(const char* word) {
+        size_t length = strlen(word);
+        if (m_text.compare(m_at, length, word) != 0) return false;
+        m_at += length;
+        return true;
+    }
+
+    bool ParseString(std::string& out) {
+        if (m_text[m_at] != '"') return false;
+        for (m_at++; m_at < m_text.size(); m_at++) {
+            char c = m_text[m_at];
+            if (c == '"') {
+                m_at++;
+                return true;
+            }
+            if ((unsigned char)c < 0x20) return false;
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (++m_at == m_text.size()) return false;
+            switch (m_text[m_at]) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            default: return false;
+            }
+        }
+        return false;
+    }
+
+    bool ParseValue(JsonValue& value, int depth) {
+        SkipSpace();
+        if (m_at == m_text.size() || depth > 16) return false;
+        char c = m_text[m_at];
+        if (c == '{') {
+            value.type = JsonValue::OBJECT;
+            m_at++;
+            SkipSpace();
+            if (m_at < m_text.size() && m_text[m_at] == '}') return ++m_at, true;
+            for (;;) {
+                std::pair<std::string, JsonValue> member;
+                SkipSpace();
+                if (m_at == m_text.size() || !ParseString(member.first)) return false;
+                SkipSpace();
+                if (m_at == m_text.size() || m_text[m_at++] != ':') return false;
+                if (!ParseValue(member.second, depth + 1)) return false;
+                value.members.push_back(std::move(member));
+                SkipSpace();
+                if (m_at == m_text.size()) return false;
+                if (m_text[m_at] == '}') return ++m_at, true;
+                if (m_text[m_at++] != ',') return false;
+            }
+        }
+        if (c == '[') {
+            value.type = JsonValue::ARRAY;
+            m_at++;
+            SkipSpace();
+            if (m_at < m_text.size() && m_text[m_at] == ']') return ++m_at, true;
+            for (;;) {
+                value.items.emplace_back();
+                if (!ParseValue(value.items.back(), depth + 1)) return false;
+                SkipSpace();
+                if (m_at == m_text.size()) return false;
+                if (m_text[m_at] == ']') return ++m_at, true;
+                if (m_text[m_at++] != ',') return false;
+            }
+        }
+        if (c == '"') {
+            value.type = JsonValue::STRING;
+            return ParseString(value.text);
+        }
+        if (Literal("true") || Literal("false")) {
+            value.type = JsonValue::BOOLEAN;
+            return true;
+        }
+        if (Literal("null")) return true;
+        const char* begin = m_text.c_str() + m_at;
+        char* end = nullptr;
+        value.type = JsonValue::NUMBER;
+        value.number = strtod(begin, &end);
+        if (end == begin) return false;
+        m_at += end - begin;
+        return true;
+    }
+
+    const std::string& m_text;
+    size_t m_at = 0;
+};
+
+struct TraceEvent {
+    std::string name;
+    std::string phase;
+    double ts = 0.0;
+    double dur = 0.0;
+    int tid = -1;
+    std::string threadName;
+};
+
+// Every event must have the fields chrome://tracing needs for its phase
+bool ReadTraceEvents(const std::string& path, std::vector<TraceEvent>& events)
+{
+    JsonValue root;
+    std::string text = ReadFile(path);
+    if (!JsonParser(text).Parse(root) || root.type != JsonValue::OBJECT) return false;
+    const JsonValue* list = root.Member("traceEvents");
+    if (!list || list->type != JsonValue::ARRAY) return false;
+    for (const JsonValue& item : list->items) {
+        const JsonValue* name = item.Member("name");
+        const JsonValue* phase = item.Member("ph");
+        const JsonValue* pid = item.Member("pid");
+        const JsonValue* tid = item.Member("tid");
+        if (!name || name->type != JsonValue::STRING || !phase || phase->type != JsonValue::STRING) return false;
+        if (!pid || pid->type != JsonValue::NUMBER || !tid || tid->type != JsonValue::NUMBER) return false;
+        TraceEvent event;
+        event.name = name->text;
+        event.phase = phase->text;
+        event.tid = (int)tid->number;
+        if (event.phase == "X") {
+            const JsonValue* ts = item.Member("ts");
+            const JsonValue* dur = item.Member("dur");
+            if (!ts || ts->type != JsonValue::NUMBER || !dur || dur->type != JsonValue::NUMBER) return false;
+            event.ts = ts->number;
+            event.dur = dur->number;
+        }
+        else if (event.phase == "M") {
+            const JsonValue* args = item.Member("args");
+            const JsonValue* threadName = args ? args->Member("name") : nullptr;
+            if (!threadName || threadName->type != JsonValue::STRING) return false;
+            event.threadName = threadName->text;
+        }
+        else {
+            return false;
+        }
+        events.push_back(event);
+    }
+    return true;
+}
+
+const char* const TRACE_ODD_ZONE = "Zone \"quoted\" \\ back\tslash";
+
+void RecordTraceFrame(bool slow)
+{
+    ProfileFrameScope frame;
+    ProfileScope outer("Outer");
+    {
+        ProfileScope inner("Inner");
+        if (slow) std::this_thread::sleep_for(std::chrono::milliseconds(8));
+    }
+    ProfileScope odd(TRACE_ODD_ZONE);
+    std::thread worker([]() {
+        FrameProfiler::Instance().SetThreadName("Trace \"worker\"");
+        ProfileScope work("Worker zone");
+    });
+    worker.join();
+}
+
+// The Chrome trace export read back with a strict JSON parser: thread names, one complete event per
+// frame, zones inside their frame and their parent, names escaped, and the last frame written once
+void CheckChromeTrace()
+{
+    FrameProfiler& profiler = FrameProfiler::Instance();
+    // The exporter puts frames on their own row after the thread slots
+    const int framesRow = FrameProfiler::MAX_THREADS;
+    float budget = profiler.BudgetMs();
+    profiler.SetBudgetMs(4.0f);
+    profiler.ClearCaptures();
+    profiler.SetThreadName("Checks");
+
+    // More slow frames than there are capture slots, then fast ones
+    for (int i = 0; i < FrameProfiler::MAX_CAPTURES + 3; i++) {
+        RecordTraceFrame(true);
+    }
+    CHECK(profiler.CaptureCount() == FrameProfiler::MAX_CAPTURES);
+    for (int i = 1; i < profiler.CaptureCount(); i++) {
+        CHECK(profiler.Capture(i).index == profiler.Capture(i - 1).index + 1);
+    }
+    const std::string path = "headless_checks_trace.json";
+    std::vector<TraceEvent> events;
+    CHECK(profiler.ExportChromeTrace(path));
+    bool parsed = ReadTraceEvents(path, events);
+    CHECK(parsed);
+    // The last frame is the newest capture, so it is not written twice
+    int frameEvents = 0;
+    for (const TraceEvent& event : events) {
+        if (event.phase == "X" && event.tid == framesRow) frameEvents++;
+    }
+    CHECK(frameEvents == FrameProfiler::MAX_CAPTURES);
+
+    RecordTraceFrame(false);
+    CHECK(profiler.ExportChromeTrace(path));
+    events.clear();
+    parsed = ReadTraceEvents(path, events);
+    CHECK(parsed);
+    if (!parsed) return;
+
+    std::map<int, std::string> threadNames;
+    std::vector<const TraceEvent*> frames;
+    std::vector<const TraceEvent*> zones;
+    for (const TraceEvent& event : events) {
+        if (event.phase == "M") {
+            CHECK(event.name == "thread_name" && !threadNames.count(event.tid));
+            threadNames[event.tid] = event.threadName;
+        }
+        else if (event.tid == framesRow) {
+            frames.push_back(&event);
+        }
+        else {
+            zones.push_back(&event);
+        }
+    }
+    CHECK(threadNames[framesRow] == "Frames");
+    bool namedMain = false;
+    bool namedWorker = false;
+    for (const auto& thread : threadNames) {
+        namedMain = namedMain || thread.second == "Checks";
+        namedWorker = namedWorker || thread.second == "Trace \"worker\"";
+    }
+    CHECK(namedMain && namedWorker);
+    CHECK((int)frames.size() == FrameProfiler::MAX_CAPTURES + 1);
+    for (size_t i = 0; i < frames.size(); i++) {
+        CHECK(frames[i]->ts >= 0.0);
+        CHECK(i + 1 == frames.size() ? frames[i]->dur < 4000.0 : frames[i]->dur >= 4000.0);
+        CHECK(i == 0 || frames[i]->ts > frames[i - 1]->ts + frames[i - 1]->dur - 0.01);
+    }
+
+    // Each frame's four zones, on their threads, inside the frame and, for Inner, inside Outer
+    const double slack = 0.01;
+    int oddZones = 0;
+    for (const TraceEvent* zone : zones) {
+        CHECK(threadNames.count(zone->tid) == 1 && zone->dur >= 0.0);
+        const TraceEvent* frame = nullptr;
+        for (const TraceEvent* candidate : frames) {
+            if (zone->ts >= candidate->ts - slack && zone->ts + zone->dur <= candidate->ts + candidate->dur + slack) frame = candidate;
+        }
+        CHECK(frame != nullptr);
+        bool onWorker = threadNames[zone->tid] == "Trace \"worker\"";
+        CHECK(onWorker == (zone->name == "Worker zone"));
+        if (zone->name == "Inner") {
+            bool nested = false;
+            for (const TraceEvent* outer : zones) {
+                nested = nested || (outer->name == "Outer" && outer->tid == zone->tid && zone->ts >= outer->ts - slack &&
+                    zone->ts + zone->dur <= outer->ts + outer->dur + slack);
+            }
+            CHECK(nested);
+        }
+        // Control characters are dropped, quotes and backslashes escaped
+        if (zone->name.find("quoted") != std::string::npos) {
+            CHECK(zone->name == "Zone \"quoted\" \\ backslash");
+            oddZones++;
+        }
+    }
+    CHECK(zones.size() == frames.size() * 4);
+    CHECK(oddZones == (int)frames.size());
+
+    CHECK(!profiler.ExportChromeTrace("headless_checks_missing_dir/trace.json"));
+    remove(path.c_str());
+    profiler.ClearCaptures();
+    profiler.SetBudgetMs(budget);
+}
+
+// Only hidden tabs are throttled: switching tabs moves the throttle, a hidden tab whose process exits
+// is let go, and releasing the tabs at exit restores them all
+void CheckTabThrottling()
+{
+    FakeBackends fakes;
+    std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes);
+    NullRenderer renderer;
+    renderer.Init();
+    std::vector<AppHandle> apps;
+    std::vector<ProcessId> pids;
+    for (int i = 0; i < 4; i++) {
+        AppDesc desc;
+        desc.name = "Throttled " + std::to_string(i);
+        desc.commandLine = "throttled_" + std::to_string(i) + ".exe";
+        desc.windowTitle = "[throttled " + std::to_string(i) + "]";
+        desc.custom = true;
+        // The last one is a launcher that opted out
+        desc.throttleWhenHidden = i < 3;
+        apps.push_back(dashboard->AddCustomApp(desc));
+        WindowInfo window = TopLevelWindow("Throttled window [throttled " + std::to_string(i) + "]");
+        window.pid = 600 + i;
+        pids.push_back(window.pid);
+        fakes.windows->AddWindow(window);
+    }
+    dashboard->LaunchApp(apps[0]);
+    CHECK(fakes.governor->ThrottledCount() == 0);
+    dashboard->LaunchApp(apps[1], false);
+    dashboard->LaunchApp(apps[2], false);
+    CHECK(fakes.governor->ThrottledCount() == 2);
+
+    // Switching: the new tab is restored, the old one throttled; switching to itself changes nothing
+    for (int round = 0; round < 6; round++) {
+        dashboard->LaunchApp(apps[round % 3]);
+        CHECK(fakes.governor->ThrottledCount() == 2);
+    }
+    dashboard->LaunchApp(apps[2]);
+    dashboard->LaunchApp(apps[2]);
+    CHECK(fakes.governor->ThrottledCount() == 2);
+
+    // A game started from a tab shows its own window: hiding the tab throttles the rest of the tree but not the game
+    dashboard->LaunchApp(apps[1]);
+    ProcessId helper = fakes.launcher->SpawnChild(pids[1]);
+    ProcessId game = fakes.launcher->SpawnChild(pids[1]);
+    CHECK(helper != 0 && game != 0);
+    WindowInfo gameWindow = TopLevelWindow("Game [fullscreen]");
+    gameWindow.pid = game;
+    WindowId gameWindowId = fakes.windows->AddWindow(gameWindow);
+    dashboard->LaunchApp(apps[2]);
+    CHECK(fakes.governor->IsProcessThrottled(pids[1]) && fakes.governor->IsProcessThrottled(helper));
+    CHECK(!fakes.governor->IsProcessThrottled(game));
+    // Once the game window is gone, the next time the tab is hidden the game is throttled with it
+    fakes.windows->SetVisible(gameWindowId, false);
+    dashboard->LaunchApp(apps[1]);
+    dashboard->LaunchApp(apps[2]);
+    CHECK(fakes.governor->IsProcessThrottled(game));
+
+    // An app that opted out stays untouched while hidden
+    dashboard->LaunchApp(apps[3], false);
+    CHECK(fakes.governor->ThrottledCount() == 2);
+    CHECK(!fakes.governor->IsProcessThrottled(pids[3]));
+
+    // A hidden tab's process exits: its exit is handled on the UI thread at the next frame
+    fakes.launcher->Exit(pids[0]);
+    RunFrame(*dashboard, renderer);
+    CHECK(fakes.governor->ThrottledCount() == 1);
+
+    dashboard->ReleaseTabs();
+    CHECK(fakes.governor->ThrottledCount() == 0);
+}
+
+// Most allocations any one of frames took, measured like the Win32 loop does; move runs before each
+AllocationStats WorstFrameAllocations(GamingDashboard& dashboard, NullRenderer& renderer, int frames,
+    const std::function<void(int)>& move = nullptr)
+{
+    FrameAllocationMeter meter;
+    dashboard.SetAllocationMeter(&meter);
+    AllocationStats worst;
+    for (int frame = 0; frame < frames; frame++) {
+        if (move) move(frame);
+        meter.BeginFrame();
+        RunFrame(dashboard, renderer);
+        meter.EndFrame();
+        if (meter.LastFrame().count > worst.count) worst = meter.LastFrame();
+    }
+    dashboard.SetAllocationMeter(nullptr);
+    return worst;
+}
+
+// A left click at position, pressed and released over two frames
+void ClickAt(GamingDashboard& dashboard, NullRenderer& renderer, ImVec2 position)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.AddMousePosEvent(position.x, position.y);
+    RunFrame(dashboard, renderer);
+    io.AddMouseButtonEvent(0, true);
+    RunFrame(dashboard, renderer);
+    io.AddMouseButtonEvent(0, false);
+    RunFrame(dashboard, renderer);
+    io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+}
+
+bool WindowOpen(const char* name)
+{
+    ImGuiWindow* window = ImGui::FindWindowByName(name);
+    return window && window->Active;
+}
+
+// GamingDashboard's sidebar footer: fixed-height buttons, Launch Profiles just above Settings at the bottom
+const float SIDEBAR_FOOTER_BUTTON_HEIGHT = 35.0f;
+
+ImVec2 LaunchProfilesButton()
+{
+    const ImGuiStyle& style = ImGui::GetStyle();
+    float settingsTop = DISPLAY_HEIGHT - style.WindowPadding.y - SIDEBAR_FOOTER_BUTTON_HEIGHT;
+    return ImVec2(100.0f, settingsTop - style.ItemSpacing.y - SIDEBAR_FOOTER_BUTTON_HEIGHT / 2);
+}
+
+void CheckNoAllocations(const char* state, const AllocationStats& worst)
+{
+    printf("  %s: at most %llu allocations (%llu bytes) a frame\n", state, (unsigned long long)worst.count,
+        (unsigned long long)worst.bytes);
+    CHECK(worst.count == 0);
+}
+
+// Steady-state frames on the UI thread allocate nothing: idle, with the mouse over the sidebar, with
+// tabs embedded and telemetry arriving, and with a launch pending
+void CheckFrameAllocations()
+{
+    if (!AllocationCountingEnabled()) {
+        fprintf(stderr, "  built without GD_COUNT_ALLOCATIONS, nothing is counted\n");
+        CHECK(AllocationCountingEnabled());
+        return;
+    }
+    // The counter sees both operator new and ImGui's allocator
+    AllocationStats before = ThreadAllocations();
+    delete new std::vector<int>(100);
+    ImGui::MemFree(ImGui::MemAlloc(100));
+    CHECK(ThreadAllocations().count == before.count + 3);
+
+    FakeBackends fakes;
+    std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes);
+    NullRenderer renderer;
+    renderer.Init();
+    std::vector<AppHandle> apps;
+    for (int i = 0; i < 10; i++) {
+        AppDesc desc;
+        desc.name = "Steady " + std::to_string(i);
+        desc.commandLine = "steady_" + std::to_string(i) + ".exe";
+        desc.iconPath = ICON_PATHS[i % ICON_PATH_COUNT];
+        desc.windowTitle = "[steady " + std::to_string(i) + "]";
+        desc.custom = true;
+        apps.push_back(dashboard->AddCustomApp(desc));
+    }
+
+    // Warm-up frames size ImGui's buffers and the renderer's staging buffers
+    WorstFrameAllocations(*dashboard, renderer, 30);
+    CheckNoAllocations("idle", WorstFrameAllocations(*dashboard, renderer, 60));
+
+    ImGuiIO& io = ImGui::GetIO();
+    auto hover = [&io](int frame) { io.AddMousePosEvent(100.0f, 60.0f + (frame * 7) % 400); };
+    WorstFrameAllocations(*dashboard, renderer, 30, hover);
+    CheckNoAllocations("mouse over the sidebar", WorstFrameAllocations(*dashboard, renderer, 60, hover));
+    io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+
+    // Running already, so both are embedded at once; the first is current, the second throttled
+    for (int i = 0; i < 2; i++) {
+        WindowInfo window = TopLevelWindow("Steady window [steady " + std::to_string(i) + "]");
+        window.pid = 300 + i;
+        fakes.windows->AddWindow(window);
+    }
+    dashboard->LaunchApp(apps[1], false);
+    dashboard->LaunchApp(apps[0]);
+    // A tab's first telemetry sample arrives TelemetrySampler::INTERVAL_MS after it is tracked, later ones
+    // whenever its sidebar reading changes
+    auto paced = [](int) { std::this_thread::sleep_for(std::chrono::milliseconds(20)); };
+    WorstFrameAllocations(*dashboard, renderer, 30, paced);
+    CheckNoAllocations("two tabs, telemetry arriving", WorstFrameAllocations(*dashboard, renderer, 60, paced));
+
+    // A launch whose window never shows: the sidebar row shows its loading label until it times out
+    dashboard->LaunchApp(apps[5], false);
+    WorstFrameAllocations(*dashboard, renderer, 30, paced);
+    CheckNoAllocations("launch pending", WorstFrameAllocations(*dashboard, renderer, 60, paced));
+
+    // The profiles window listing members with dependencies and a missing app
+    dashboard->AddLaunchProfile({ "Evening", { { "Steady 0", {} }, { "Steady 1", { "Steady 0", "Steady 2" } },
+        { "Uninstalled", { "Steady 1" } } } });
+    ClickAt(*dashboard, renderer, LaunchProfilesButton());
+    CHECK(WindowOpen("Launch Profiles"));
+    WorstFrameAllocations(*dashboard, renderer, 30);
+    CheckNoAllocations("profiles window open", WorstFrameAllocations(*dashboard, renderer, 60));
+}
+
+// The Win32 main loop without its message pump: sleep until there is work, render only the frames
+// owed. Runs for durationMs and returns the frames rendered.
+int RunIdleLoop(GamingDashboard& dashboard, FrameScheduler& scheduler, NullRenderer& renderer, int durationMs)
+{
+    std::atomic<bool> stop(false);
+    std::thread stopper([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
+        stop = true;
+        scheduler.Wakeup();
+    });
+    int frames = 0;
+    for (;;) {
+        scheduler.WaitForWork();
+        if (stop) break;
+        if (!scheduler.BeginFrame()) continue;
+        RunFrame(dashboard, renderer);
+        frames++;
+    }
+    stopper.join();
+    // The stopper's wakeup is not a frame of the next run
+    while (scheduler.BeginFrame()) {}
+    return frames;
+}
+
+void CheckIdleFrames()
+{
+    FakeBackends fakes;
+    std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes);
+    NullRenderer renderer;
+    renderer.Init();
+    FrameScheduler scheduler;
+    dashboard->SetFrameScheduler(&scheduler);
+
+    // Nothing happening: the frames owed at startup, then sleep
+    const int IDLE_MS = 1500;
+    std::clock_t cpuStart = std::clock();
+    int frames = RunIdleLoop(*dashboard, scheduler, renderer, IDLE_MS);
+    double cpuMs = 1000.0 * (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    CHECK(frames == FrameScheduler::SETTLE_FRAMES);
+    CHECK(cpuMs < IDLE_MS * 0.05);
+    printf("  idle %d ms: %d frames, %.1f ms CPU\n", IDLE_MS, frames, cpuMs);
+
+    // Input: the settle frames and no more
+    scheduler.RequestFrames(FrameScheduler::SETTLE_FRAMES);
+    CHECK(RunIdleLoop(*dashboard, scheduler, renderer, 300) == FrameScheduler::SETTLE_FRAMES);
+
+    // A deadline: one frame when it passes
+    scheduler.RequestFrameAfter(100);
+    CHECK(RunIdleLoop(*dashboard, scheduler, renderer, 400) == 1);
+
+    // Wakeups from another thread: a frame each
+    std::thread waker([&]() {
+        for (int i = 0; i < 10; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            scheduler.Wakeup();
+        }
+    });
+    frames = RunIdleLoop(*dashboard, scheduler, renderer, 600);
+    waker.join();
+    CHECK(frames >= 8 && frames <= 10);
+
+    // A launch refreshes its spinner until the window arrives, then the loop goes quiet again except
+    // for telemetry of the new tab
+    AppDesc desc;
+    desc.name = "Idle App";
+    desc.commandLine = "idle_app.exe";
+    desc.windowTitle = "Idle App Window";
+    desc.custom = true;
+    std::thread opener;
+    WindowId appWindow = 0;
+    fakes.launcher->SetLaunchHandler([&](ProcessId pid, const std::string&) {
+        opener = std::thread([&, pid]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            WindowInfo window = TopLevelWindow(desc.windowTitle);
+            window.pid = pid;
+            appWindow = fakes.windows->AddWindow(window);
+        });
+    });
+    dashboard->LaunchApp(dashboard->AddCustomApp(desc));
+    frames = RunIdleLoop(*dashboard, scheduler, renderer, 1500);
+    if (opener.joinable()) opener.join();
+    WindowInfo embedded;
+    CHECK(appWindow != 0 && fakes.windows->QueryWindow(appWindow, embedded) && embedded.parent != 0);
+    CHECK(frames > 1);
+    // With the tab embedded and its telemetry steady, an idle minute renders nothing, however often it is sampled
+    const int TRACKED_IDLE_MS = 60000;
+    frames = RunIdleLoop(*dashboard, scheduler, renderer, TRACKED_IDLE_MS);
+    CHECK(frames <= 1);
+    printf("  tab open, idle %d ms: %d frames\n", TRACKED_IDLE_MS, frames);
+
+    dashboard->SetFrameScheduler(nullptr);
+}
+
+// Two unknown apps start at a time, so the other two of a batch wait: clicking a waiting row's label
+// moves that launch to the front, and only its cancel button cancels it
+void CheckQueuedLaunchClick()
+{
+    FakeBackends fakes;
+    std::unique_ptr<GamingDashboard> dashboard = CreateDashboard(fakes);
+    NullRenderer renderer;
+    renderer.Init();
+    std::vector<AppHandle> apps;
+    for (int i = 0; i < 4; i++) {
+        AppDesc desc;
+        desc.name = "Queued " + std::to_string(i);
+        desc.commandLine = "queued_" + std::to_string(i) + ".exe";
+        desc.windowTitle = "[queued " + std::to_string(i) + "]";
+        desc.custom = true;
+        apps.push_back(dashboard->AddCustomApp(desc));
+    }
+    std::mutex mutex;
+    std::vector<std::pair<ProcessId, std::string>> launched;
+    fakes.launcher->SetLaunchHandler([&](ProcessId pid, const std::string& commandLine) {
+        std::lock_guard<std::mutex> lock(mutex);
+        launched.push_back({ pid, commandLine });
+    });
+    auto launchCount = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return launched.size();
+    };
+    LaunchScheduler& scheduler = dashboard->GetLaunchScheduler();
+    dashboard->LaunchApps(apps, AppHandle());
+    CHECK(WaitUntil([&]() { return launchCount() == 2 && scheduler.QueuedCount() == 2; }, 2000));
+
+    RunFrame(*dashboard, renderer);
+    ImGuiWindow* list = FindAppList();
+    CHECK(list != nullptr);
+    if (!list) return;
+    // The three built-in apps come first
+    float rowPitch = SIDEBAR_ROW_HEIGHT + ImGui::GetStyle().ItemSpacing.y;
+    auto rowCenter = [&](int app) { return list->InnerRect.Min.y + (app + 3) * rowPitch + SIDEBAR_ROW_HEIGHT / 2; };
+    ClickAt(*dashboard, renderer, ImVec2(list->InnerRect.Min.x + 60.0f, rowCenter(3)));
+    CHECK(scheduler.QueuedCount() == 2);
+
+    // A window for the first app ends its start; the clicked app goes next
+    WindowInfo window = TopLevelWindow("Queued window [queued 0]");
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        window.pid = launched[0].first;
+    }
+    fakes.windows->AddWindow(window);
+    CHECK(WaitUntil([&]() { return launchCount() == 3; }, 5000));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        CHECK(launched.size() == 3 && launched[2].second == "queued_3.exe");
+    }
+
+    // The cancel button of the app still waiting
+    RunFrame(*dashboard, renderer);
+    ClickAt(*dashboard, renderer, ImVec2(list->InnerRect.Max.x - 8.0f, rowCenter(2)));
+    CHECK(WaitUntil([&]() { return scheduler.QueuedCount() == 0; }, 2000));
+    CHECK(launchCount() == 3);
+}
+
+struct NamedCheck {
+    const char* name;
+    void (*run)();
+};
+
+const NamedCheck CHECKS[] = {
+    { "window-discovery", CheckWindowDiscovery },
+    { "window-index", CheckWindowIndex },
+    { "command-queue", CheckCommandQueue },
+    { "spsc-ring", CheckSpscRing },
+    { "coroutines", CheckCoroutines },
+    { "remove-app", CheckRemoveApp },
+    { "batched-layout", CheckBatchedLayout },
+    { "tab-throttling", CheckTabThrottling },
+    { "queued-click", CheckQueuedLaunchClick },
+    { "telemetry", CheckTelemetry },
+    { "chrome-trace", CheckChromeTrace },
+    { "idle-frames", CheckIdleFrames },
+    { "frame-allocations", CheckFrameAllocations },
+    { "decode-pool", CheckDecodePool },
+    { "icon-atlas", CheckIconAtlas },
+    { "sidebar-clipper", CheckSidebarClipper },
+    { "icon-cache", CheckIconCache },
+    { "resample-backends", CheckResampleBackends },
+    { "settings", CheckSettings },
+    { "launch-timeouts", CheckLaunchTimeouts },
+    { "readiness-matcher", CheckReadinessMatcher },
+#ifndef _WIN32
+    { "process-reaping", CheckProcessReaping },
+    { "process-throttling", CheckProcessThrottling },
+#endif
+};
+
+}
+
+int main(int argc, char** argv)
+{
+    InstallImGuiAllocationHooks();
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+    io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+    ApplyDashboardStyle();
+
+    int run = 0;
+    for (const NamedCheck& check : CHECKS) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc && !selected; i++) {
+            selected = strcmp(argv[i], check.name) == 0;
+        }
+        if (!selected) continue;
+
+        int failuresBefore = g_failures;
+        printf("%s\n", check.name);
+        check.run();
+        printf("%s: %s\n", check.name, g_failures == failuresBefore ? "ok" : "FAILED");
+        run++;
+    }
+    ImGui::DestroyContext();
+    remove(ICON_CACHE_PATH);
+    if (run == 0) {
+        fprintf(stderr, "usage: %s [check ...]\n", argv[0]);
+        for (const NamedCheck& check : CHECKS) {
+            fprintf(stderr, "  %s\n", check.name);
+        }
+        return 1;
+    }
+    if (g_failures != 0) fprintf(stderr, "%d check(s) failed\n", g_failures);
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,290 @@
+#include "IconAtlas.h"
+
+#include "IconLoader.h"
+#include "imgui_internal.h"
+
+#include <cstring>
+
+// imgui_draw.cpp compiles its copy as static, so this translation unit needs its own. Being static,
+// the parts of it the atlas does not call are unused functions here.
+#define STBRP_STATIC
+#define STBRP_ASSERT(x) do { IM_ASSERT(x); } while (0)
+#define STB_RECT_PACK_IMPLEMENTATION
+#if defined(_MSC_VER)
+#pragma warning (push)
+#pragma warning (disable: 4505)     // unreferenced local function has been removed
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#include "imstb_rectpack.h"
+#if defined(_MSC_VER)
+#pragma warning (pop)
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+struct IconAtlas::Packer {
+    stbrp_context context;
+    std::vector<stbrp_node> nodes;
+
+    void Init(int width, int height) {
+        nodes.resize(width);
+        stbrp_init_target(&context, width, height, nodes.data(), (int)nodes.size());
+    }
+};
+
+IconAtlas::IconAtlas()
+    : m_packer(std::make_unique<Packer>())
+{
+}
+
+IconAtlas::~IconAtlas()
+{
+    // Normally runs after the renderer backend has shut down and released the GPU textures
+    std::vector<ImTextureData*> textures = m_retired;
+    if (m_texture) textures.push_back(m_texture);
+    for (ImTextureData* texture : textures) {
+        if (ImGui::GetCurrentContext()) ImGui::UnregisterUserTexture(texture);
+        IM_DELETE(texture);
+    }
+}
+
+IconTexture IconAtlas::Add(const ImageView& image)
+{
+    return Insert(image, true);
+}
+
+IconTexture IconAtlas::AddShared(const ImageView& image)
+{
+    return Insert(image, false);
+}
+
+IconTexture IconAtlas::Insert(const ImageView& image, bool copy)
+{
+    IconTexture icon;
+    if (!image.IsValid()) return icon;
+    if (image.width + 2 * PADDING > MAX_SIZE || image.height + 2 * PADDING > MAX_SIZE) return icon;
+
+    int id = AllocateEntry();
+    Entry& entry = m_entries[id];
+    if (copy) entry.owned.assign(image.pixels, image.pixels + (size_t)image.width * image.height * 4);
+    else entry.shared = image.pixels;
+    entry.width = image.width;
+    entry.height = image.height;
+    entry.used = true;
+    m_iconCount++;
+
+    bool placed;
+    if (!m_texture) {
+        placed = Rebuild(INITIAL_SIZE, INITIAL_SIZE);
+    }
+    else if (PackIncremental(entry)) {
+        Blit(entry, true);
+        placed = true;
+    }
+    else {
+        // Full: repack everything into a larger texture
+        placed = Rebuild(m_texture->Width, m_texture->Height);
+    }
+
+    if (!placed) {
+        // Atlas is at its maximum size; put the other icons back where they were
+        entry = Entry();
+        m_freeIds.push_back(id);
+        m_iconCount--;
+        Rebuild(m_texture ? m_texture->Width : INITIAL_SIZE, m_texture ? m_texture->Height : INITIAL_SIZE);
+        return icon;
+    }
+
+    icon.atlasId = id;
+    icon.width = image.width;
+    icon.height = image.height;
+    Resolve(icon);
+    return icon;
+}
+
+void IconAtlas::Remove(IconTexture& icon)
+{
+    if (!icon.IsValid()) return;
+
+    m_entries[icon.atlasId] = Entry();
+    m_freeIds.push_back(icon.atlasId);
+    m_iconCount--;
+    icon = IconTexture();
+
+    // Compacted in NewFrame(), so deleting several apps costs one repack
+    m_repackPending = true;
+}
+
+void IconAtlas::Resolve(IconTexture& icon) const
+{
+    if (!icon.IsValid() || !m_texture || icon.generation == m_generation) return;
+
+    const Entry& entry = m_entries[icon.atlasId];
+    float width = (float)m_texture->Width;
+    float height = (float)m_texture->Height;
+    icon.uv0 = ImVec2(entry.x / width, entry.y / height);
+    icon.uv1 = ImVec2((entry.x + entry.width) / width, (entry.y + entry.height) / height);
+    icon.generation = m_generation;
+}
+
+ImTextureRef IconAtlas::TexRef() const
+{
+    return m_texture ? m_texture->GetTexRef() : ImTextureRef();
+}
+
+int IconAtlas::Width() const
+{
+    return m_texture ? m_texture->Width : 0;
+}
+
+int IconAtlas::Height() const
+{
+    return m_texture ? m_texture->Height : 0;
+}
+
+void IconAtlas::NewFrame()
+{
+    if (m_repackPending) {
+        // Smallest atlas that holds the remaining icons
+        m_repackPending = false;
+        Rebuild(INITIAL_SIZE, INITIAL_SIZE);
+    }
+
+    if (m_texture) {
+        if (m_texture->Status == ImTextureStatus_OK) {
+            // Backend has uploaded everything queued so far
+            m_texture->Updates.clear();
+            m_texture->UpdateRect.x = m_texture->UpdateRect.y = (unsigned short)~0;
+            m_texture->UpdateRect.w = m_texture->UpdateRect.h = 0;
+        }
+        else if (m_texture->Status == ImTextureStatus_Destroyed) {
+            // The backend dropped its device objects; the pixels are still here
+            m_texture->SetStatus(ImTextureStatus_WantCreate);
+        }
+    }
+
+    // Replaced textures may still have been drawn last frame, so they are only destroyed from here on
+    for (size_t i = 0; i < m_retired.size();) {
+        ImTextureData* texture = m_retired[i];
+        if (texture->Status == ImTextureStatus_Destroyed || texture->TexID == ImTextureID_Invalid) {
+            ImGui::UnregisterUserTexture(texture);
+            IM_DELETE(texture);
+            m_retired.erase(m_retired.begin() + i);
+            continue;
+        }
+        if (texture->Status != ImTextureStatus_WantDestroy) {
+            texture->SetStatus(ImTextureStatus_WantDestroy);
+            texture->UnusedFrames = 1;
+        }
+        i++;
+    }
+}
+
+int IconAtlas::AllocateEntry()
+{
+    if (!m_freeIds.empty()) {
+        int id = m_freeIds.back();
+        m_freeIds.pop_back();
+        return id;
+    }
+    m_entries.emplace_back();
+    return (int)m_entries.size() - 1;
+}
+
+bool IconAtlas::PackIncremental(Entry& entry)
+{
+    stbrp_rect rect = {};
+    rect.w = entry.width + 2 * PADDING;
+    rect.h = entry.height + 2 * PADDING;
+    stbrp_pack_rects(&m_packer->context, &rect, 1);
+    if (!rect.was_packed) return false;
+
+    entry.x = rect.x + PADDING;
+    entry.y = rect.y + PADDING;
+    return true;
+}
+
+bool IconAtlas::Rebuild(int width, int height)
+{
+    std::vector<stbrp_rect> rects;
+    for (size_t i = 0; i < m_entries.size(); i++) {
+        if (!m_entries[i].used) continue;
+        stbrp_rect rect = {};
+        rect.id = (int)i;
+        rect.w = m_entries[i].width + 2 * PADDING;
+        rect.h = m_entries[i].height + 2 * PADDING;
+        rects.push_back(rect);
+    }
+
+    // Double one side at a time until everything fits
+    for (;;) {
+        m_packer->Init(width, height);
+        if (stbrp_pack_rects(&m_packer->context, rects.data(), (int)rects.size())) break;
+        if (width >= MAX_SIZE && height >= MAX_SIZE) return false;
+        if (width <= height) width *= 2;
+        else height *= 2;
+    }
+
+    for (const stbrp_rect& rect : rects) {
+        m_entries[rect.id].x = rect.x + PADDING;
+        m_entries[rect.id].y = rect.y + PADDING;
+    }
+
+    if (m_texture) Retire(m_texture);
+    m_texture = IM_NEW(ImTextureData)();
+    m_texture->Create(ImTextureFormat_RGBA32, width, height);
+    m_texture->UseColors = true;
+    m_texture->RefCount = 1;
+    m_texture->SetStatus(ImTextureStatus_WantCreate);
+    ImGui::RegisterUserTexture(m_texture);
+
+    // Uploaded with the create request, no per-icon updates needed
+    for (const Entry& entry : m_entries) {
+        if (entry.used) Blit(entry, false);
+    }
+    m_generation++;
+    return true;
+}
+
+void IconAtlas::Blit(const Entry& entry, bool queueUpload)
+{
+    size_t rowBytes = (size_t)entry.width * 4;
+    for (int row = 0; row < entry.height; row++) {
+        memcpy(m_texture->GetPixelsAt(entry.x, entry.y + row), entry.Pixels() + row * rowBytes, rowBytes);
+    }
+
+    ImTextureRect rect = { (unsigned short)entry.x, (unsigned short)entry.y, (unsigned short)entry.width, (unsigned short)entry.height };
+    ImTextureRect& used = m_texture->UsedRect;
+    if (used.w == 0 || used.h == 0) {
+        used = rect;
+    }
+    else {
+        int right = ImMax(used.x + used.w, rect.x + rect.w);
+        int bottom = ImMax(used.y + used.h, rect.y + rect.h);
+        used.x = ImMin(used.x, rect.x);
+        used.y = ImMin(used.y, rect.y);
+        used.w = (unsigned short)(right - used.x);
+        used.h = (unsigned short)(bottom - used.y);
+    }
+
+    // A texture still waiting to be created is uploaded whole
+    if (!queueUpload) return;
+    if (m_texture->Status != ImTextureStatus_OK && m_texture->Status != ImTextureStatus_WantUpdates) return;
+
+    ImTextureRect& update = m_texture->UpdateRect;
+    int right = ImMax(update.w == 0 ? 0 : update.x + update.w, rect.x + rect.w);
+    int bottom = ImMax(update.h == 0 ? 0 : update.y + update.h, rect.y + rect.h);
+    update.x = ImMin(update.x, rect.x);
+    update.y = ImMin(update.y, rect.y);
+    update.w = (unsigned short)(right - update.x);
+    update.h = (unsigned short)(bottom - update.y);
+    m_texture->Updates.push_back(rect);
+    m_texture->SetStatus(ImTextureStatus_WantUpdates);
+}
+
+void IconAtlas::Retire(ImTextureData* texture)
+{
+    m_retired.push_back(texture);
+}
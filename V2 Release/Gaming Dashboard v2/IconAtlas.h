@@ -0,0 +1,90 @@
+#pragma once
+
+#include "imgui.h"
+
+#include <memory>
+#include <vector>
+
+struct ImageView;
+
+// An icon's place in the atlas. UVs are refreshed by IconAtlas::Resolve() after the atlas is repacked.
+struct IconTexture {
+    int atlasId = -1;
+    unsigned int generation = 0;
+    ImVec2 uv0;
+    ImVec2 uv1;
+    int width = 0;
+    int height = 0;
+
+    bool IsValid() const { return atlasId >= 0; }
+};
+
+// All icons packed into one RGBA texture (stb_rect_pack skyline packer) so they share a single draw call.
+// The texture is handed to the ImGui renderer backend as a user texture; create, update and destroy
+// requests go through ImTextureData, so nothing here is tied to D3D11. UI thread only.
+class IconAtlas {
+public:
+    static const int INITIAL_SIZE = 256;
+    static const int MAX_SIZE = 4096;
+    // Gap between icons so bilinear filtering does not bleed neighbours in
+    static const int PADDING = 1;
+
+    IconAtlas();
+    ~IconAtlas();
+
+    IconAtlas(const IconAtlas&) = delete;
+    IconAtlas& operator=(const IconAtlas&) = delete;
+
+    // Copies the image in, growing the atlas if needed. Returns an invalid icon if the image is
+    // empty or larger than the atlas can ever be.
+    IconTexture Add(const ImageView& image);
+    // Same, but keeps pointing at the caller's pixels for later repacks instead of copying them.
+    // The pixels (e.g. the icon cache mapping) must outlive the atlas.
+    IconTexture AddShared(const ImageView& image);
+    // Frees the icon's space; the remaining icons are repacked at the next NewFrame()
+    void Remove(IconTexture& icon);
+    // Updates the icon's UVs if the atlas was grown or repacked since they were read
+    void Resolve(IconTexture& icon) const;
+
+    ImTextureRef TexRef() const;
+    int Width() const;
+    int Height() const;
+    int IconCount() const { return m_iconCount; }
+
+    // Once per frame before icons are drawn: repacks after removals, clears uploaded regions and
+    // releases replaced textures
+    void NewFrame();
+
+private:
+    struct Entry {
+        // Kept for repacking: a private copy, or the caller's pixels for AddShared()
+        std::vector<unsigned char> owned;
+        const unsigned char* shared = nullptr;
+        int width = 0;
+        int height = 0;
+        int x = 0;
+        int y = 0;
+        bool used = false;
+
+        const unsigned char* Pixels() const { return shared ? shared : owned.data(); }
+    };
+
+    struct Packer;
+
+    IconTexture Insert(const ImageView& image, bool copy);
+    int AllocateEntry();
+    bool PackIncremental(Entry& entry);
+    bool Rebuild(int width, int height);
+    void Blit(const Entry& entry, bool queueUpload);
+    void Retire(ImTextureData* texture);
+
+    std::vector<Entry> m_entries;
+    std::vector<int> m_freeIds;
+    int m_iconCount = 0;
+    std::unique_ptr<Packer> m_packer;
+    ImTextureData* m_texture = nullptr;
+    // Replaced textures waiting for the backend to destroy them
+    std::vector<ImTextureData*> m_retired;
+    unsigned int m_generation = 1;
+    bool m_repackPending = false;
+};
@@ -0,0 +1,289 @@
+#include "IconCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// File layout: Header, Record[recordCount], path bytes, then 16-byte aligned RGBA blobs
+struct IconCache::Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordCount;
+    uint64_t fileSize;
+    uint64_t indexChecksum;  // over the records and path bytes
+};
+
+struct IconCache::Record {
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    uint32_t pathOffset;
+    uint32_t pathLength;
+    int32_t targetSize;
+    int32_t width;
+    int32_t height;
+    uint32_t reserved;
+    uint64_t pixelOffset;
+};
+
+static const char CACHE_MAGIC[8] = { 'G', 'D', 'I', 'C', 'O', 'N', 'S', '\0' };
+static const int MAX_CACHED_DIMENSION = 16384;
+
+static uint64_t Fnv1a(const unsigned char* data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static std::string LookupKey(const std::string& path, int targetSize)
+{
+    return path + '|' + std::to_string(targetSize);
+}
+
+static bool StatSource(const std::string& path, uint64_t* size, int64_t* mtime)
+{
+    std::error_code error;
+    std::filesystem::path source(path);
+    uintmax_t fileSize = std::filesystem::file_size(source, error);
+    if (error) return false;
+    std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(source, error);
+    if (error) return false;
+    *size = (uint64_t)fileSize;
+    *mtime = (int64_t)writeTime.time_since_epoch().count();
+    return true;
+}
+
+static size_t AlignUp(size_t value, size_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+IconCache::IconCache(std::string filePath)
+    : m_filePath(std::move(filePath))
+{
+}
+
+IconCache::~IconCache()
+{
+    Close();
+}
+
+bool IconCache::Open()
+{
+    Close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(m_filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(Header)) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_data = (const unsigned char*)view;
+    m_size = (size_t)fileSize.QuadPart;
+#else
+    int fd = open(m_filePath.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(Header)) {
+        close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) return false;
+    m_data = (const unsigned char*)view;
+    m_size = (size_t)info.st_size;
+#endif
+
+    if (!Validate()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void IconCache::Close()
+{
+    m_lookup.clear();
+    Unmap();
+}
+
+void IconCache::Unmap()
+{
+#ifdef _WIN32
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle((HANDLE)m_mapping);
+    if (m_file) CloseHandle((HANDLE)m_file);
+    m_mapping = nullptr;
+    m_file = nullptr;
+#else
+    if (m_data) munmap((void*)m_data, m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool IconCache::Validate()
+{
+    Header header;
+    memcpy(&header, m_data, sizeof(header));
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0) return false;
+    if (header.version != VERSION) return false;
+    // Catches truncated and appended-to files
+    if (header.fileSize != m_size) return false;
+
+    if (header.recordCount > (m_size - sizeof(Header)) / sizeof(Record)) return false;
+    size_t recordBytes = (size_t)header.recordCount * sizeof(Record);
+    const Record* records = (const Record*)(m_data + sizeof(Header));
+
+    // Path bytes run from the end of the records to the first pixel blob
+    size_t pathsBegin = sizeof(Header) + recordBytes;
+    size_t pathsEnd = pathsBegin;
+    for (uint32_t i = 0; i < header.recordCount; i++) {
+        const Record& record = records[i];
+        if (record.pathOffset < pathsBegin || record.pathOffset > m_size) return false;
+        if (record.pathLength > m_size - record.pathOffset) return false;
+        pathsEnd = std::max(pathsEnd, (size_t)record.pathOffset + record.pathLength);
+    }
+    if (Fnv1a(m_data + sizeof(Header), pathsEnd - sizeof(Header)) != header.indexChecksum) return false;
+
+    for (uint32_t i = 0; i < header.recordCount; i++) {
+        const Record& record = records[i];
+        if (record.width <= 0 || record.height <= 0) return false;
+        if (record.width > MAX_CACHED_DIMENSION || record.height > MAX_CACHED_DIMENSION) return false;
+        size_t pixelBytes = (size_t)record.width * record.height * 4;
+        if (record.pixelOffset < pathsEnd || record.pixelOffset > m_size || record.pixelOffset % 16 != 0) return false;
+        if (pixelBytes > m_size - record.pixelOffset) return false;
+
+        std::string path((const char*)m_data + record.pathOffset, record.pathLength);
+        m_lookup[LookupKey(path, record.targetSize)] = i;
+    }
+    return true;
+}
+
+ImageView IconCache::Lookup(const std::string& path, int targetSize) const
+{
+    ImageView view;
+    auto it = m_lookup.find(LookupKey(path, targetSize));
+    if (it == m_lookup.end()) return view;
+
+    const Record* records = (const Record*)(m_data + sizeof(Header));
+    const Record& record = records[it->second];
+    uint64_t sourceSize;
+    int64_t sourceMtime;
+    if (!StatSource(path, &sourceSize, &sourceMtime)) return view;
+    if (sourceSize != record.sourceSize || sourceMtime != record.sourceMtime) return view;
+
+    view.pixels = m_data + record.pixelOffset;
+    view.width = record.width;
+    view.height = record.height;
+    return view;
+}
+
+bool IconCache::Write(const std::vector<IconCacheEntry>& entries)
+{
+    // Lay out the file: records and paths first, then the blobs
+    std::vector<Record> records;
+    std::vector<const IconCacheEntry*> stored;
+    std::unordered_set<std::string> seen;
+    for (const IconCacheEntry& entry : entries) {
+        if (!entry.image.IsValid()) continue;
+        if (!seen.insert(LookupKey(entry.path, entry.targetSize)).second) continue;
+
+        Record record = {};
+        if (!StatSource(entry.path, &record.sourceSize, &record.sourceMtime)) continue;
+        record.pathLength = (uint32_t)entry.path.size();
+        record.targetSize = entry.targetSize;
+        record.width = entry.image.width;
+        record.height = entry.image.height;
+        records.push_back(record);
+        stored.push_back(&entry);
+    }
+
+    size_t offset = sizeof(Header) + records.size() * sizeof(Record);
+    for (size_t i = 0; i < records.size(); i++) {
+        records[i].pathOffset = (uint32_t)offset;
+        offset += records[i].pathLength;
+    }
+    size_t pathsEnd = offset;
+    for (size_t i = 0; i < records.size(); i++) {
+        offset = AlignUp(offset, 16);
+        records[i].pixelOffset = offset;
+        offset += (size_t)records[i].width * records[i].height * 4;
+    }
+
+    std::string index((const char*)records.data(), records.size() * sizeof(Record));
+    for (const IconCacheEntry* entry : stored) index += entry->path;
+
+    Header header = {};
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = VERSION;
+    header.recordCount = (uint32_t)records.size();
+    header.fileSize = offset;
+    header.indexChecksum = Fnv1a((const unsigned char*)index.data(), index.size());
+
+    std::string tempPath = m_filePath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write((const char*)&header, sizeof(header));
+        out.write(index.data(), index.size());
+
+        static const char padding[16] = {};
+        size_t position = pathsEnd;
+        for (size_t i = 0; i < records.size(); i++) {
+            out.write(padding, records[i].pixelOffset - position);
+            size_t pixelBytes = (size_t)records[i].width * records[i].height * 4;
+            out.write((const char*)stored[i]->image.pixels, pixelBytes);
+            position = records[i].pixelOffset + pixelBytes;
+        }
+        out.flush();
+        if (!out) {
+            out.close();
+            std::error_code error;
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+    }
+
+    // Windows cannot replace a file that is still mapped
+    Close();
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, m_filePath, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
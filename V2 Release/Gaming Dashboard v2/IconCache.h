@@ -0,0 +1,62 @@
+#pragma once
+
+#include "IconLoader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// An icon to store in the cache
+struct IconCacheEntry {
+    std::string path;
+    int targetSize = 0;  // 0 = source resolution
+    ImageView image;
+};
+
+// Memory-mapped file of decoded RGBA icons keyed by (source path, source size, source mtime, target size).
+// Lookups return views straight into the mapping, so a warm start does no decoding and no copying.
+// A missing, truncated or otherwise corrupt file just behaves like an empty cache.
+class IconCache {
+public:
+    static const uint32_t VERSION = 1;
+
+    explicit IconCache(std::string filePath);
+    ~IconCache();
+
+    IconCache(const IconCache&) = delete;
+    IconCache& operator=(const IconCache&) = delete;
+
+    // Maps the cache file. Returns false (and stays empty) if it is missing or fails validation.
+    bool Open();
+    void Close();
+    bool IsOpen() const { return m_data != nullptr; }
+    size_t EntryCount() const { return m_lookup.size(); }
+
+    // Pixels of the cached icon, valid while the cache stays open. Returns an invalid view if the
+    // icon is not cached or the source file's size or mtime no longer match.
+    ImageView Lookup(const std::string& path, int targetSize) const;
+
+    // Replaces the cache file with these entries, writing a temp file and renaming it over the old one.
+    // Entries may point into the current mapping; it is closed before the rename.
+    bool Write(const std::vector<IconCacheEntry>& entries);
+
+private:
+    struct Header;
+    struct Record;
+
+    bool Validate();
+    void Unmap();
+
+    std::string m_filePath;
+    const unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+    // (path, target size) -> record index
+    std::unordered_map<std::string, size_t> m_lookup;
+
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
@@ -0,0 +1,43 @@
+#include "IconLoader.h"
+
+#include "Executor.h"
+// The one translation unit that compiles stb_image
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <condition_variable>
+#include <mutex>
+
+void DecodedImage::Deleter::operator()(unsigned char* pixels) const
+{
+    stbi_image_free(pixels);
+}
+
+DecodedImage DecodeImage(const std::string& path)
+{
+    DecodedImage image;
+    if (path.empty()) return image;
+    image.pixels.reset(stbi_load(path.c_str(), &image.width, &image.height, nullptr, 4));
+    return image;
+}
+
+std::vector<DecodedImage> DecodeImages(Executor& executor, const std::vector<std::string>& paths)
+{
+    std::vector<DecodedImage> images(paths.size());
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t remaining = paths.size();
+
+    // Each job writes only its own slot, so only the counter needs the lock
+    for (size_t i = 0; i < paths.size(); i++) {
+        executor.Post([&, i]() {
+            images[i] = DecodeImage(paths[i]);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--remaining == 0) done.notify_one();
+        });
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&]() { return remaining == 0; });
+    return images;
+}
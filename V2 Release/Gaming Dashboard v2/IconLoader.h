@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class Executor;
+
+// Borrowed RGBA8 pixels, e.g. a decoded image or a blob inside the icon cache mapping
+struct ImageView {
+    const unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+
+    bool IsValid() const { return pixels != nullptr && width > 0 && height > 0; }
+};
+
+// RGBA8 pixels straight from stb_image (no copy)
+struct DecodedImage {
+    struct Deleter {
+        void operator()(unsigned char* pixels) const;
+    };
+
+    std::unique_ptr<unsigned char[], Deleter> pixels;
+    int width = 0;
+    int height = 0;
+
+    bool IsValid() const { return pixels != nullptr; }
+    ImageView View() const { return { pixels.get(), width, height }; }
+};
+
+DecodedImage DecodeImage(const std::string& path);
+
+// Decodes every file on the executor's workers and waits for all of them.
+// Results are in the same order as paths; files that fail to load give an invalid image.
+std::vector<DecodedImage> DecodeImages(Executor& executor, const std::vector<std::string>& paths);
@@ -0,0 +1,388 @@
+#include "ImageResample.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define RESAMPLE_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// MSVC emits AVX2 intrinsics without a flag; GCC/Clang need the function tagged
+#if defined(RESAMPLE_X86) && !defined(_MSC_VER)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+namespace {
+
+const float PI = 3.14159265358979f;
+const int LANCZOS_RADIUS = 3;
+
+// Per output pixel: `taps` weights starting at source index first[i]. Short windows are zero padded.
+struct Kernel {
+    int taps = 0;
+    std::vector<int> first;
+    std::vector<float> weights;
+};
+
+float Sinc(float x)
+{
+    if (x == 0.0f) return 1.0f;
+    x *= PI;
+    return std::sin(x) / x;
+}
+
+float Lanczos(float x)
+{
+    if (x <= -LANCZOS_RADIUS || x >= LANCZOS_RADIUS) return 0.0f;
+    return Sinc(x) * Sinc(x / LANCZOS_RADIUS);
+}
+
+Kernel BuildKernel(int sourceSize, int targetSize, ResampleFilter filter)
+{
+    float scale = (float)sourceSize / targetSize;
+    // Widen the filter when minifying so every source pixel contributes
+    float stretch = std::max(scale, 1.0f);
+
+    std::vector<std::vector<float>> windows(targetSize);
+    std::vector<int> starts(targetSize);
+    int taps = 0;
+    for (int i = 0; i < targetSize; i++) {
+        int lo;
+        int hi;
+        std::vector<float>& window = windows[i];
+        if (filter == ResampleFilter::Box) {
+            // Exact coverage of [i, i + 1) mapped into the source
+            float begin = i * scale;
+            float end = (i + 1) * scale;
+            lo = (int)std::floor(begin);
+            hi = std::min((int)std::ceil(end) - 1, sourceSize - 1);
+            for (int j = lo; j <= hi; j++) {
+                window.push_back(std::min(end, (float)(j + 1)) - std::max(begin, (float)j));
+            }
+        }
+        else {
+            float center = (i + 0.5f) * scale - 0.5f;
+            float support = LANCZOS_RADIUS * stretch;
+            lo = std::max((int)std::ceil(center - support), 0);
+            hi = std::min((int)std::floor(center + support), sourceSize - 1);
+            for (int j = lo; j <= hi; j++) {
+                window.push_back(Lanczos((j - center) / stretch));
+            }
+        }
+
+        float sum = 0.0f;
+        for (float weight : window) sum += weight;
+        if (sum != 0.0f) {
+            for (float& weight : window) weight /= sum;
+        }
+        starts[i] = lo;
+        taps = std::max(taps, (int)window.size());
+    }
+
+    Kernel kernel;
+    kernel.taps = taps;
+    kernel.first.resize(targetSize);
+    kernel.weights.assign((size_t)targetSize * taps, 0.0f);
+    for (int i = 0; i < targetSize; i++) {
+        // Shift windows that would run off the end left, padding with zero weights in front
+        int first = std::min(starts[i], sourceSize - taps);
+        int offset = starts[i] - first;
+        kernel.first[i] = first;
+        std::copy(windows[i].begin(), windows[i].end(), kernel.weights.begin() + (size_t)i * taps + offset);
+    }
+    return kernel;
+}
+
+// Straight RGBA8 -> premultiplied float RGBA (colour * alpha / 255, alpha kept in 0..255)
+void PremultiplyScalar(const unsigned char* in, float* out, size_t pixels)
+{
+    for (size_t i = 0; i < pixels; i++) {
+        const unsigned char* pixel = in + i * 4;
+        float alpha = pixel[3] * (1.0f / 255.0f);
+        out[i * 4 + 0] = pixel[0] * alpha;
+        out[i * 4 + 1] = pixel[1] * alpha;
+        out[i * 4 + 2] = pixel[2] * alpha;
+        out[i * 4 + 3] = pixel[3];
+    }
+}
+
+// Horizontal pass: for each row, out[x] = sum of weight * in[first + k], one RGBA pixel at a time
+void HorizontalScalar(const float* in, int inWidth, float* out, int outWidth, int rows, const Kernel& kernel)
+{
+    for (int y = 0; y < rows; y++) {
+        const float* row = in + (size_t)y * inWidth * 4;
+        float* outRow = out + (size_t)y * outWidth * 4;
+        for (int x = 0; x < outWidth; x++) {
+            const float* weights = &kernel.weights[(size_t)x * kernel.taps];
+            const float* pixel = row + (size_t)kernel.first[x] * 4;
+            float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            for (int k = 0; k < kernel.taps; k++) {
+                for (int c = 0; c < 4; c++) acc[c] = acc[c] + pixel[k * 4 + c] * weights[k];
+            }
+            for (int c = 0; c < 4; c++) outRow[x * 4 + c] = acc[c];
+        }
+    }
+}
+
+// Vertical pass: out row = sum of weight * in row (first + k), across the whole row
+void VerticalScalar(const float* in, int rowFloats, float* out, int outRows, const Kernel& kernel)
+{
+    for (int y = 0; y < outRows; y++) {
+        const float* weights = &kernel.weights[(size_t)y * kernel.taps];
+        const float* rows = in + (size_t)kernel.first[y] * rowFloats;
+        float* outRow = out + (size_t)y * rowFloats;
+        for (int i = 0; i < rowFloats; i++) {
+            float acc = 0.0f;
+            for (int k = 0; k < kernel.taps; k++) acc = acc + rows[(size_t)k * rowFloats + i] * weights[k];
+            outRow[i] = acc;
+        }
+    }
+}
+
+#ifdef RESAMPLE_X86
+void PremultiplySSE2(const unsigned char* in, float* out, size_t pixels)
+{
+    const __m128i zero = _mm_setzero_si128();
+    // Alpha lane is multiplied by 1 instead of alpha / 255
+    const __m128 alphaLane = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+    for (size_t i = 0; i < pixels; i++) {
+        int packed;
+        memcpy(&packed, in + i * 4, 4);
+        __m128i wide = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+        __m128 values = _mm_cvtepi32_ps(wide);
+        __m128 alpha = _mm_mul_ps(_mm_shuffle_ps(values, values, _MM_SHUFFLE(3, 3, 3, 3)), _mm_set1_ps(1.0f / 255.0f));
+        __m128 scale = _mm_or_ps(_mm_andnot_ps(alphaLane, alpha), _mm_and_ps(alphaLane, _mm_set1_ps(1.0f)));
+        _mm_storeu_ps(out + i * 4, _mm_mul_ps(values, scale));
+    }
+}
+
+// One RGBA pixel per __m128
+void HorizontalSSE2(const float* in, int inWidth, float* out, int outWidth, int rows, const Kernel& kernel)
+{
+    for (int y = 0; y < rows; y++) {
+        const float* row = in + (size_t)y * inWidth * 4;
+        float* outRow = out + (size_t)y * outWidth * 4;
+        for (int x = 0; x < outWidth; x++) {
+            const float* weights = &kernel.weights[(size_t)x * kernel.taps];
+            const float* pixel = row + (size_t)kernel.first[x] * 4;
+            __m128 acc = _mm_setzero_ps();
+            for (int k = 0; k < kernel.taps; k++) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(pixel + k * 4), _mm_set1_ps(weights[k])));
+            }
+            _mm_storeu_ps(outRow + x * 4, acc);
+        }
+    }
+}
+
+void VerticalSSE2(const float* in, int rowFloats, float* out, int outRows, const Kernel& kernel)
+{
+    // rowFloats is a multiple of 4 (RGBA)
+    for (int y = 0; y < outRows; y++) {
+        const float* weights = &kernel.weights[(size_t)y * kernel.taps];
+        const float* rows = in + (size_t)kernel.first[y] * rowFloats;
+        float* outRow = out + (size_t)y * rowFloats;
+        for (int i = 0; i < rowFloats; i += 4) {
+            __m128 acc = _mm_setzero_ps();
+            for (int k = 0; k < kernel.taps; k++) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(rows + (size_t)k * rowFloats + i), _mm_set1_ps(weights[k])));
+            }
+            _mm_storeu_ps(outRow + i, acc);
+        }
+    }
+}
+
+// Two output pixels per __m256; odd widths finish with one SSE pixel
+TARGET_AVX2 void HorizontalAVX2(const float* in, int inWidth, float* out, int outWidth, int rows, const Kernel& kernel)
+{
+    for (int y = 0; y < rows; y++) {
+        const float* row = in + (size_t)y * inWidth * 4;
+        float* outRow = out + (size_t)y * outWidth * 4;
+        int x = 0;
+        for (; x + 2 <= outWidth; x += 2) {
+            const float* weights0 = &kernel.weights[(size_t)x * kernel.taps];
+            const float* weights1 = weights0 + kernel.taps;
+            const float* pixel0 = row + (size_t)kernel.first[x] * 4;
+            const float* pixel1 = row + (size_t)kernel.first[x + 1] * 4;
+            __m256 acc = _mm256_setzero_ps();
+            for (int k = 0; k < kernel.taps; k++) {
+                __m256 pixels = _mm256_set_m128(_mm_loadu_ps(pixel1 + k * 4), _mm_loadu_ps(pixel0 + k * 4));
+                __m256 weights = _mm256_set_m128(_mm_set1_ps(weights1[k]), _mm_set1_ps(weights0[k]));
+                acc = _mm256_add_ps(acc, _mm256_mul_ps(pixels, weights));
+            }
+            _mm256_storeu_ps(outRow + x * 4, acc);
+        }
+        for (; x < outWidth; x++) {
+            const float* weights = &kernel.weights[(size_t)x * kernel.taps];
+            const float* pixel = row + (size_t)kernel.first[x] * 4;
+            __m128 acc = _mm_setzero_ps();
+            for (int k = 0; k < kernel.taps; k++) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(pixel + k * 4), _mm_set1_ps(weights[k])));
+            }
+            _mm_storeu_ps(outRow + x * 4, acc);
+        }
+    }
+}
+
+TARGET_AVX2 void VerticalAVX2(const float* in, int rowFloats, float* out, int outRows, const Kernel& kernel)
+{
+    for (int y = 0; y < outRows; y++) {
+        const float* weights = &kernel.weights[(size_t)y * kernel.taps];
+        const float* rows = in + (size_t)kernel.first[y] * rowFloats;
+        float* outRow = out + (size_t)y * rowFloats;
+        int i = 0;
+        for (; i + 8 <= rowFloats; i += 8) {
+            __m256 acc = _mm256_setzero_ps();
+            for (int k = 0; k < kernel.taps; k++) {
+                acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(rows + (size_t)k * rowFloats + i), _mm256_set1_ps(weights[k])));
+            }
+            _mm256_storeu_ps(outRow + i, acc);
+        }
+        for (; i < rowFloats; i += 4) {
+            __m128 acc = _mm_setzero_ps();
+            for (int k = 0; k < kernel.taps; k++) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(rows + (size_t)k * rowFloats + i), _mm_set1_ps(weights[k])));
+            }
+            _mm_storeu_ps(outRow + i, acc);
+        }
+    }
+}
+
+bool CpuHasAvx2()
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    // The OS must save YMM registers on context switches
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+}
+
+ResampleBackend BestResampleBackend()
+{
+#ifdef RESAMPLE_X86
+    static const bool avx2 = CpuHasAvx2();
+    if (avx2) return ResampleBackend::AVX2;
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    return ResampleBackend::SSE2;
+#endif
+#endif
+    return ResampleBackend::Scalar;
+}
+
+const char* ResampleBackendName(ResampleBackend backend)
+{
+    switch (backend) {
+    case ResampleBackend::Auto: return ResampleBackendName(BestResampleBackend());
+    case ResampleBackend::Scalar: return "scalar";
+    case ResampleBackend::SSE2: return "SSE2";
+    case ResampleBackend::AVX2: return "AVX2";
+    }
+    return "unknown";
+}
+
+ResampledImage Resample(const ImageView& source, int width, int height, ResampleFilter filter, ResampleBackend backend)
+{
+    ResampledImage result;
+    if (!source.IsValid() || width <= 0 || height <= 0) return result;
+    if (backend == ResampleBackend::Auto) backend = BestResampleBackend();
+#ifndef RESAMPLE_X86
+    backend = ResampleBackend::Scalar;
+#endif
+
+    size_t sourcePixels = (size_t)source.width * source.height;
+    std::vector<float> input(sourcePixels * 4);
+
+    Kernel horizontal = BuildKernel(source.width, width, filter);
+    Kernel vertical = BuildKernel(source.height, height, filter);
+    std::vector<float> columns((size_t)source.height * width * 4);
+    std::vector<float> output((size_t)height * width * 4);
+
+    switch (backend) {
+#ifdef RESAMPLE_X86
+    case ResampleBackend::AVX2:
+        PremultiplySSE2(source.pixels, input.data(), sourcePixels);
+        HorizontalAVX2(input.data(), source.width, columns.data(), width, source.height, horizontal);
+        VerticalAVX2(columns.data(), width * 4, output.data(), height, vertical);
+        break;
+    case ResampleBackend::SSE2:
+        PremultiplySSE2(source.pixels, input.data(), sourcePixels);
+        HorizontalSSE2(input.data(), source.width, columns.data(), width, source.height, horizontal);
+        VerticalSSE2(columns.data(), width * 4, output.data(), height, vertical);
+        break;
+#endif
+    default:
+        PremultiplyScalar(source.pixels, input.data(), sourcePixels);
+        HorizontalScalar(input.data(), source.width, columns.data(), width, source.height, horizontal);
+        VerticalScalar(columns.data(), width * 4, output.data(), height, vertical);
+        break;
+    }
+
+    // Back to straight alpha; Lanczos lobes can overshoot, so clamp
+    result.width = width;
+    result.height = height;
+    result.pixels.resize((size_t)width * height * 4);
+    for (size_t i = 0; i < (size_t)width * height; i++) {
+        float alpha = std::min(std::max(output[i * 4 + 3], 0.0f), 255.0f);
+        unsigned char* pixel = &result.pixels[i * 4];
+        if (alpha < 0.5f) {
+            pixel[0] = pixel[1] = pixel[2] = pixel[3] = 0;
+            continue;
+        }
+        float unpremultiply = 255.0f / alpha;
+        for (int c = 0; c < 3; c++) {
+            float value = output[i * 4 + c] * unpremultiply;
+            pixel[c] = (unsigned char)(std::min(std::max(value, 0.0f), 255.0f) + 0.5f);
+        }
+        pixel[3] = (unsigned char)(alpha + 0.5f);
+    }
+    return result;
+}
+
+ResampledImage ResampleToFit(const ImageView& source, int maxSize, ResampleFilter filter, ResampleBackend backend)
+{
+    if (!source.IsValid() || maxSize <= 0) return ResampledImage();
+
+    int width = source.width;
+    int height = source.height;
+    if (width > maxSize || height > maxSize) {
+        if (width >= height) {
+            height = std::max(1, (int)std::lround((double)height * maxSize / width));
+            width = maxSize;
+        }
+        else {
+            width = std::max(1, (int)std::lround((double)width * maxSize / height));
+            height = maxSize;
+        }
+    }
+    return Resample(source, width, height, filter, backend);
+}
+
+std::vector<ResampledImage> BuildMipChain(const ImageView& base, ResampleBackend backend)
+{
+    std::vector<ResampledImage> levels;
+    ImageView level = base;
+    while (level.IsValid() && (level.width > 1 || level.height > 1)) {
+        levels.push_back(Resample(level, std::max(1, level.width / 2), std::max(1, level.height / 2), ResampleFilter::Box, backend));
+        level = levels.back().View();
+    }
+    return levels;
+}
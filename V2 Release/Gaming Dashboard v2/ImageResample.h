@@ -0,0 +1,43 @@
+#pragma once
+
+#include "IconLoader.h"
+
+#include <vector>
+
+enum class ResampleFilter {
+    Box,       // area average; cheap, soft
+    Lanczos3,  // sharper, slight ringing
+};
+
+enum class ResampleBackend {
+    Auto,  // best one the CPU supports
+    Scalar,
+    SSE2,
+    AVX2,
+};
+
+// Owned RGBA8 image produced by resampling
+struct ResampledImage {
+    std::vector<unsigned char> pixels;
+    int width = 0;
+    int height = 0;
+
+    bool IsValid() const { return !pixels.empty(); }
+    ImageView View() const { return { pixels.data(), width, height }; }
+};
+
+// Backend that Auto resolves to on this CPU
+ResampleBackend BestResampleBackend();
+const char* ResampleBackendName(ResampleBackend backend);
+
+// Separable resample in premultiplied alpha, so transparent edges do not darken. Every backend
+// accumulates in the same order, so SIMD output matches the scalar reference exactly.
+ResampledImage Resample(const ImageView& source, int width, int height, ResampleFilter filter,
+    ResampleBackend backend = ResampleBackend::Auto);
+
+// Scales down to fit in maxSize x maxSize keeping the aspect ratio. Never upscales.
+ResampledImage ResampleToFit(const ImageView& source, int maxSize, ResampleFilter filter,
+    ResampleBackend backend = ResampleBackend::Auto);
+
+// Box-filtered halvings of base down to 1x1, not including base itself
+std::vector<ResampledImage> BuildMipChain(const ImageView& base, ResampleBackend backend = ResampleBackend::Auto);
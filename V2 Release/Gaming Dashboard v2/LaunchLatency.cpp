@@ -0,0 +1,171 @@
+#include "LaunchLatency.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// LatencyHistogram
+int LatencyHistogram::BucketOf(uint32_t ms)
+{
+    if (ms > MAX_MS) ms = MAX_MS;
+    if (ms < (uint32_t)SUB_BUCKETS) return (int)ms;
+    // Shift so the value keeps SUB_BUCKET_BITS + 1 significant bits: its top bit and the sub-bucket
+    int bits = 32;
+    while (!(ms & (1u << (bits - 1)))) bits--;
+    int shift = bits - SUB_BUCKET_BITS - 1;
+    return (shift + 1) * SUB_BUCKETS + (int)((ms >> shift) - SUB_BUCKETS);
+}
+
+uint32_t LatencyHistogram::BucketTop(int bucket)
+{
+    if (bucket < SUB_BUCKETS) return (uint32_t)bucket;
+    int shift = bucket / SUB_BUCKETS - 1;
+    uint32_t bottom = (uint32_t)(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+    return bottom + (1u << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint32_t ms)
+{
+    if (m_count >= DECAY_COUNT) {
+        m_count = 0;
+        for (uint32_t& count : m_buckets) {
+            count /= 2;
+            m_count += count;
+        }
+    }
+    m_buckets[BucketOf(ms)]++;
+    m_count++;
+}
+
+void LatencyHistogram::Clear()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+}
+
+uint32_t LatencyHistogram::Percentile(double p) const
+{
+    if (m_count == 0) return 0;
+    uint64_t rank = (uint64_t)std::ceil(std::clamp(p, 0.0, 1.0) * m_count);
+    if (rank == 0) rank = 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += m_buckets[i];
+        if (seen >= rank) return BucketTop(i);
+    }
+    return MAX_MS;
+}
+
+std::string LatencyHistogram::Format() const
+{
+    std::string text;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        if (m_buckets[i] == 0) continue;
+        if (!text.empty()) text += ' ';
+        text += std::to_string(i);
+        text += ':';
+        text += std::to_string(m_buckets[i]);
+    }
+    return text;
+}
+
+void LatencyHistogram::Parse(const std::string& text)
+{
+    Clear();
+    const char* cursor = text.c_str();
+    while (*cursor) {
+        char* end = nullptr;
+        unsigned long bucket = std::strtoul(cursor, &end, 10);
+        if (end == cursor || *end != ':') {
+            // Skip to the next pair
+            while (*cursor && *cursor != ' ') cursor++;
+            while (*cursor == ' ') cursor++;
+            continue;
+        }
+        cursor = end + 1;
+        unsigned long count = std::strtoul(cursor, &end, 10);
+        if (end != cursor && bucket < (unsigned long)BUCKET_COUNT) {
+            m_buckets[bucket] += (uint32_t)count;
+            m_count += (uint32_t)count;
+        }
+        cursor = end;
+        while (*cursor && *cursor != ' ') cursor++;
+        while (*cursor == ' ') cursor++;
+    }
+}
+
+// LaunchLatency
+const char* LaunchPhaseName(LaunchPhase phase)
+{
+    switch (phase) {
+    case LaunchPhase::ProcessStart: return "Process start";
+    case LaunchPhase::FirstWindow: return "First window";
+    case LaunchPhase::WindowReady: return "Window ready";
+    case LaunchPhase::Embedded: return "Embedded";
+    case LaunchPhase::Settle: return "Settle";
+    default: return "";
+    }
+}
+
+namespace {
+
+bool Reached(LaunchTimes::Clock::time_point time)
+{
+    return time != LaunchTimes::Clock::time_point();
+}
+
+uint32_t ElapsedMs(LaunchTimes::Clock::time_point from, LaunchTimes::Clock::time_point to)
+{
+    if (to <= from) return 0;
+    return (uint32_t)std::min<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count(), LatencyHistogram::MAX_MS);
+}
+
+}
+
+void LaunchLatency::Record(const std::string& app, const LaunchTimes& times)
+{
+    AppHistograms& histograms = m_apps[app];
+    // A window that matched but never went quiet is no ready window; the launch still failed
+    bool timedOut = Reached(times.windowTimedOut);
+    const LaunchTimes::Clock::time_point* milestones[] = { &times.processStarted, &times.firstWindow, &times.windowReady, &times.embedded };
+    for (int phase = 0; phase < 4; phase++) {
+        if (timedOut && phase == (int)LaunchPhase::WindowReady) continue;
+        if (Reached(*milestones[phase])) histograms[phase].Record(ElapsedMs(times.requested, *milestones[phase]));
+    }
+    if (!timedOut && Reached(times.windowMatched) && Reached(times.windowReady)) {
+        histograms[(size_t)LaunchPhase::Settle].Record(ElapsedMs(times.windowMatched, times.windowReady));
+    }
+
+    // A slow launch that gave up would otherwise leave no sample, and the timeout would never grow
+    if (!timedOut) {
+        if (Reached(times.windowReady)) m_backoffMs.erase(app);
+    } else {
+        histograms[(size_t)LaunchPhase::WindowReady].Record(ElapsedMs(times.requested, times.windowTimedOut));
+        uint64_t usedMs = ElapsedMs(times.processStarted, times.windowTimedOut);
+        m_backoffMs[app] = (int)std::min<uint64_t>(2 * std::max<uint64_t>(usedMs, MIN_WINDOW_TIMEOUT_MS), MAX_WINDOW_TIMEOUT_MS);
+    }
+}
+
+LaunchTimeouts LaunchLatency::Timeouts(const std::string& app) const
+{
+    LaunchTimeouts timeouts;
+    timeouts.windowMs = DEFAULT_WINDOW_TIMEOUT_MS;
+    timeouts.settleMs = DEFAULT_SETTLE_MS;
+    auto it = m_apps.find(app);
+    if (it == m_apps.end()) return timeouts;
+
+    // The ready time includes the wait before the process started, so the timeout errs on the long side
+    const LatencyHistogram& ready = it->second[(size_t)LaunchPhase::WindowReady];
+    if (ready.Count() >= MIN_SAMPLES) {
+        timeouts.windowMs = (int)std::clamp<uint64_t>(2ull * ready.Percentile(0.99), MIN_WINDOW_TIMEOUT_MS, MAX_WINDOW_TIMEOUT_MS);
+    }
+    auto backoff = m_backoffMs.find(app);
+    if (backoff != m_backoffMs.end()) timeouts.windowMs = std::max(timeouts.windowMs, backoff->second);
+    // A window that has always been ready as it appeared is embedded right away
+    const LatencyHistogram& settle = it->second[(size_t)LaunchPhase::Settle];
+    if (settle.Count() >= MIN_SAMPLES) {
+        uint32_t p99 = settle.Percentile(0.99);
+        timeouts.settleMs = settle.Percentile(0.95) == 0 ? 0 : (int)std::clamp<uint64_t>(2ull * p99, MIN_SETTLE_MS, MAX_SETTLE_MS);
+    }
+    return timeouts;
+}
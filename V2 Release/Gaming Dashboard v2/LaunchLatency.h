@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+// Durations in ms, HDR-style: exact below 32 ms, then 32 linear buckets per power of two, so any value
+// is kept to within about 3% however long it is. Percentiles report the top of their bucket, which errs
+// on the long side; that is the safe side for the timeouts they drive.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    // Longer values are recorded as this (about 4.6 hours)
+    static const uint32_t MAX_MS = (1u << 24) - 1;
+    static const int BUCKET_COUNT = SUB_BUCKETS * (24 - SUB_BUCKET_BITS + 1);
+    // Once this many values are recorded every bucket is halved, so recent launches outweigh old ones
+    static const uint32_t DECAY_COUNT = 1024;
+
+    void Record(uint32_t ms);
+    void Clear();
+
+    uint32_t Count() const { return m_count; }
+    // Smallest value at or above fraction p (0..1) of the recorded ones; 0 if there are none
+    uint32_t Percentile(double p) const;
+
+    // "bucket:count" pairs of the non-empty buckets, space separated
+    std::string Format() const;
+    // Replaces the contents; malformed pairs are skipped
+    void Parse(const std::string& text);
+
+private:
+    static int BucketOf(uint32_t ms);
+    static uint32_t BucketTop(int bucket);
+
+    std::array<uint32_t, BUCKET_COUNT> m_buckets{};
+    uint32_t m_count = 0;
+};
+
+// Milestones of a launch. Each histogram holds the time from the click (or profile start) to the
+// milestone, except Settle: how long the window kept changing after it first looked ready.
+enum class LaunchPhase {
+    ProcessStart,
+    FirstWindow,
+    WindowReady,
+    Embedded,
+    Settle,
+    Count,
+};
+
+const char* LaunchPhaseName(LaunchPhase phase);
+
+// Timestamps of one launch; the milestones it never reached stay default-constructed
+struct LaunchTimes {
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point requested;
+    Clock::time_point processStarted;
+    Clock::time_point firstWindow;
+    // The window passed the app's readiness check
+    Clock::time_point windowMatched;
+    // The window stopped changing
+    Clock::time_point windowReady;
+    Clock::time_point embedded;
+    // When the wait for a ready window ran out; left unset if the launch was cancelled
+    Clock::time_point windowTimedOut;
+};
+
+// How long a launch waits, from the app's recorded launches
+struct LaunchTimeouts {
+    // From process start until the window is ready to embed
+    int windowMs = 0;
+    // Longest wait for the window to stop changing; 0 embeds it as soon as it matches
+    int settleMs = 0;
+};
+
+// Per-app launch histograms, keyed by app name so they carry over between runs. UI thread only.
+class LaunchLatency {
+public:
+    // Until an app has this many launches it gets the defaults
+    static const uint32_t MIN_SAMPLES = 5;
+    static const int DEFAULT_WINDOW_TIMEOUT_MS = 15000;
+    static const int MIN_WINDOW_TIMEOUT_MS = 5000;
+    static const int MAX_WINDOW_TIMEOUT_MS = 120000;
+    static const int DEFAULT_SETTLE_MS = 3000;
+    static const int MIN_SETTLE_MS = 500;
+    static const int MAX_SETTLE_MS = 10000;
+    // A window that goes this long without changing has settled
+    static const int SETTLE_QUIET_MS = 150;
+
+    typedef std::array<LatencyHistogram, (size_t)LaunchPhase::Count> AppHistograms;
+
+    // A launch that timed out counts as ready at its deadline, and the next one waits twice as long
+    void Record(const std::string& app, const LaunchTimes& times);
+
+    // Twice the p99 of earlier launches, within limits, or longer right after a timeout
+    LaunchTimeouts Timeouts(const std::string& app) const;
+
+    const std::map<std::string, AppHistograms>& Apps() const { return m_apps; }
+    AppHistograms& App(const std::string& app) { return m_apps[app]; }
+    void Remove(const std::string& app) { m_apps.erase(app); m_backoffMs.erase(app); }
+
+private:
+    std::map<std::string, AppHistograms> m_apps;
+    // Window timeout after a launch timed out, until one succeeds; not saved
+    std::map<std::string, int> m_backoffMs;
+};
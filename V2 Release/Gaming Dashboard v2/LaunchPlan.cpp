@@ -0,0 +1,110 @@
+#include "LaunchPlan.h"
+
+#include <algorithm>
+
+int LaunchPlan::Add(AppHandle app)
+{
+    Member member;
+    member.app = app;
+    m_members.push_back(member);
+    return (int)m_members.size() - 1;
+}
+
+void LaunchPlan::AddDependency(int member, int dependsOn)
+{
+    std::vector<int>& dependents = m_members[dependsOn].dependents;
+    if (std::find(dependents.begin(), dependents.end(), member) != dependents.end()) return;
+    dependents.push_back(member);
+    m_members[member].pending++;
+}
+
+bool LaunchPlan::FindCycle(std::vector<int>& cycle) const
+{
+    // Depth-first over the dependents; reaching a member that is still on the path closes a cycle
+    enum : unsigned char { UNVISITED, ON_PATH, FINISHED };
+    std::vector<unsigned char> marks(m_members.size(), UNVISITED);
+    std::vector<int> path;
+    std::vector<size_t> nextChild;
+    for (int root = 0; root < Count(); root++) {
+        if (marks[root] != UNVISITED) continue;
+        path.push_back(root);
+        nextChild.push_back(0);
+        marks[root] = ON_PATH;
+        while (!path.empty()) {
+            int member = path.back();
+            const std::vector<int>& dependents = m_members[member].dependents;
+            if (nextChild.back() == dependents.size()) {
+                marks[member] = FINISHED;
+                path.pop_back();
+                nextChild.pop_back();
+                continue;
+            }
+            int child = dependents[nextChild.back()++];
+            if (marks[child] == ON_PATH) {
+                cycle.assign(std::find(path.begin(), path.end(), child), path.end());
+                return true;
+            }
+            if (marks[child] == UNVISITED) {
+                marks[child] = ON_PATH;
+                path.push_back(child);
+                nextChild.push_back(0);
+            }
+        }
+    }
+    return false;
+}
+
+void LaunchPlan::TakeStartable(std::vector<int>& startable)
+{
+    for (int i = 0; i < Count(); i++) {
+        if (m_members[i].state != State::Waiting || m_members[i].app.IsValid()) continue;
+        m_members[i].state = State::Starting;
+        Finish(i, false);
+    }
+    for (int i = 0; i < Count(); i++) {
+        if (m_members[i].state == State::Waiting && m_members[i].pending == 0) {
+            m_members[i].state = State::Starting;
+            startable.push_back(i);
+        }
+    }
+}
+
+void LaunchPlan::Finish(int member, bool ready)
+{
+    Member& finished = m_members[member];
+    if (finished.state != State::Starting) return;
+
+    if (ready) {
+        finished.state = State::Ready;
+        m_ready++;
+        for (int dependent : finished.dependents) {
+            m_members[dependent].pending--;
+        }
+    }
+    else {
+        finished.state = State::Failed;
+        m_failed++;
+        for (int dependent : finished.dependents) {
+            Skip(dependent);
+        }
+    }
+}
+
+int LaunchPlan::Find(AppHandle app) const
+{
+    for (int i = 0; i < Count(); i++) {
+        if (m_members[i].app == app) return i;
+    }
+    return -1;
+}
+
+void LaunchPlan::Skip(int member)
+{
+    // Only members that have not started can be skipped; the dependency graph has no cycles here
+    if (m_members[member].state != State::Waiting) return;
+    m_members[member].state = State::Skipped;
+    m_failed++;
+    for (int dependent : m_members[member].dependents) {
+        Skip(dependent);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "AppRegistry.h"
+
+#include <string>
+#include <vector>
+
+// Start order for the members of one launch profile. Every member whose dependencies are ready is
+// started at once; a member waits only for the ones it declared. When a member fails, everything
+// that depends on it (directly or not) is skipped. UI thread only.
+class LaunchPlan {
+public:
+    enum class State {
+        Waiting,
+        Starting,
+        Ready,
+        Failed,
+        Skipped,
+    };
+
+    // Returns the member index. An invalid handle (an app that no longer exists) fails when the plan starts.
+    int Add(AppHandle app);
+    // member starts only once dependsOn is ready
+    void AddDependency(int member, int dependsOn);
+    // True, with the members of one cycle in order, if the dependencies can never be satisfied
+    bool FindCycle(std::vector<int>& cycle) const;
+
+    // Marks the members that can start now as Starting and appends them to startable. Fails the
+    // members with invalid handles first, so call it once the plan is complete.
+    void TakeStartable(std::vector<int>& startable);
+    // Result of a Starting member; ignored for any other state
+    void Finish(int member, bool ready);
+
+    int Count() const { return (int)m_members.size(); }
+    AppHandle App(int member) const { return m_members[member].app; }
+    State MemberState(int member) const { return m_members[member].state; }
+    // Index of the member for app, -1 if it is not in the plan
+    int Find(AppHandle app) const;
+    // Members that are Ready, and those that are Failed or Skipped
+    int ReadyCount() const { return m_ready; }
+    int FailedCount() const { return m_failed; }
+    bool Done() const { return m_ready + m_failed == Count(); }
+
+private:
+    struct Member {
+        AppHandle app;
+        State state = State::Waiting;
+        // Dependencies not ready yet
+        int pending = 0;
+        std::vector<int> dependents;
+    };
+
+    void Skip(int member);
+
+    std::vector<Member> m_members;
+    int m_ready = 0;
+    int m_failed = 0;
+};
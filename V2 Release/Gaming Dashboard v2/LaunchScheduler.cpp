@@ -0,0 +1,351 @@
+#include "LaunchScheduler.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <pdh.h>
+#pragma comment(lib, "pdh.lib")
+#else
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <set>
+#endif
+
+// Disk monitors
+namespace {
+
+#ifdef _WIN32
+
+// "Disk Read Bytes/sec" is a bulk counter; its raw value is the running byte total
+class PdhDiskMonitor : public DiskMonitor {
+public:
+    PdhDiskMonitor() {
+        if (PdhOpenQueryA(nullptr, 0, &m_query) != ERROR_SUCCESS) {
+            m_query = nullptr;
+            return;
+        }
+        if (PdhAddEnglishCounterA(m_query, "\\PhysicalDisk(_Total)\\Disk Read Bytes/sec", 0, &m_counter) != ERROR_SUCCESS) {
+            PdhCloseQuery(m_query);
+            m_query = nullptr;
+        }
+    }
+
+    ~PdhDiskMonitor() override {
+        if (m_query) PdhCloseQuery(m_query);
+    }
+
+    bool ReadTotalBytes(uint64_t& bytes) override {
+        if (!m_query || PdhCollectQueryData(m_query) != ERROR_SUCCESS) return false;
+        PDH_RAW_COUNTER raw;
+        if (PdhGetRawCounterValue(m_counter, nullptr, &raw) != ERROR_SUCCESS) return false;
+        if (raw.CStatus != PDH_CSTATUS_VALID_DATA && raw.CStatus != PDH_CSTATUS_NEW_DATA) return false;
+        bytes = (uint64_t)raw.FirstValue;
+        return true;
+    }
+
+private:
+    PDH_HQUERY m_query = nullptr;
+    PDH_HCOUNTER m_counter = nullptr;
+};
+
+#else
+
+// Sectors read by whole disks (the entries under /sys/block), so partitions are not counted twice
+class ProcDiskMonitor : public DiskMonitor {
+public:
+    ProcDiskMonitor() {
+        DIR* block = opendir("/sys/block");
+        if (!block) return;
+        while (dirent* entry = readdir(block)) {
+            if (entry->d_name[0] == '.') continue;
+            // Loop and RAM devices read from memory or from another disk we already count
+            if (strncmp(entry->d_name, "loop", 4) == 0 || strncmp(entry->d_name, "ram", 3) == 0 || strncmp(entry->d_name, "zram", 4) == 0) continue;
+            m_disks.insert(entry->d_name);
+        }
+        closedir(block);
+    }
+
+    bool ReadTotalBytes(uint64_t& bytes) override {
+        FILE* file = fopen("/proc/diskstats", "r");
+        if (!file) return false;
+        uint64_t sectors = 0;
+        char line[512];
+        char name[64];
+        unsigned long long sectorsRead = 0;
+        while (fgets(line, sizeof(line), file)) {
+            // major minor name reads merged sectors ...
+            if (sscanf(line, "%*u %*u %63s %*u %*u %llu", name, &sectorsRead) == 2 && m_disks.count(name)) {
+                sectors += sectorsRead;
+            }
+        }
+        fclose(file);
+        // diskstats sectors are always 512 bytes, whatever the device's sector size
+        bytes = sectors * 512;
+        return true;
+    }
+
+private:
+    std::set<std::string> m_disks;
+};
+
+#endif
+
+}
+
+std::unique_ptr<DiskMonitor> CreatePlatformDiskMonitor()
+{
+#ifdef _WIN32
+    return std::make_unique<PdhDiskMonitor>();
+#else
+    return std::make_unique<ProcDiskMonitor>();
+#endif
+}
+
+// LaunchSlot
+LaunchSlot::~LaunchSlot()
+{
+    if (m_scheduler) m_scheduler->Finish(m_start, false);
+}
+
+LaunchSlot& LaunchSlot::operator=(LaunchSlot&& other) noexcept
+{
+    if (this != &other) {
+        if (m_scheduler) m_scheduler->Finish(m_start, false);
+        m_scheduler = other.m_scheduler;
+        m_start = other.m_start;
+        other.m_scheduler = nullptr;
+    }
+    return *this;
+}
+
+void LaunchSlot::Complete(bool started)
+{
+    if (!m_scheduler) return;
+    m_scheduler->Finish(m_start, started);
+    m_scheduler = nullptr;
+}
+
+// LaunchScheduler
+LaunchScheduler::LaunchScheduler(Executor& executor, std::unique_ptr<DiskMonitor> disk)
+    : m_executor(executor), m_disk(std::move(disk))
+{
+}
+
+void LaunchScheduler::SetEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_enabled = enabled;
+    AdmitWaiting(Clock::now());
+}
+
+void LaunchScheduler::SetCosts(const std::map<std::string, LaunchCost>& costs)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_costs = costs;
+}
+
+std::map<std::string, LaunchCost> LaunchScheduler::Costs() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_costs;
+}
+
+void LaunchScheduler::Promote(const std::string& app, uint64_t priority)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const std::shared_ptr<Request>& request : m_waiting) {
+        if (request->app == app && request->priority < priority) request->priority = priority;
+    }
+    AdmitWaiting(Clock::now());
+}
+
+int LaunchScheduler::QueuedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (int)m_waiting.size();
+}
+
+int LaunchScheduler::StartingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (int)m_starts.size();
+}
+
+double LaunchScheduler::DiskPeakBytesPerSecond() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_diskPeakBytesPerSecond;
+}
+
+LaunchScheduler::AdmitAwaitable LaunchScheduler::Admit(std::string app, uint64_t priority, CancellationToken token)
+{
+    auto request = std::make_shared<Request>();
+    request->executor = &m_executor;
+    request->app = std::move(app);
+    request->priority = priority;
+    return AdmitAwaitable(*this, std::move(request), std::move(token));
+}
+
+void LaunchScheduler::Enqueue(const std::shared_ptr<Request>& request)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Clock::time_point now = Clock::now();
+    // The disk is only sampled while launches are around; after a quiet spell the old rate means nothing
+    if (!m_sampleScheduled) {
+        m_hasDiskSample = false;
+        m_diskBytesPerSecond = 0.0;
+        SampleDisk(now);
+    }
+    request->sequence = m_nextSequence++;
+    m_waiting.push_back(request);
+    AdmitWaiting(now);
+    ScheduleSample();
+}
+
+void LaunchScheduler::Withdraw(const std::shared_ptr<Request>& request)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find(m_waiting.begin(), m_waiting.end(), request);
+        // Already admitted; the slot is released by the launch itself
+        if (it == m_waiting.end()) return;
+        m_waiting.erase(it);
+    }
+    request->Complete([]() {});
+}
+
+void LaunchScheduler::Finish(uint64_t start, bool started)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_starts.find(start);
+    if (it == m_starts.end()) return;
+
+    Clock::time_point now = Clock::now();
+    SampleDisk(now);
+    if (started) {
+        LaunchCost cost;
+        cost.readBytes = (uint64_t)it->second.readBytes;
+        cost.startupMs = (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(now - it->second.time).count();
+        // Averaged with the previous starts, so one start with a cold or warm file cache does not dominate
+        auto previous = m_costs.find(it->second.app);
+        if (previous != m_costs.end()) {
+            cost.readBytes = (previous->second.readBytes + cost.readBytes) / 2;
+            cost.startupMs = (previous->second.startupMs + cost.startupMs) / 2;
+        }
+        m_costs[it->second.app] = cost;
+        m_costGeneration.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_starts.erase(it);
+    AdmitWaiting(now);
+}
+
+void LaunchScheduler::SampleDisk(Clock::time_point now)
+{
+    uint64_t bytes = 0;
+    if (!m_disk || !m_disk->ReadTotalBytes(bytes)) return;
+    if (!m_hasDiskSample || bytes < m_lastDiskBytes) {
+        m_hasDiskSample = true;
+        m_lastDiskBytes = bytes;
+        m_lastDiskTime = now;
+        return;
+    }
+
+    double seconds = std::chrono::duration<double>(now - m_lastDiskTime).count();
+    uint64_t readBytes = bytes - m_lastDiskBytes;
+    // Samples closer together than this are too noisy to be a rate; the bytes carry over to the next one
+    if (seconds < SAMPLE_MS / 2000.0) return;
+    m_lastDiskBytes = bytes;
+    m_lastDiskTime = now;
+
+    m_diskBytesPerSecond = readBytes / seconds;
+    m_diskPeakBytesPerSecond = std::max(m_diskPeakBytesPerSecond, m_diskBytesPerSecond);
+
+    // Whatever was read meanwhile is charged evenly to the starts in flight
+    if (m_starts.empty()) return;
+    double share = (double)readBytes / m_starts.size();
+    for (auto& entry : m_starts) {
+        entry.second.readBytes += share;
+    }
+}
+
+void LaunchScheduler::AdmitWaiting(Clock::time_point now)
+{
+    while (!m_waiting.empty()) {
+        // Strictly by priority: when the best candidate does not fit, nothing behind it may overtake it
+        auto best = std::min_element(m_waiting.begin(), m_waiting.end(),
+            [](const std::shared_ptr<Request>& a, const std::shared_ptr<Request>& b) {
+                if (a->priority != b->priority) return a->priority > b->priority;
+                return a->sequence < b->sequence;
+            });
+
+        if (m_enabled) {
+            int active = 0;
+            double expected = 0.0;
+            for (const auto& entry : m_starts) {
+                if (now - entry.second.time > std::chrono::milliseconds(STALE_START_MS)) continue;
+                active++;
+                expected += ExpectedBytesPerSecond(entry.second.app);
+            }
+            if (active >= MAX_COLD_STARTS) return;
+            if (active > 0) {
+                double load = std::max(expected, m_diskBytesPerSecond);
+                if (load + ExpectedBytesPerSecond((*best)->app) > m_diskPeakBytesPerSecond * DISK_BUDGET) return;
+            }
+        }
+
+        std::shared_ptr<Request> request = *best;
+        m_waiting.erase(best);
+        uint64_t start = m_nextStart++;
+        m_starts[start] = Start{ request->app, now, 0.0 };
+        request->Complete([&]() {
+            request->admitted = true;
+            request->start = start;
+        });
+    }
+}
+
+double LaunchScheduler::ExpectedBytesPerSecond(const std::string& app) const
+{
+    auto it = m_costs.find(app);
+    if (it == m_costs.end() || it->second.startupMs == 0) return m_diskPeakBytesPerSecond * UNKNOWN_APP_SHARE;
+    return it->second.readBytes * 1000.0 / it->second.startupMs;
+}
+
+void LaunchScheduler::ScheduleSample()
+{
+    if (m_sampleScheduled || (m_waiting.empty() && m_starts.empty())) return;
+    m_sampleScheduled = true;
+    m_executor.PostAfter(SAMPLE_MS, [this]() { OnSampleTimer(); });
+}
+
+void LaunchScheduler::OnSampleTimer()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sampleScheduled = false;
+    Clock::time_point now = Clock::now();
+    SampleDisk(now);
+    AdmitWaiting(now);
+    ScheduleSample();
+}
+
+// AdmitAwaitable
+void LaunchScheduler::AdmitAwaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    std::shared_ptr<Request> request = m_request;
+    std::lock_guard<std::mutex> lock(request->setupMutex);
+    request->handle = handle;
+    // Queued first, so a token that is already cancelled finds the request to withdraw
+    m_scheduler.Enqueue(request);
+    LaunchScheduler& scheduler = m_scheduler;
+    request->cancelRegistration = m_token.Register([&scheduler, request]() { scheduler.Withdraw(request); });
+}
+
+LaunchSlot LaunchScheduler::AdmitAwaitable::await_resume()
+{
+    std::lock_guard<std::mutex> lock(m_request->setupMutex);
+    m_token.Unregister(m_request->cancelRegistration);
+    if (!m_request->admitted) return LaunchSlot();
+    return LaunchSlot(&m_scheduler, m_request->start);
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Executor.h"
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// System-wide count of bytes read from physical disks
+class DiskMonitor {
+public:
+    virtual ~DiskMonitor() = default;
+
+    // Total since some fixed point in the past; false if the counter is unavailable
+    virtual bool ReadTotalBytes(uint64_t& bytes) = 0;
+};
+
+// Counter advanced by hand; for headless runs and simulated disks
+class FakeDiskMonitor : public DiskMonitor {
+public:
+    bool ReadTotalBytes(uint64_t& bytes) override {
+        bytes = m_bytes.load(std::memory_order_relaxed);
+        return true;
+    }
+
+    void AddBytesRead(uint64_t bytes) { m_bytes.fetch_add(bytes, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> m_bytes{ 0 };
+};
+
+// PDH "PhysicalDisk(_Total)" counters on Win32, /proc/diskstats elsewhere
+std::unique_ptr<DiskMonitor> CreatePlatformDiskMonitor();
+
+// What a cold start of an app cost: disk bytes read while it started, and the time until its window showed
+struct LaunchCost {
+    uint64_t readBytes = 0;
+    uint32_t startupMs = 0;
+};
+
+class LaunchScheduler;
+
+// An admitted cold start. Complete() it once the app's window is up (or the launch failed);
+// a slot dropped without Complete() is released without recording a cost.
+class LaunchSlot {
+public:
+    LaunchSlot() = default;
+    LaunchSlot(LaunchScheduler* scheduler, uint64_t start) : m_scheduler(scheduler), m_start(start) {}
+    ~LaunchSlot();
+
+    LaunchSlot(LaunchSlot&& other) noexcept : m_scheduler(other.m_scheduler), m_start(other.m_start) { other.m_scheduler = nullptr; }
+    LaunchSlot& operator=(LaunchSlot&& other) noexcept;
+    LaunchSlot(const LaunchSlot&) = delete;
+    LaunchSlot& operator=(const LaunchSlot&) = delete;
+
+    // False if the launch was cancelled while it waited for admission
+    explicit operator bool() const { return m_scheduler != nullptr; }
+
+    // started: the window showed up, so the measured time and bytes are the app's startup cost
+    void Complete(bool started);
+
+private:
+    LaunchScheduler* m_scheduler = nullptr;
+    uint64_t m_start = 0;
+};
+
+// Caps concurrent cold starts so apps launched together do not fight over the disk. The next launch is
+// admitted when the disk can take it: the expected read rate of the starts in flight (or the measured
+// disk read rate, if higher) plus the candidate's must stay under the disk's observed peak throughput.
+// An app's expected rate comes from its earlier starts, where the bytes read system-wide are shared
+// among the starts in flight at the time. Waiting launches are admitted highest priority first, so the
+// app the user clicked last goes next. Thread-safe.
+class LaunchScheduler {
+public:
+    static const int MAX_COLD_STARTS = 4;
+    // Disk sampling interval while launches are queued or starting
+    static const int SAMPLE_MS = 100;
+    // A start still without a window after this long no longer counts against the disk budget
+    static const int STALE_START_MS = 5000;
+    // Assumed until the disk is seen going faster; about what a hard disk manages
+    static constexpr double DEFAULT_DISK_BYTES_PER_SECOND = 100.0 * 1024 * 1024;
+    // Share of the disk's peak throughput that starts in flight may use together
+    static constexpr double DISK_BUDGET = 0.9;
+    // Expected rate of an app with no recorded start, as a share of the peak: two unknown apps at a time
+    static constexpr double UNKNOWN_APP_SHARE = 0.4;
+
+    LaunchScheduler(Executor& executor, std::unique_ptr<DiskMonitor> disk);
+
+    LaunchScheduler(const LaunchScheduler&) = delete;
+    LaunchScheduler& operator=(const LaunchScheduler&) = delete;
+
+    // Disabled, every launch is admitted right away (for comparisons)
+    void SetEnabled(bool enabled);
+
+    // Costs are keyed by app name, so they carry over between runs through the settings
+    void SetCosts(const std::map<std::string, LaunchCost>& costs);
+    std::map<std::string, LaunchCost> Costs() const;
+    // Bumped whenever a start records a cost
+    uint64_t CostGeneration() const { return m_costGeneration.load(std::memory_order_relaxed); }
+
+    // Raises a waiting launch of app to priority, e.g. when the user clicks an app a profile queued
+    void Promote(const std::string& app, uint64_t priority);
+
+    // Launches waiting for admission, and cold starts in flight
+    int QueuedCount() const;
+    int StartingCount() const;
+    double DiskPeakBytesPerSecond() const;
+
+    class AdmitAwaitable;
+
+    // co_await Admit(...) yields a LaunchSlot once the launch may start, or an empty one if the token was
+    // cancelled first. Higher priority is admitted first; equal priorities in request order.
+    AdmitAwaitable Admit(std::string app, uint64_t priority, CancellationToken token);
+
+private:
+    friend class LaunchSlot;
+    typedef std::chrono::steady_clock Clock;
+
+    struct Request : ResumeState {
+        std::string app;
+        uint64_t priority = 0;
+        uint64_t sequence = 0;
+        uint64_t start = 0;
+        bool admitted = false;
+        uint64_t cancelRegistration = 0;
+    };
+
+    struct Start {
+        std::string app;
+        Clock::time_point time;
+        // Disk bytes read since the start, shared with the starts in flight at the same time
+        double readBytes = 0.0;
+    };
+
+    void Enqueue(const std::shared_ptr<Request>& request);
+    void Withdraw(const std::shared_ptr<Request>& request);
+    void Finish(uint64_t start, bool started);
+
+    // Call with m_mutex held
+    void SampleDisk(Clock::time_point now);
+    void AdmitWaiting(Clock::time_point now);
+    double ExpectedBytesPerSecond(const std::string& app) const;
+    void ScheduleSample();
+
+    void OnSampleTimer();
+
+    Executor& m_executor;
+    std::unique_ptr<DiskMonitor> m_disk;
+
+    mutable std::mutex m_mutex;
+    bool m_enabled = true;
+    std::vector<std::shared_ptr<Request>> m_waiting;
+    std::map<uint64_t, Start> m_starts;
+    std::map<std::string, LaunchCost> m_costs;
+    std::atomic<uint64_t> m_costGeneration{ 0 };
+    uint64_t m_nextSequence = 1;
+    uint64_t m_nextStart = 1;
+    bool m_sampleScheduled = false;
+
+    // Disk counters from the last sample
+    bool m_hasDiskSample = false;
+    uint64_t m_lastDiskBytes = 0;
+    Clock::time_point m_lastDiskTime;
+    double m_diskBytesPerSecond = 0.0;
+    double m_diskPeakBytesPerSecond = DEFAULT_DISK_BYTES_PER_SECOND;
+};
+
+class LaunchScheduler::AdmitAwaitable {
+public:
+    AdmitAwaitable(LaunchScheduler& scheduler, std::shared_ptr<Request> request, CancellationToken token)
+        : m_scheduler(scheduler), m_request(std::move(request)), m_token(std::move(token)) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle);
+    LaunchSlot await_resume();
+
+private:
+    LaunchScheduler& m_scheduler;
+    std::shared_ptr<Request> m_request;
+    CancellationToken m_token;
+};
@@ -0,0 +1,115 @@
+#include "NullRenderer.h"
+
+#include <cstring>
+
+NullRenderer::~NullRenderer()
+{
+    if (m_initialized) Shutdown();
+}
+
+void NullRenderer::Init()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IM_ASSERT(io.BackendRendererUserData == nullptr && "Already initialized a renderer backend!");
+    io.BackendRendererUserData = this;
+    io.BackendRendererName = "null";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+
+    ImGuiPlatformIO& platformIo = ImGui::GetPlatformIO();
+    platformIo.Renderer_TextureMaxWidth = platformIo.Renderer_TextureMaxHeight = 16384;
+    m_initialized = true;
+}
+
+void NullRenderer::Shutdown()
+{
+    for (ImTextureData* texture : ImGui::GetPlatformIO().Textures) {
+        if (texture->RefCount == 1) DestroyTexture(texture);
+    }
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendRendererName = nullptr;
+    io.BackendRendererUserData = nullptr;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures);
+    m_initialized = false;
+}
+
+void NullRenderer::RenderDrawData(ImDrawData* drawData)
+{
+    m_frame = NullRenderStats();
+
+    // Texture requests first, as the D3D11 backend does, so draw commands see their textures
+    if (drawData->Textures != nullptr) {
+        for (ImTextureData* texture : *drawData->Textures) {
+            if (texture->Status != ImTextureStatus_OK) UpdateTexture(texture);
+        }
+    }
+
+    // Staging buffers grow to the largest frame and are then reused
+    if ((int)m_vertices.size() < drawData->TotalVtxCount) m_vertices.resize(drawData->TotalVtxCount + 5000);
+    if ((int)m_indices.size() < drawData->TotalIdxCount) m_indices.resize(drawData->TotalIdxCount + 10000);
+    ImDrawVert* vertex = m_vertices.data();
+    ImDrawIdx* index = m_indices.data();
+    for (const ImDrawList* drawList : drawData->CmdLists) {
+        memcpy(vertex, drawList->VtxBuffer.Data, drawList->VtxBuffer.Size * sizeof(ImDrawVert));
+        memcpy(index, drawList->IdxBuffer.Data, drawList->IdxBuffer.Size * sizeof(ImDrawIdx));
+        vertex += drawList->VtxBuffer.Size;
+        index += drawList->IdxBuffer.Size;
+
+        for (const ImDrawCmd& command : drawList->CmdBuffer) {
+            if (command.UserCallback != nullptr) {
+                if (command.UserCallback != ImDrawCallback_ResetRenderState) command.UserCallback(drawList, &command);
+                continue;
+            }
+            if (command.ElemCount > 0) m_frame.drawCalls++;
+        }
+        m_frame.drawLists++;
+    }
+    m_frame.vertices = drawData->TotalVtxCount;
+    m_frame.indices = drawData->TotalIdxCount;
+    m_lastFrame = m_frame;
+}
+
+void NullRenderer::UpdateTexture(ImTextureData* texture)
+{
+    if (texture->Status == ImTextureStatus_WantCreate) {
+        IM_ASSERT(texture->TexID == ImTextureID_Invalid && texture->BackendUserData == nullptr);
+        Texture* backendTexture = new Texture();
+        backendTexture->width = texture->Width;
+        backendTexture->height = texture->Height;
+        backendTexture->pixels.resize((size_t)texture->Width * texture->Height * texture->BytesPerPixel);
+        CopyRect(*backendTexture, texture, 0, 0, texture->Width, texture->Height);
+        texture->SetTexID((ImTextureID)(intptr_t)backendTexture);
+        texture->SetStatus(ImTextureStatus_OK);
+        texture->BackendUserData = backendTexture;
+    }
+    else if (texture->Status == ImTextureStatus_WantUpdates) {
+        Texture* backendTexture = (Texture*)texture->BackendUserData;
+        for (const ImTextureRect& rect : texture->Updates) {
+            CopyRect(*backendTexture, texture, rect.x, rect.y, rect.w, rect.h);
+        }
+        texture->SetStatus(ImTextureStatus_OK);
+    }
+    if (texture->Status == ImTextureStatus_WantDestroy && texture->UnusedFrames > 0) {
+        DestroyTexture(texture);
+    }
+}
+
+void NullRenderer::DestroyTexture(ImTextureData* texture)
+{
+    delete (Texture*)texture->BackendUserData;
+    texture->SetTexID(ImTextureID_Invalid);
+    texture->SetStatus(ImTextureStatus_Destroyed);
+    texture->BackendUserData = nullptr;
+}
+
+void NullRenderer::CopyRect(Texture& target, ImTextureData* source, int x, int y, int width, int height)
+{
+    size_t rowBytes = (size_t)width * source->BytesPerPixel;
+    size_t targetPitch = (size_t)target.width * source->BytesPerPixel;
+    for (int row = 0; row < height; row++) {
+        memcpy(&target.pixels[(y + row) * targetPitch + (size_t)x * source->BytesPerPixel], source->GetPixelsAt(x, y + row), rowBytes);
+    }
+    m_frame.textureUploads++;
+    m_frame.uploadedBytes += rowBytes * height;
+}
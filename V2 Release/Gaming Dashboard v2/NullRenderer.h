@@ -0,0 +1,54 @@
+#pragma once
+
+#include "imgui.h"
+
+#include <cstdint>
+#include <vector>
+
+struct NullRenderStats {
+    int drawLists = 0;
+    int drawCalls = 0;
+    int vertices = 0;
+    int indices = 0;
+    // Texture creates and partial updates handled this frame, and the pixel bytes they copied
+    int textureUploads = 0;
+    uint64_t uploadedBytes = 0;
+};
+
+// ImGui renderer backend without a GPU, for headless runs. It does the CPU side of what the D3D11
+// backend does: honours ImTextureData create/update/destroy requests by copying pixels into its own
+// textures, and copies every frame's vertices and indices into one staging buffer each. Nothing is drawn.
+class NullRenderer {
+public:
+    NullRenderer() = default;
+    ~NullRenderer();
+
+    NullRenderer(const NullRenderer&) = delete;
+    NullRenderer& operator=(const NullRenderer&) = delete;
+
+    // Call after ImGui::CreateContext(), like ImGui_ImplDX11_Init()
+    void Init();
+    // Destroys the remaining textures; call before ImGui::DestroyContext()
+    void Shutdown();
+
+    void RenderDrawData(ImDrawData* drawData);
+
+    const NullRenderStats& LastFrame() const { return m_lastFrame; }
+
+private:
+    struct Texture {
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> pixels;
+    };
+
+    void UpdateTexture(ImTextureData* texture);
+    void DestroyTexture(ImTextureData* texture);
+    void CopyRect(Texture& target, ImTextureData* source, int x, int y, int width, int height);
+
+    bool m_initialized = false;
+    std::vector<ImDrawVert> m_vertices;
+    std::vector<ImDrawIdx> m_indices;
+    NullRenderStats m_lastFrame;
+    NullRenderStats m_frame;
+};
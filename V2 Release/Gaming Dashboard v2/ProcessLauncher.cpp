@@ -0,0 +1,550 @@
+#include "ProcessLauncher.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <shellapi.h>
+#include <cctype>
+#else
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <dirent.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+WindowPredicate MatchProcessWindow(const std::shared_ptr<LaunchedProcess>& process, const std::string& titlePart)
+{
+    WindowPredicate byTitle = MatchWindowTitle(titlePart);
+    return [process, byTitle](const WindowInfo& info) {
+        if (!byTitle(info)) return false;
+        return process->Contains(info.pid) || process->HasExited();
+    };
+}
+
+namespace {
+
+// Exit flag and callbacks shared by the platform implementations
+class ExitNotifier : public LaunchedProcess {
+public:
+    bool HasExited() const override { return m_exited; }
+
+    void OnExit(std::function<void()> callback) override {
+        {
+            std::lock_guard<std::mutex> lock(m_exitMutex);
+            if (!m_exited) {
+                m_exitCallbacks.push_back(std::move(callback));
+                return;
+            }
+        }
+        callback();
+    }
+
+    void NotifyExit() {
+        std::vector<std::function<void()>> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(m_exitMutex);
+            if (m_exited) return;
+            m_exited = true;
+            callbacks.swap(m_exitCallbacks);
+        }
+        for (auto& callback : callbacks) callback();
+    }
+
+private:
+    std::atomic<bool> m_exited{ false };
+    std::mutex m_exitMutex;
+    std::vector<std::function<void()>> m_exitCallbacks;
+};
+
+#ifdef _WIN32
+
+// Completion message posted for attached processes (job messages are 1..13)
+const DWORD kProcessExitedMessage = 0x100;
+
+// What a process handle wait posts to the port when it fires
+struct WaitContext {
+    HANDLE port;
+    ULONG_PTR key;
+};
+
+class Win32Process : public ExitNotifier {
+public:
+    Win32Process(HANDLE process, ProcessId pid, HANDLE job) : m_process(process), m_pid(pid), m_job(job) {}
+
+    ~Win32Process() override {
+        // Blocks until a callback already running is done, so the context can go with us
+        if (m_wait) UnregisterWaitEx(m_wait, INVALID_HANDLE_VALUE);
+        if (m_job) CloseHandle(m_job);
+        CloseHandle(m_process);
+    }
+
+    ProcessId Pid() const override { return m_pid; }
+
+    std::vector<ProcessId> ProcessTree() const override {
+        std::lock_guard<std::mutex> lock(m_treeMutex);
+        RefreshTree();
+        return std::vector<ProcessId>(m_tree.begin(), m_tree.end());
+    }
+
+    bool Contains(ProcessId pid) const override {
+        if (pid == m_pid) return true;
+        if (!m_job) return false;
+
+        // Cached job membership, refreshed only on a miss
+        std::lock_guard<std::mutex> lock(m_treeMutex);
+        if (m_tree.count(pid)) return true;
+        RefreshTree();
+        return m_tree.count(pid) != 0;
+    }
+
+    HANDLE ProcessHandle() const { return m_process; }
+    void SetWait(HANDLE wait, std::unique_ptr<WaitContext> context) {
+        m_wait = wait;
+        m_waitContext = std::move(context);
+    }
+
+private:
+    void RefreshTree() const {
+        m_tree.clear();
+        m_tree.insert(m_pid);
+        if (!m_job) return;
+
+        const DWORD maxProcesses = 256;
+        std::vector<char> buffer(sizeof(JOBOBJECT_BASIC_PROCESS_ID_LIST) + maxProcesses * sizeof(ULONG_PTR));
+        JOBOBJECT_BASIC_PROCESS_ID_LIST* list = (JOBOBJECT_BASIC_PROCESS_ID_LIST*)buffer.data();
+        if (QueryInformationJobObject(m_job, JobObjectBasicProcessIdList, list, (DWORD)buffer.size(), nullptr)) {
+            for (DWORD i = 0; i < list->NumberOfProcessIdsInList; i++) {
+                m_tree.insert((ProcessId)list->ProcessIdList[i]);
+            }
+        }
+    }
+
+    HANDLE m_process;
+    ProcessId m_pid;
+    HANDLE m_job;
+    HANDLE m_wait = nullptr;
+    std::unique_ptr<WaitContext> m_waitContext;
+    mutable std::mutex m_treeMutex;
+    mutable std::unordered_set<ProcessId> m_tree;
+};
+
+// Quotes the executable part of "C:\Program Files\App\app.exe --args" for CreateProcess
+std::string BuildCommandLine(const std::string& commandLine)
+{
+    if (commandLine.empty() || commandLine[0] == '"') return commandLine;
+    if (GetFileAttributesA(commandLine.c_str()) != INVALID_FILE_ATTRIBUTES) {
+        return "\"" + commandLine + "\"";
+    }
+
+    std::string lower = commandLine;
+    for (char& c : lower) c = (char)tolower((unsigned char)c);
+    size_t exeEnd = lower.find(".exe ");
+    if (exeEnd == std::string::npos) return commandLine;
+    exeEnd += 4;
+    return "\"" + commandLine.substr(0, exeEnd) + "\"" + commandLine.substr(exeEnd);
+}
+
+// Each launch gets its own job object, all reporting to one completion port
+class Win32ProcessLauncher : public ProcessLauncher {
+public:
+    Win32ProcessLauncher() {
+        m_port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+        m_watcher = std::thread([this]() { WatchThread(); });
+    }
+
+    ~Win32ProcessLauncher() override {
+        PostQueuedCompletionStatus(m_port, 0, 0, nullptr);
+        m_watcher.join();
+        CloseHandle(m_port);
+    }
+
+    std::shared_ptr<LaunchedProcess> Launch(const std::string& commandLine) override {
+        std::string command = BuildCommandLine(commandLine);
+        std::vector<char> buffer(command.begin(), command.end());
+        buffer.push_back(0);
+
+        ULONG_PTR key = NextKey();
+        HANDLE job = CreateJobObjectA(nullptr, nullptr);
+        if (job) {
+            JOBOBJECT_ASSOCIATE_COMPLETION_PORT port = {};
+            port.CompletionKey = (PVOID)key;
+            port.CompletionPort = m_port;
+            SetInformationJobObject(job, JobObjectAssociateCompletionPortInformation, &port, sizeof(port));
+        }
+
+        HANDLE processHandle = nullptr;
+        STARTUPINFOA startup = { sizeof(startup) };
+        PROCESS_INFORMATION info = {};
+        if (CreateProcessA(nullptr, buffer.data(), nullptr, nullptr, FALSE, CREATE_SUSPENDED, nullptr, nullptr, &startup, &info)) {
+            // Assign before the first instruction runs so every child lands in the job
+            if (job && !AssignProcessToJobObject(job, info.hProcess)) {
+                CloseHandle(job);
+                job = nullptr;
+            }
+            ResumeThread(info.hThread);
+            CloseHandle(info.hThread);
+            processHandle = info.hProcess;
+        }
+        else {
+            // Not a plain executable (shortcut, document, ...) - let the shell resolve it and adopt the result
+            SHELLEXECUTEINFOA execute = { sizeof(execute) };
+            execute.fMask = SEE_MASK_NOCLOSEPROCESS;
+            execute.lpFile = commandLine.c_str();
+            execute.nShow = SW_SHOW;
+            if (!ShellExecuteExA(&execute) || !execute.hProcess) {
+                if (job) CloseHandle(job);
+                Forget(key);
+                return nullptr;
+            }
+            if (job && !AssignProcessToJobObject(job, execute.hProcess)) {
+                CloseHandle(job);
+                job = nullptr;
+            }
+            processHandle = execute.hProcess;
+        }
+
+        auto process = std::make_shared<Win32Process>(processHandle, (ProcessId)GetProcessId(processHandle), job);
+        Track(key, process, job == nullptr);
+        return process;
+    }
+
+    std::shared_ptr<LaunchedProcess> Attach(ProcessId pid) override {
+        HANDLE processHandle = OpenProcess(SYNCHRONIZE | PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+        if (!processHandle) return nullptr;
+
+        auto process = std::make_shared<Win32Process>(processHandle, pid, nullptr);
+        Track(NextKey(), process, true);
+        return process;
+    }
+
+private:
+    ULONG_PTR NextKey() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingKeys.insert(m_nextKey);
+        return m_nextKey++;
+    }
+
+    // A key handed out for a launch that failed; nothing will claim its early exit
+    void Forget(ULONG_PTR key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingKeys.erase(key);
+        m_exitedEarly.erase(key);
+    }
+
+    void Track(ULONG_PTR key, const std::shared_ptr<Win32Process>& process, bool waitOnHandle) {
+        bool exitedEarly;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // A very short-lived job can empty before we get here
+            m_pendingKeys.erase(key);
+            exitedEarly = m_exitedEarly.erase(key) != 0;
+            if (!exitedEarly) m_processes[key] = process;
+        }
+        if (exitedEarly) {
+            process->NotifyExit();
+            return;
+        }
+        if (!waitOnHandle) return;
+
+        // No job: wait on the process handle itself and forward the exit through the port. The process
+        // owns the context and unregisters the wait before freeing it, whether or not the wait fired.
+        auto context = std::make_unique<WaitContext>(WaitContext{ m_port, key });
+        HANDLE wait = nullptr;
+        if (RegisterWaitForSingleObject(&wait, process->ProcessHandle(), [](PVOID parameter, BOOLEAN) {
+            WaitContext* context = (WaitContext*)parameter;
+            PostQueuedCompletionStatus(context->port, kProcessExitedMessage, context->key, nullptr);
+            }, context.get(), INFINITE, WT_EXECUTEONLYONCE)) {
+            process->SetWait(wait, std::move(context));
+        }
+    }
+
+    void WatchThread() {
+        for (;;) {
+            DWORD message = 0;
+            ULONG_PTR key = 0;
+            LPOVERLAPPED overlapped = nullptr;
+            if (!GetQueuedCompletionStatus(m_port, &message, &key, &overlapped, INFINITE)) break;
+            if (key == 0) break;
+            if (message != JOB_OBJECT_MSG_ACTIVE_PROCESS_ZERO && message != kProcessExitedMessage) continue;
+
+            std::shared_ptr<Win32Process> process;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_processes.find(key);
+                if (it == m_processes.end()) {
+                    // Only a launch still on its way to Track can claim it; anything else was reaped already
+                    if (m_pendingKeys.count(key)) m_exitedEarly.insert(key);
+                    continue;
+                }
+                process = it->second.lock();
+                m_processes.erase(it);
+            }
+            if (process) process->NotifyExit();
+        }
+    }
+
+    HANDLE m_port = nullptr;
+    std::thread m_watcher;
+    std::mutex m_mutex;
+    std::map<ULONG_PTR, std::weak_ptr<Win32Process>> m_processes;
+    // Keys handed out but not yet tracked, and those of them whose exit came first
+    std::unordered_set<ULONG_PTR> m_pendingKeys;
+    std::unordered_set<ULONG_PTR> m_exitedEarly;
+    ULONG_PTR m_nextKey = 1;
+};
+
+#else
+
+// Launched commands lead their own process group; attached processes are tracked alone
+class PosixProcess : public ExitNotifier {
+public:
+    PosixProcess(pid_t pid, bool ownsGroup) : m_pid(pid), m_ownsGroup(ownsGroup) {}
+
+    ProcessId Pid() const override { return (ProcessId)m_pid; }
+
+    std::vector<ProcessId> ProcessTree() const override {
+        std::vector<ProcessId> tree;
+        if (!m_ownsGroup) {
+            if (IsAlive(m_pid)) tree.push_back((ProcessId)m_pid);
+            return tree;
+        }
+
+        DIR* proc = opendir("/proc");
+        if (!proc) return tree;
+        while (dirent* entry = readdir(proc)) {
+            pid_t pid = (pid_t)atoi(entry->d_name);
+            if (pid > 0 && getpgid(pid) == m_pid) tree.push_back((ProcessId)pid);
+        }
+        closedir(proc);
+        return tree;
+    }
+
+    bool Contains(ProcessId pid) const override {
+        if ((pid_t)pid == m_pid) return true;
+        return m_ownsGroup && getpgid((pid_t)pid) == m_pid;
+    }
+
+    // Called from the watcher thread, after it has tried to reap the leader (a zombie still counts
+    // as a group member); true once nothing in the tree is left
+    bool Poll() {
+        if (!m_ownsGroup) return !IsAlive(m_pid);
+        return kill(-m_pid, 0) != 0 && errno == ESRCH;
+    }
+
+private:
+    static bool IsAlive(pid_t pid) {
+        return kill(pid, 0) == 0 || errno == EPERM;
+    }
+
+    pid_t m_pid;
+    bool m_ownsGroup;
+};
+
+// There is no portable handle to block on for a whole process group, so one thread polls them all
+class PosixProcessLauncher : public ProcessLauncher {
+public:
+    PosixProcessLauncher() {
+        m_watcher = std::thread([this]() { WatchThread(); });
+    }
+
+    ~PosixProcessLauncher() override {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_watcher.join();
+    }
+
+    std::shared_ptr<LaunchedProcess> Launch(const std::string& commandLine) override {
+        pid_t pid = fork();
+        if (pid < 0) return nullptr;
+        if (pid == 0) {
+            setpgid(0, 0);
+            execl("/bin/sh", "sh", "-c", commandLine.c_str(), (char*)nullptr);
+            _exit(127);
+        }
+        // Also set from the parent so the group exists before anyone looks at it
+        setpgid(pid, pid);
+
+        auto process = std::make_shared<PosixProcess>(pid, true);
+        Track(process, true);
+        return process;
+    }
+
+    std::shared_ptr<LaunchedProcess> Attach(ProcessId pid) override {
+        if (kill((pid_t)pid, 0) != 0 && errno != EPERM) return nullptr;
+        auto process = std::make_shared<PosixProcess>((pid_t)pid, false);
+        Track(process, false);
+        return process;
+    }
+
+private:
+    struct Tracked {
+        std::weak_ptr<PosixProcess> process;
+        pid_t pid;
+        // Our own child not reaped yet. It stays tracked until it is, even once nobody holds its
+        // process (a timed-out launch drops it), or it would linger as a zombie.
+        bool unreaped;
+    };
+
+    void Track(const std::shared_ptr<PosixProcess>& process, bool child) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_processes.push_back({ process, (pid_t)process->Pid(), child });
+    }
+
+    void WatchThread() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (!m_stopping) {
+            m_wake.wait_for(lock, std::chrono::milliseconds(100));
+
+            std::vector<std::shared_ptr<PosixProcess>> exited;
+            for (size_t i = 0; i < m_processes.size();) {
+                Tracked& tracked = m_processes[i];
+                int status = 0;
+                if (tracked.unreaped && waitpid(tracked.pid, &status, WNOHANG) != 0) tracked.unreaped = false;
+                std::shared_ptr<PosixProcess> process = tracked.process.lock();
+                bool done = process ? process->Poll() : !tracked.unreaped;
+                if (!done) {
+                    i++;
+                    continue;
+                }
+                if (process) exited.push_back(process);
+                m_processes.erase(m_processes.begin() + i);
+            }
+
+            lock.unlock();
+            for (auto& process : exited) process->NotifyExit();
+            lock.lock();
+        }
+    }
+
+    std::thread m_watcher;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping = false;
+    std::vector<Tracked> m_processes;
+};
+
+#endif
+
+class FakeProcess : public ExitNotifier {
+public:
+    explicit FakeProcess(ProcessId pid) : m_pid(pid) {}
+
+    ProcessId Pid() const override { return m_pid; }
+    std::vector<ProcessId> ProcessTree() const override {
+        if (HasExited()) return {};
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<ProcessId> tree = { m_pid };
+        tree.insert(tree.end(), m_children.begin(), m_children.end());
+        return tree;
+    }
+    bool Contains(ProcessId pid) const override {
+        if (HasExited()) return false;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return pid == m_pid || std::find(m_children.begin(), m_children.end(), pid) != m_children.end();
+    }
+
+    void AddChild(ProcessId pid) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_children.push_back(pid);
+    }
+
+private:
+    ProcessId m_pid;
+    mutable std::mutex m_mutex;
+    std::vector<ProcessId> m_children;
+};
+
+}
+
+// FakeProcessLauncher
+std::shared_ptr<LaunchedProcess> FakeProcessLauncher::Launch(const std::string& commandLine)
+{
+    ProcessId pid;
+    std::function<void(ProcessId, const std::string&)> handler;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pid = m_nextPid++;
+        m_launchCount++;
+        handler = m_launchHandler;
+    }
+    std::shared_ptr<LaunchedProcess> process = Track(pid);
+    if (handler) handler(pid, commandLine);
+    return process;
+}
+
+std::shared_ptr<LaunchedProcess> FakeProcessLauncher::Attach(ProcessId pid)
+{
+    return Track(pid);
+}
+
+std::shared_ptr<LaunchedProcess> FakeProcessLauncher::Track(ProcessId pid)
+{
+    auto process = std::make_shared<FakeProcess>(pid);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_processes[pid] = process;
+    return process;
+}
+
+void FakeProcessLauncher::Exit(ProcessId pid)
+{
+    std::shared_ptr<LaunchedProcess> process;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_processes.find(pid);
+        if (it == m_processes.end()) return;
+        process = it->second.lock();
+        m_processes.erase(it);
+    }
+    if (process) static_cast<FakeProcess&>(*process).NotifyExit();
+}
+
+ProcessId FakeProcessLauncher::SpawnChild(ProcessId pid)
+{
+    std::shared_ptr<LaunchedProcess> process;
+    ProcessId child = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_processes.find(pid);
+        if (it == m_processes.end()) return 0;
+        process = it->second.lock();
+        if (!process) return 0;
+        child = m_nextPid++;
+    }
+    static_cast<FakeProcess&>(*process).AddChild(child);
+    return child;
+}
+
+int FakeProcessLauncher::LaunchCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_launchCount;
+}
+
+void FakeProcessLauncher::SetLaunchHandler(std::function<void(ProcessId pid, const std::string& commandLine)> handler)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_launchHandler = std::move(handler);
+}
+
+std::unique_ptr<ProcessLauncher> CreatePlatformProcessLauncher()
+{
+#ifdef _WIN32
+    return std::make_unique<Win32ProcessLauncher>();
+#else
+    return std::make_unique<PosixProcessLauncher>();
+#endif
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "WindowSystem.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// A launched (or attached) process together with everything it spawned
+class LaunchedProcess {
+public:
+    virtual ~LaunchedProcess() = default;
+
+    virtual ProcessId Pid() const = 0;
+    // Live members of the tree (job object on Win32, process group on Linux)
+    virtual std::vector<ProcessId> ProcessTree() const = 0;
+    virtual bool Contains(ProcessId pid) const = 0;
+    // True once every process in the tree has exited
+    virtual bool HasExited() const = 0;
+    // Runs once on the launcher's watcher thread when the whole tree has exited,
+    // or right away on the caller's thread if it already has
+    virtual void OnExit(std::function<void()> callback) = 0;
+};
+
+class ProcessLauncher {
+public:
+    virtual ~ProcessLauncher() = default;
+
+    // commandLine is an executable path, optionally followed by arguments. nullptr on failure.
+    virtual std::shared_ptr<LaunchedProcess> Launch(const std::string& commandLine) = 0;
+    // Tracks an already running process, e.g. the owner of a window we embed
+    virtual std::shared_ptr<LaunchedProcess> Attach(ProcessId pid) = 0;
+};
+
+// In-memory backend: nothing is started, every process is a single made-up pid that exits when told to
+class FakeProcessLauncher : public ProcessLauncher {
+public:
+    std::shared_ptr<LaunchedProcess> Launch(const std::string& commandLine) override;
+    std::shared_ptr<LaunchedProcess> Attach(ProcessId pid) override;
+
+    // Ends the process, running its exit callbacks on the calling thread
+    void Exit(ProcessId pid);
+    // A new process in the tree of the launched or attached pid, like a game started by a launcher;
+    // it goes when the tree exits. 0 if pid is not running.
+    ProcessId SpawnChild(ProcessId pid);
+    int LaunchCount() const;
+    // Runs on the launching thread after every Launch, e.g. to open the fake app's window some time later
+    void SetLaunchHandler(std::function<void(ProcessId pid, const std::string& commandLine)> handler);
+
+private:
+    std::shared_ptr<LaunchedProcess> Track(ProcessId pid);
+
+    mutable std::mutex m_mutex;
+    std::function<void(ProcessId, const std::string&)> m_launchHandler;
+    std::map<ProcessId, std::weak_ptr<LaunchedProcess>> m_processes;
+    ProcessId m_nextPid = 1000;
+    int m_launchCount = 0;
+};
+
+// Window owned by the launched tree whose title contains titlePart. If the tree exits without
+// showing a window (single-instance apps handing off to a running copy), falls back to the title alone.
+WindowPredicate MatchProcessWindow(const std::shared_ptr<LaunchedProcess>& process, const std::string& titlePart);
+
+std::unique_ptr<ProcessLauncher> CreatePlatformProcessLauncher();
@@ -0,0 +1,279 @@
+#include "ProcessTelemetry.h"
+
+#include "FrameProfiler.h"
+
+#include <cmath>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#include <tlhelp32.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// TelemetrySampler
+TelemetrySampler::TelemetrySampler(std::unique_ptr<TelemetryProvider> provider, int intervalMs)
+    : m_provider(std::move(provider)), m_intervalMs(intervalMs)
+{
+    m_thread = std::thread([this]() { SamplerThread(); });
+}
+
+TelemetrySampler::~TelemetrySampler()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void TelemetrySampler::Track(uint64_t key, std::shared_ptr<LaunchedProcess> process)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Tree& tree = m_trees[key];
+        tree = Tree();
+        tree.process = std::move(process);
+        m_trackedCount = (int)m_trees.size();
+    }
+    m_wake.notify_one();
+}
+
+void TelemetrySampler::Untrack(uint64_t key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_trees.erase(key);
+    m_trackedCount = (int)m_trees.size();
+}
+
+void TelemetrySampler::SetOnPublish(std::function<void()> onPublish)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_onPublish = std::move(onPublish);
+}
+
+void TelemetrySampler::SamplerThread()
+{
+    GD_PROFILE_THREAD("Telemetry");
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        // Nothing to sample: sleep until something is tracked
+        m_wake.wait(lock, [this]() { return m_stopping || !m_trees.empty(); });
+        if (m_stopping) return;
+
+        // The lock is held for the pass; Track/Untrack are rare and a pass is short
+        {
+            GD_PROFILE_ZONE("Telemetry pass");
+            m_provider->BeginPass();
+            Clock::time_point now = Clock::now();
+            bool changesOnly = m_changesOnly.load(std::memory_order_relaxed);
+            bool published = false;
+            for (auto& entry : m_trees) {
+                Tree& tree = entry.second;
+                TelemetrySample sample = SampleTree(entry.first, tree, now);
+                if (sample.key != entry.first) continue;
+                if (changesOnly && tree.hasPublished && SameSidebarReading(sample, tree.published)) continue;
+                if (!m_samples.TryPush(sample)) {
+                    m_dropped++;
+                    continue;
+                }
+                tree.published = sample;
+                tree.hasPublished = true;
+                published = true;
+            }
+            if (published && m_onPublish) m_onPublish();
+        }
+
+        m_wake.wait_for(lock, std::chrono::milliseconds(m_intervalMs), [this]() { return m_stopping; });
+        if (m_stopping) return;
+    }
+}
+
+bool SameSidebarReading(const TelemetrySample& a, const TelemetrySample& b)
+{
+    const double MB = 1024.0 * 1024.0;
+    return (a.processCount > 0) == (b.processCount > 0) && std::lround(a.cpuPercent) == std::lround(b.cpuPercent) &&
+        std::llround(a.privateBytes / MB) == std::llround(b.privateBytes / MB);
+}
+
+// Returns a sample with a different key when there is nothing to report yet
+TelemetrySample TelemetrySampler::SampleTree(uint64_t key, Tree& tree, Clock::time_point now)
+{
+    TelemetrySample sample;
+    sample.key = ~key;
+
+    std::unordered_map<ProcessId, ProcessCounters> current;
+    uint64_t cpuDeltaNs = 0;
+    uint64_t ioDelta = 0;
+    for (ProcessId pid : tree.process->ProcessTree()) {
+        ProcessCounters counters;
+        if (!m_provider->Read(pid, counters)) continue;
+        current[pid] = counters;
+        sample.privateBytes += counters.privateBytes;
+        sample.threadCount += counters.threadCount;
+        sample.processCount++;
+
+        // Processes new since the last pass only count from the next one
+        auto previous = tree.previous.find(pid);
+        if (previous == tree.previous.end()) continue;
+        if (counters.cpuTimeNs > previous->second.cpuTimeNs) cpuDeltaNs += counters.cpuTimeNs - previous->second.cpuTimeNs;
+        if (counters.ioBytes > previous->second.ioBytes) ioDelta += counters.ioBytes - previous->second.ioBytes;
+    }
+
+    bool hadPrevious = tree.hasPrevious;
+    double elapsedSeconds = std::chrono::duration<double>(now - tree.previousTime).count();
+    tree.previous.swap(current);
+    tree.previousTime = now;
+    tree.hasPrevious = true;
+    if (!hadPrevious || elapsedSeconds <= 0.0) return sample;
+
+    sample.key = key;
+    sample.cpuPercent = (float)(cpuDeltaNs / 1e9 / elapsedSeconds * 100.0);
+    sample.ioBytesPerSecond = (float)(ioDelta / elapsedSeconds);
+    return sample;
+}
+
+// FakeTelemetryProvider
+bool FakeTelemetryProvider::Read(ProcessId pid, ProcessCounters& counters)
+{
+    uint64_t elapsedNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+    // 10% to 40% of a core, 64 MB to 575 MB, 1 MB/s of I/O
+    counters.cpuTimeNs = elapsedNs / 10 * (pid % 4 + 1);
+    counters.privateBytes = (64ull + pid % 512) << 20;
+    counters.ioBytes = elapsedNs / 1000;
+    counters.threadCount = 8 + pid % 24;
+    return true;
+}
+
+// Providers
+namespace {
+
+#ifdef _WIN32
+
+uint64_t FileTimeToNs(const FILETIME& time)
+{
+    return ((uint64_t)time.dwHighDateTime << 32 | time.dwLowDateTime) * 100;
+}
+
+class Win32TelemetryProvider : public TelemetryProvider {
+public:
+    // Thread counts only come from a system-wide snapshot, so take one per pass
+    void BeginPass() override {
+        m_threadCounts.clear();
+        HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+        if (snapshot == INVALID_HANDLE_VALUE) return;
+        PROCESSENTRY32 entry = { sizeof(entry) };
+        for (BOOL more = Process32First(snapshot, &entry); more; more = Process32Next(snapshot, &entry)) {
+            m_threadCounts[(ProcessId)entry.th32ProcessID] = entry.cntThreads;
+        }
+        CloseHandle(snapshot);
+    }
+
+    bool Read(ProcessId pid, ProcessCounters& counters) override {
+        HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+        if (!process) return false;
+
+        FILETIME created, exited, kernel, user;
+        bool ok = GetProcessTimes(process, &created, &exited, &kernel, &user) != FALSE;
+        if (ok) counters.cpuTimeNs = FileTimeToNs(kernel) + FileTimeToNs(user);
+
+        PROCESS_MEMORY_COUNTERS_EX memory = {};
+        if (GetProcessMemoryInfo(process, (PROCESS_MEMORY_COUNTERS*)&memory, sizeof(memory))) counters.privateBytes = memory.PrivateUsage;
+
+        IO_COUNTERS io = {};
+        if (GetProcessIoCounters(process, &io)) counters.ioBytes = io.ReadTransferCount + io.WriteTransferCount + io.OtherTransferCount;
+
+        auto threads = m_threadCounts.find(pid);
+        counters.threadCount = threads != m_threadCounts.end() ? threads->second : 0;
+        CloseHandle(process);
+        return ok;
+    }
+
+private:
+    std::unordered_map<ProcessId, uint32_t> m_threadCounts;
+};
+
+#else
+
+// Reads a small /proc file into buffer without allocating; returns the length or -1
+int ReadProcFile(ProcessId pid, const char* name, char* buffer, size_t size)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%u/%s", (unsigned)pid, name);
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    ssize_t length = read(fd, buffer, size - 1);
+    close(fd);
+    if (length < 0) return -1;
+    buffer[length] = 0;
+    return (int)length;
+}
+
+// Value of "key: 123" in a /proc key-value file
+uint64_t FindValue(const char* text, const char* key)
+{
+    const char* found = strstr(text, key);
+    return found ? strtoull(found + strlen(key), nullptr, 10) : 0;
+}
+
+class ProcTelemetryProvider : public TelemetryProvider {
+public:
+    ProcTelemetryProvider()
+        : m_nsPerTick(1e9 / (double)sysconf(_SC_CLK_TCK)), m_pageSize((uint64_t)sysconf(_SC_PAGESIZE))
+    {
+    }
+
+    bool Read(ProcessId pid, ProcessCounters& counters) override {
+        char buffer[1024];
+
+        // stat: "pid (comm) state ..." - comm may contain spaces, so fields are counted from the last ')'
+        if (ReadProcFile(pid, "stat", buffer, sizeof(buffer)) <= 0) return false;
+        const char* fields = strrchr(buffer, ')');
+        if (!fields) return false;
+        unsigned long long utime = 0, stime = 0;
+        long threads = 0;
+        if (sscanf(fields + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu %*d %*d %*d %*d %ld",
+            &utime, &stime, &threads) != 3) {
+            return false;
+        }
+        counters.cpuTimeNs = (uint64_t)((utime + stime) * m_nsPerTick);
+        counters.threadCount = (uint32_t)threads;
+
+        // statm: size resident shared ... (pages); resident minus file-backed shared pages
+        unsigned long long size = 0, resident = 0, shared = 0;
+        if (ReadProcFile(pid, "statm", buffer, sizeof(buffer)) > 0 && sscanf(buffer, "%llu %llu %llu", &size, &resident, &shared) == 3) {
+            counters.privateBytes = (resident > shared ? resident - shared : 0) * m_pageSize;
+        }
+
+        // io needs the same rights as ptrace; leave it at zero if we do not have them
+        if (ReadProcFile(pid, "io", buffer, sizeof(buffer)) > 0) {
+            counters.ioBytes = FindValue(buffer, "rchar:") + FindValue(buffer, "wchar:");
+        }
+        return true;
+    }
+
+private:
+    double m_nsPerTick;
+    uint64_t m_pageSize;
+};
+
+#endif
+
+}
+
+std::unique_ptr<TelemetryProvider> CreatePlatformTelemetryProvider()
+{
+#ifdef _WIN32
+    return std::make_unique<Win32TelemetryProvider>();
+#else
+    return std::make_unique<ProcTelemetryProvider>();
+#endif
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "ProcessLauncher.h"
+#include "SpscRing.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// OS counters for one process
+struct ProcessCounters {
+    uint64_t cpuTimeNs = 0;     // user + kernel
+    uint64_t privateBytes = 0;
+    uint64_t ioBytes = 0;       // read + written, all kinds of I/O
+    uint32_t threadCount = 0;
+};
+
+// Reads ProcessCounters from the OS. Only used on the sampler thread.
+class TelemetryProvider {
+public:
+    virtual ~TelemetryProvider() = default;
+
+    // Called once before each round of Read() calls, e.g. to take a system-wide snapshot
+    virtual void BeginPass() {}
+    // False if the process is gone or cannot be inspected
+    virtual bool Read(ProcessId pid, ProcessCounters& counters) = 0;
+};
+
+// Made-up counters that grow steadily with time, different per PID; for headless runs
+class FakeTelemetryProvider : public TelemetryProvider {
+public:
+    bool Read(ProcessId pid, ProcessCounters& counters) override;
+
+private:
+    std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+};
+
+// GetProcessTimes/GetProcessMemoryInfo/GetProcessIoCounters on Win32, /proc elsewhere
+std::unique_ptr<TelemetryProvider> CreatePlatformTelemetryProvider();
+
+// One reading for a whole process tree
+struct TelemetrySample {
+    uint64_t key = 0;           // as passed to TelemetrySampler::Track
+    float cpuPercent = 0.0f;    // 100 = one full core
+    uint64_t privateBytes = 0;
+    float ioBytesPerSecond = 0.0f;
+    uint32_t threadCount = 0;
+    uint32_t processCount = 0;
+};
+
+// Whether the two would read the same in the sidebar: whole CPU percent and whole megabytes
+bool SameSidebarReading(const TelemetrySample& a, const TelemetrySample& b);
+
+// Samples tracked process trees on its own thread and publishes the results through a fixed-size
+// SPSC ring, so the UI thread picks them up without system calls or locks.
+class TelemetrySampler {
+public:
+    static const int INTERVAL_MS = 250;
+    static const size_t RING_CAPACITY = 64;
+
+    explicit TelemetrySampler(std::unique_ptr<TelemetryProvider> provider, int intervalMs = INTERVAL_MS);
+    ~TelemetrySampler();
+
+    TelemetrySampler(const TelemetrySampler&) = delete;
+    TelemetrySampler& operator=(const TelemetrySampler&) = delete;
+
+    // Tracking a key again replaces its tree. Rates need two passes, so the first sample comes one interval later.
+    void Track(uint64_t key, std::shared_ptr<LaunchedProcess> process);
+    void Untrack(uint64_t key);
+    bool IsTracking() const { return m_trackedCount.load(std::memory_order_relaxed) > 0; }
+
+    // While set, a tree's sample is only published when SameSidebarReading says it differs from the last
+    // one published, so a steady tree does not keep the consumer busy. Off by default.
+    void SetChangesOnly(bool changesOnly) { m_changesOnly.store(changesOnly, std::memory_order_relaxed); }
+    // Called on the sampler thread after a pass that published anything, e.g. to wake the consumer
+    void SetOnPublish(std::function<void()> onPublish);
+
+    // Consumer (UI) thread only
+    bool TryPop(TelemetrySample& sample) { return m_samples.TryPop(sample); }
+
+    // Samples lost because the consumer did not drain the ring in time
+    uint64_t DroppedSamples() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Tree {
+        std::shared_ptr<LaunchedProcess> process;
+        // Counters from the previous pass, for the rates
+        std::unordered_map<ProcessId, ProcessCounters> previous;
+        Clock::time_point previousTime;
+        bool hasPrevious = false;
+        TelemetrySample published;
+        bool hasPublished = false;
+    };
+
+    void SamplerThread();
+    TelemetrySample SampleTree(uint64_t key, Tree& tree, Clock::time_point now);
+
+    std::unique_ptr<TelemetryProvider> m_provider;
+    int m_intervalMs;
+    SpscRing<TelemetrySample, RING_CAPACITY> m_samples;
+    std::atomic<uint64_t> m_dropped{ 0 };
+    std::atomic<int> m_trackedCount{ 0 };
+    std::atomic<bool> m_changesOnly{ false };
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::map<uint64_t, Tree> m_trees;
+    std::function<void()> m_onPublish;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
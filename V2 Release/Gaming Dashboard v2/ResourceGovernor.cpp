@@ -0,0 +1,377 @@
+#include "ResourceGovernor.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+ThrottlePolicy DefaultThrottlePolicy()
+{
+    ThrottlePolicy policy;
+    policy.efficiencyMode = true;
+    // With fewer than four CPUs there is nothing to spare
+    int cpuCount = (int)std::thread::hardware_concurrency();
+    if (cpuCount >= 4) {
+        for (int cpu = cpuCount - cpuCount / 4; cpu < cpuCount; cpu++) policy.cpus.push_back(cpu);
+    }
+    return policy;
+}
+
+namespace {
+
+// Bookkeeping shared by the platform implementations: what each process in a throttled tree had
+// before, keyed by tree and PID, and which members are spared. Saved is the platform's per-process state.
+template <typename Saved>
+class TreeGovernor : public ResourceGovernor {
+public:
+    void Throttle(const LaunchedProcess& process, const ThrottlePolicy& policy, const std::vector<ProcessId>& spared) override {
+        Tree& tree = m_trees[&process];
+        std::map<ProcessId, Saved>& saved = tree.saved;
+        for (ProcessId pid : process.ProcessTree()) {
+            if (pid == SelfPid()) continue;
+            if (std::find(spared.begin(), spared.end(), pid) != spared.end()) {
+                auto it = saved.find(pid);
+                if (it != saved.end()) {
+                    RestoreProcess(pid, it->second);
+                    saved.erase(it);
+                }
+                tree.spared.insert(pid);
+                continue;
+            }
+            tree.spared.erase(pid);
+            if (saved.count(pid)) continue;
+            Saved state;
+            if (ThrottleProcess(pid, policy, state)) saved[pid] = state;
+        }
+        ThrottleTree(process, policy);
+    }
+
+    bool Restore(const LaunchedProcess& process) override {
+        auto tree = m_trees.find(&process);
+        if (tree == m_trees.end()) return true;
+
+        bool restored = RestoreTree(process);
+        const std::map<ProcessId, Saved>& saved = tree->second.saved;
+        if (!saved.empty()) {
+            // Processes that joined the tree while it was hidden inherited the throttled settings;
+            // they get the leader's originals (or any member's, if the leader is gone)
+            auto leader = saved.find(process.Pid());
+            const Saved& fallback = leader != saved.end() ? leader->second : saved.begin()->second;
+            for (ProcessId pid : process.ProcessTree()) {
+                if (pid == SelfPid() || tree->second.spared.count(pid)) continue;
+                auto it = saved.find(pid);
+                if (!RestoreProcess(pid, it != saved.end() ? it->second : fallback)) restored = false;
+            }
+        }
+        m_trees.erase(tree);
+        return restored;
+    }
+
+    bool IsThrottled(const LaunchedProcess& process) const override {
+        return m_trees.count(&process) != 0;
+    }
+
+protected:
+    virtual ProcessId SelfPid() const = 0;
+    // Saves the process's current settings into state and applies the policy; false if it is gone
+    virtual bool ThrottleProcess(ProcessId pid, const ThrottlePolicy& policy, Saved& state) = 0;
+    virtual bool RestoreProcess(ProcessId pid, const Saved& state) = 0;
+    // Whole-tree settings, applied after the processes
+    virtual void ThrottleTree(const LaunchedProcess&, const ThrottlePolicy&) {}
+    virtual bool RestoreTree(const LaunchedProcess&) { return true; }
+
+private:
+    struct Tree {
+        std::map<ProcessId, Saved> saved;
+        // Never touched again, not even by Restore, until a later Throttle stops sparing them
+        std::set<ProcessId> spared;
+    };
+    std::map<const LaunchedProcess*, Tree> m_trees;
+};
+
+#ifdef _WIN32
+
+struct Win32SavedProcess {
+    DWORD priorityClass = NORMAL_PRIORITY_CLASS;
+    DWORD_PTR affinity = 0;
+    bool changedPriority = false;
+    bool changedThrottling = false;
+    bool changedAffinity = false;
+};
+
+// Priority classes are flags, not ordered values
+int PriorityRank(DWORD priorityClass)
+{
+    switch (priorityClass) {
+    case IDLE_PRIORITY_CLASS: return 0;
+    case BELOW_NORMAL_PRIORITY_CLASS: return 1;
+    case NORMAL_PRIORITY_CLASS: return 2;
+    case ABOVE_NORMAL_PRIORITY_CLASS: return 3;
+    case HIGH_PRIORITY_CLASS: return 4;
+    case REALTIME_PRIORITY_CLASS: return 5;
+    default: return 2;
+    }
+}
+
+// EcoQoS: lets Windows run the process at low clock speeds and on efficiency cores.
+// Clearing the control mask hands the decision back to the system.
+void SetPowerThrottling(HANDLE process, bool enabled)
+{
+    PROCESS_POWER_THROTTLING_STATE state = {};
+    state.Version = PROCESS_POWER_THROTTLING_CURRENT_VERSION;
+    state.ControlMask = enabled ? PROCESS_POWER_THROTTLING_EXECUTION_SPEED : 0;
+    state.StateMask = enabled ? PROCESS_POWER_THROTTLING_EXECUTION_SPEED : 0;
+    SetProcessInformation(process, ProcessPowerThrottling, &state, sizeof(state));
+}
+
+class Win32ResourceGovernor : public TreeGovernor<Win32SavedProcess> {
+protected:
+    ProcessId SelfPid() const override { return (ProcessId)GetCurrentProcessId(); }
+
+    bool ThrottleProcess(ProcessId pid, const ThrottlePolicy& policy, Win32SavedProcess& state) override {
+        HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_SET_INFORMATION | PROCESS_SET_QUOTA, FALSE, pid);
+        if (!process) return false;
+
+        state.priorityClass = GetPriorityClass(process);
+        DWORD target = policy.efficiencyMode ? IDLE_PRIORITY_CLASS : BELOW_NORMAL_PRIORITY_CLASS;
+        if ((policy.lowerPriority || policy.efficiencyMode) && state.priorityClass && PriorityRank(state.priorityClass) > PriorityRank(target)) {
+            state.changedPriority = SetPriorityClass(process, target) != FALSE;
+        }
+        if (policy.efficiencyMode) {
+            SetPowerThrottling(process, true);
+            state.changedThrottling = true;
+        }
+
+        DWORD_PTR processMask = 0;
+        DWORD_PTR systemMask = 0;
+        if (!policy.cpus.empty() && GetProcessAffinityMask(process, &processMask, &systemMask)) {
+            // The mask covers the process's processor group, i.e. the first 64 CPUs
+            DWORD_PTR mask = 0;
+            for (int cpu : policy.cpus) {
+                if (cpu >= 0 && cpu < (int)(sizeof(DWORD_PTR) * 8)) mask |= (DWORD_PTR)1 << cpu;
+            }
+            mask &= systemMask;
+            if (mask && mask != processMask && SetProcessAffinityMask(process, mask)) {
+                state.affinity = processMask;
+                state.changedAffinity = true;
+            }
+        }
+
+        // Pages fault back in when the tab is used again, so there is nothing to restore
+        if (policy.trimMemory) SetProcessWorkingSetSize(process, (SIZE_T)-1, (SIZE_T)-1);
+
+        CloseHandle(process);
+        return true;
+    }
+
+    bool RestoreProcess(ProcessId pid, const Win32SavedProcess& state) override {
+        HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION | PROCESS_SET_INFORMATION, FALSE, pid);
+        if (!process) return true;
+
+        bool restored = true;
+        if (state.changedPriority && !SetPriorityClass(process, state.priorityClass)) restored = false;
+        if (state.changedThrottling) SetPowerThrottling(process, false);
+        if (state.changedAffinity && !SetProcessAffinityMask(process, state.affinity)) restored = false;
+        CloseHandle(process);
+        return restored;
+    }
+};
+
+#else
+
+struct PosixSavedProcess {
+    int nice = 0;
+    int policy = SCHED_OTHER;
+    cpu_set_t affinity;
+    bool changedNice = false;
+    bool changedPolicy = false;
+    bool changedAffinity = false;
+};
+
+// Scheduling attributes are per thread on Linux, so every one of them is changed
+std::vector<pid_t> ProcessThreads(pid_t pid)
+{
+    std::vector<pid_t> threads;
+    DIR* tasks = opendir(("/proc/" + std::to_string(pid) + "/task").c_str());
+    if (!tasks) return threads;
+    while (dirent* entry = readdir(tasks)) {
+        pid_t tid = (pid_t)atoi(entry->d_name);
+        if (tid > 0) threads.push_back(tid);
+    }
+    closedir(tasks);
+    return threads;
+}
+
+// Unprivileged processes may only lower their nice value as far as RLIMIT_NICE allows, so a
+// priority that cannot be put back is never lowered
+bool CanRaisePriorityTo(int nice)
+{
+    if (geteuid() == 0) return true;
+    rlimit limit;
+    if (getrlimit(RLIMIT_NICE, &limit) != 0) return false;
+    return limit.rlim_cur == RLIM_INFINITY || 20 - nice <= (int)limit.rlim_cur;
+}
+
+std::string ReadFirstLine(const std::string& path)
+{
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+bool WriteValue(const std::string& path, const std::string& value)
+{
+    std::ofstream out(path);
+    out << value;
+    out.flush();
+    return (bool)out;
+}
+
+// Directory of the process's cgroup v2 node, empty if there is none
+std::string CgroupPath(ProcessId pid)
+{
+    std::ifstream in("/proc/" + std::to_string(pid) + "/cgroup");
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.compare(0, 3, "0::") == 0) return "/sys/fs/cgroup" + line.substr(3);
+    }
+    return std::string();
+}
+
+class PosixResourceGovernor : public TreeGovernor<PosixSavedProcess> {
+protected:
+    ProcessId SelfPid() const override { return (ProcessId)getpid(); }
+
+    bool ThrottleProcess(ProcessId pid, const ThrottlePolicy& policy, PosixSavedProcess& state) override {
+        errno = 0;
+        state.nice = getpriority(PRIO_PROCESS, (id_t)pid);
+        if (errno != 0) return false;
+        state.policy = sched_getscheduler((pid_t)pid);
+        if (state.policy < 0) return false;
+        bool hasAffinity = sched_getaffinity((pid_t)pid, sizeof(state.affinity), &state.affinity) == 0;
+
+        int targetNice = policy.efficiencyMode ? 19 : 10;
+        bool lower = (policy.lowerPriority || policy.efficiencyMode) && state.nice < targetNice;
+        // SCHED_BATCH is the fallback that can always be undone, as long as nice stays put
+        bool useNice = lower && CanRaisePriorityTo(state.nice);
+        bool useBatch = lower && !useNice && state.policy == SCHED_OTHER;
+
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int cpu : policy.cpus) {
+            if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &cpus);
+        }
+        bool setAffinity = hasAffinity && CPU_COUNT(&cpus) > 0;
+
+        for (pid_t tid : ProcessThreads((pid_t)pid)) {
+            if (useNice && setpriority(PRIO_PROCESS, (id_t)tid, targetNice) == 0) state.changedNice = true;
+            if (useBatch) {
+                sched_param param = {};
+                if (sched_setscheduler(tid, SCHED_BATCH, &param) == 0) state.changedPolicy = true;
+            }
+            if (setAffinity && sched_setaffinity(tid, sizeof(cpus), &cpus) == 0) state.changedAffinity = true;
+        }
+        return true;
+    }
+
+    bool RestoreProcess(ProcessId pid, const PosixSavedProcess& state) override {
+        bool restored = true;
+        for (pid_t tid : ProcessThreads((pid_t)pid)) {
+            if (state.changedNice && setpriority(PRIO_PROCESS, (id_t)tid, state.nice) != 0 && errno != ESRCH) restored = false;
+            if (state.changedPolicy) {
+                sched_param param = {};
+                if (sched_setscheduler(tid, state.policy, &param) != 0 && errno != ESRCH) restored = false;
+            }
+            if (state.changedAffinity && sched_setaffinity(tid, sizeof(state.affinity), &state.affinity) != 0 && errno != ESRCH) restored = false;
+        }
+        return restored;
+    }
+
+    // memory.high applies to the whole cgroup, so it is only touched when the cgroup holds nothing but
+    // this tree (e.g. an app launched into its own systemd scope), never the dashboard's own session
+    void ThrottleTree(const LaunchedProcess& process, const ThrottlePolicy& policy) override {
+        if (!policy.trimMemory || m_memoryLimits.count(&process)) return;
+
+        std::string cgroup = CgroupPath(process.Pid());
+        if (cgroup.empty() || cgroup == CgroupPath(SelfPid())) return;
+
+        std::ifstream procs(cgroup + "/cgroup.procs");
+        std::string line;
+        while (std::getline(procs, line)) {
+            if (!process.Contains((ProcessId)atoi(line.c_str()))) return;
+        }
+
+        std::string memoryHigh = cgroup + "/memory.high";
+        std::string original = ReadFirstLine(memoryHigh);
+        if (original.empty()) return;
+        if (WriteValue(memoryHigh, std::to_string(policy.memoryHighBytes))) m_memoryLimits[&process] = { memoryHigh, original };
+    }
+
+    bool RestoreTree(const LaunchedProcess& process) override {
+        auto it = m_memoryLimits.find(&process);
+        if (it == m_memoryLimits.end()) return true;
+        bool restored = WriteValue(it->second.first, it->second.second);
+        m_memoryLimits.erase(it);
+        return restored;
+    }
+
+private:
+    // memory.high file and its value before throttling
+    std::map<const LaunchedProcess*, std::pair<std::string, std::string>> m_memoryLimits;
+};
+
+#endif
+
+}
+
+// FakeResourceGovernor
+void FakeResourceGovernor::Throttle(const LaunchedProcess& process, const ThrottlePolicy&, const std::vector<ProcessId>& spared)
+{
+    std::set<ProcessId>& throttled = m_throttled[&process];
+    for (ProcessId pid : process.ProcessTree()) {
+        if (std::find(spared.begin(), spared.end(), pid) != spared.end()) throttled.erase(pid);
+        else throttled.insert(pid);
+    }
+}
+
+bool FakeResourceGovernor::Restore(const LaunchedProcess& process)
+{
+    m_throttled.erase(&process);
+    return true;
+}
+
+bool FakeResourceGovernor::IsThrottled(const LaunchedProcess& process) const
+{
+    return m_throttled.count(&process) != 0;
+}
+
+bool FakeResourceGovernor::IsProcessThrottled(ProcessId pid) const
+{
+    for (const auto& tree : m_throttled) {
+        if (tree.second.count(pid)) return true;
+    }
+    return false;
+}
+
+std::unique_ptr<ResourceGovernor> CreatePlatformResourceGovernor()
+{
+#ifdef _WIN32
+    return std::make_unique<Win32ResourceGovernor>();
+#else
+    return std::make_unique<PosixResourceGovernor>();
+#endif
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "ProcessLauncher.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+// What happens to the process tree behind a hidden tab
+struct ThrottlePolicy {
+    // Below-normal priority (nice 10 on Linux)
+    bool lowerPriority = true;
+    // Idle priority plus EcoQoS on Win32, nice 19 on Linux
+    bool efficiencyMode = false;
+    // Logical CPUs the tree may run on while hidden; empty leaves affinity alone
+    std::vector<int> cpus;
+    // Win32: empty the working set once when hidden. Linux: lower memory.high of the tree's cgroup
+    // to memoryHighBytes, but only when that cgroup holds nothing but the tree.
+    bool trimMemory = false;
+    uint64_t memoryHighBytes = 256ull << 20;
+};
+
+// Efficiency mode on the top quarter of the CPUs, leaving the rest to whatever is in the foreground
+ThrottlePolicy DefaultThrottlePolicy();
+
+// Applies a ThrottlePolicy to hidden tabs and puts everything back when they are shown again.
+// Only processes that are still in the tree are restored, so a recycled PID is never touched. UI thread only.
+class ResourceGovernor {
+public:
+    virtual ~ResourceGovernor() = default;
+
+    // Remembers each process's current settings, then applies the policy. Calling it again for a
+    // throttled tree also covers processes that joined the tree since. Members in spared are left
+    // alone (e.g. a game started from the tab, with a window of its own) and restored if an earlier
+    // call throttled them.
+    virtual void Throttle(const LaunchedProcess& process, const ThrottlePolicy& policy, const std::vector<ProcessId>& spared) = 0;
+    // Returns false if some setting could not be put back (e.g. not allowed to raise priority again)
+    virtual bool Restore(const LaunchedProcess& process) = 0;
+    virtual bool IsThrottled(const LaunchedProcess& process) const = 0;
+};
+
+// Remembers which trees and processes are throttled without touching any process; for headless runs
+class FakeResourceGovernor : public ResourceGovernor {
+public:
+    void Throttle(const LaunchedProcess& process, const ThrottlePolicy& policy, const std::vector<ProcessId>& spared) override;
+    bool Restore(const LaunchedProcess& process) override;
+    bool IsThrottled(const LaunchedProcess& process) const override;
+
+    int ThrottledCount() const { return (int)m_throttled.size(); }
+    bool IsProcessThrottled(ProcessId pid) const;
+
+private:
+    std::map<const LaunchedProcess*, std::set<ProcessId>> m_throttled;
+};
+
+// SetPriorityClass/EcoQoS/affinity/working set on Win32; setpriority, sched_setaffinity and cgroup v2 elsewhere
+std::unique_ptr<ResourceGovernor> CreatePlatformResourceGovernor();
@@ -0,0 +1,451 @@
+#include "SettingsStore.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+static const char SETTINGS_HEADER[] = "GamingDashboardSettings";
+
+// Values are one line each; escape the characters that would break that
+static void AppendEscaped(std::string& out, const std::string& value)
+{
+    for (char c : value) {
+        switch (c) {
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        default: out += c; break;
+        }
+    }
+}
+
+static std::string Unescape(std::string_view value)
+{
+    std::string out;
+    out.reserve(value.size());
+    for (size_t i = 0; i < value.size(); i++) {
+        if (value[i] != '\\' || i + 1 == value.size()) {
+            out += value[i];
+            continue;
+        }
+        char next = value[++i];
+        if (next == 'n') out += '\n';
+        else if (next == 'r') out += '\r';
+        else out += next;
+    }
+    return out;
+}
+
+static void AppendLine(std::string& out, const char* key, const std::string& value)
+{
+    out += key;
+    out += '=';
+    AppendEscaped(out, value);
+    out += '\n';
+}
+
+// FileSettingsStore
+FileSettingsStore::FileSettingsStore(std::string path)
+    : m_path(std::move(path))
+{
+}
+
+bool FileSettingsStore::Load(DashboardSettings& settings)
+{
+    // One read for the whole file
+    std::ifstream in(m_path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    std::string data((size_t)in.tellg(), '\0');
+    in.seekg(0);
+    if (!in.read(&data[0], data.size())) return false;
+
+    std::string_view rest(data);
+    auto nextLine = [&rest]() {
+        size_t end = rest.find('\n');
+        std::string_view line = rest.substr(0, end);
+        rest = end == std::string_view::npos ? std::string_view() : rest.substr(end + 1);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        return line;
+    };
+
+    // "GamingDashboardSettings <version>"; refuse files from a newer build rather than dropping their data
+    std::string_view header = nextLine();
+    std::string_view expected(SETTINGS_HEADER);
+    if (header.substr(0, expected.size()) != expected || header.size() <= expected.size() + 1) return false;
+    int version = std::atoi(std::string(header.substr(expected.size() + 1)).c_str());
+    if (version < 1 || version > VERSION) return false;
+
+    DashboardSettings loaded;
+    CustomAppSettings* app = nullptr;
+    LaunchProfileSettings* profile = nullptr;
+    LaunchCostSettings* cost = nullptr;
+    LaunchLatencySettings* latency = nullptr;
+    bool session = false;
+    bool unknownSection = false;
+    while (!rest.empty()) {
+        std::string_view line = nextLine();
+        if (line.empty() || line[0] == '#') continue;
+        if (line[0] == '[') {
+            app = nullptr;
+            profile = nullptr;
+            cost = nullptr;
+            latency = nullptr;
+            session = false;
+            unknownSection = false;
+            if (line == "[App]") {
+                loaded.customApps.emplace_back();
+                app = &loaded.customApps.back();
+            }
+            else if (line == "[Profile]") {
+                loaded.launchProfiles.emplace_back();
+                profile = &loaded.launchProfiles.back();
+            }
+            else if (line == "[LaunchCost]") {
+                loaded.launchCosts.emplace_back();
+                cost = &loaded.launchCosts.back();
+            }
+            else if (line == "[Session]") {
+                session = true;
+            }
+            else if (line == "[LaunchLatency]") {
+                loaded.launchLatencies.emplace_back();
+                latency = &loaded.launchLatencies.back();
+            }
+            else {
+                // A section from a newer build; its keys must not land in the section before it
+                unknownSection = true;
+            }
+            continue;
+        }
+        if (unknownSection) continue;
+
+        size_t equals = line.find('=');
+        if (equals == std::string_view::npos) continue;
+        std::string_view key = line.substr(0, equals);
+        std::string value = Unescape(line.substr(equals + 1));
+
+        // Unknown keys are skipped so older builds can read newer files of the same version
+        if (session) {
+            // "Pid" belongs to the "App" line above it
+            if (key == "App") loaded.sessionTabs.push_back({ std::move(value), 0 });
+            else if (key == "Pid" && !loaded.sessionTabs.empty()) loaded.sessionTabs.back().pid = (uint32_t)std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (latency) {
+            if (key == "Name") latency->name = std::move(value);
+            else if (key == "ProcessStart") latency->processStart = std::move(value);
+            else if (key == "FirstWindow") latency->firstWindow = std::move(value);
+            else if (key == "WindowReady") latency->windowReady = std::move(value);
+            else if (key == "Embedded") latency->embedded = std::move(value);
+            else if (key == "Settle") latency->settle = std::move(value);
+        }
+        else if (cost) {
+            if (key == "Name") cost->name = std::move(value);
+            else if (key == "ReadBytes") cost->readBytes = std::strtoull(value.c_str(), nullptr, 10);
+            else if (key == "StartupMs") cost->startupMs = (uint32_t)std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (profile) {
+            // "After" belongs to the "App" line above it
+            if (key == "Name") profile->name = std::move(value);
+            else if (key == "App") profile->apps.push_back({ std::move(value), {} });
+            else if (key == "After" && !profile->apps.empty()) profile->apps.back().after.push_back(std::move(value));
+        }
+        else if (!app) {
+            if (key == "ChromePath") loaded.chromePath = std::move(value);
+            else if (key == "SteamPath") loaded.steamPath = std::move(value);
+            else if (key == "DiscordPath") loaded.discordPath = std::move(value);
+        }
+        else {
+            // Files from older builds also have "Delay", the fixed wait after the window showed; launch
+            // history replaces it
+            if (key == "Name") app->name = std::move(value);
+            else if (key == "Path") app->exePath = std::move(value);
+            else if (key == "Icon") app->iconPath = std::move(value);
+            else if (key == "WindowTitle") app->windowTitle = std::move(value);
+            else if (key == "ReadyMinWidth") app->readiness.minWidth = std::atoi(value.c_str());
+            else if (key == "ReadyMinHeight") app->readiness.minHeight = std::atoi(value.c_str());
+            else if (key == "ReadyClass") app->readiness.className = std::move(value);
+            else if (key == "ReadyTitle") app->readiness.titlePattern = std::move(value);
+            else if (key == "ReadyStyle") app->readiness.requiredStyle = (uint32_t)std::strtoul(value.c_str(), nullptr, 0);
+            else if (key == "ReadyNotStyle") app->readiness.excludedStyle = (uint32_t)std::strtoul(value.c_str(), nullptr, 0);
+            else if (key == "ReadyStableMs") app->readiness.stableMs = std::atoi(value.c_str());
+            else if (key == "ThrottleWhenHidden") app->throttleWhenHidden = value != "0";
+        }
+    }
+
+    if (!loaded.chromePath.empty()) settings.chromePath = loaded.chromePath;
+    if (!loaded.steamPath.empty()) settings.steamPath = loaded.steamPath;
+    if (!loaded.discordPath.empty()) settings.discordPath = loaded.discordPath;
+    settings.customApps.clear();
+    for (CustomAppSettings& loadedApp : loaded.customApps) {
+        if (!loadedApp.name.empty() && !loadedApp.exePath.empty()) {
+            settings.customApps.push_back(std::move(loadedApp));
+        }
+    }
+    settings.launchProfiles.clear();
+    for (LaunchProfileSettings& loadedProfile : loaded.launchProfiles) {
+        if (!loadedProfile.name.empty() && !loadedProfile.apps.empty()) {
+            settings.launchProfiles.push_back(std::move(loadedProfile));
+        }
+    }
+    settings.launchCosts.clear();
+    for (LaunchCostSettings& loadedCost : loaded.launchCosts) {
+        if (!loadedCost.name.empty() && loadedCost.startupMs > 0) settings.launchCosts.push_back(std::move(loadedCost));
+    }
+    settings.launchLatencies.clear();
+    for (LaunchLatencySettings& loadedLatency : loaded.launchLatencies) {
+        if (!loadedLatency.name.empty()) settings.launchLatencies.push_back(std::move(loadedLatency));
+    }
+    settings.sessionTabs.clear();
+    for (SessionTabSettings& loadedTab : loaded.sessionTabs) {
+        if (!loadedTab.name.empty() && loadedTab.pid != 0) settings.sessionTabs.push_back(std::move(loadedTab));
+    }
+    return true;
+}
+
+bool FileSettingsStore::Exists() const
+{
+    std::error_code error;
+    return std::filesystem::exists(m_path, error);
+}
+
+bool FileSettingsStore::Save(const DashboardSettings& settings)
+{
+    std::string data;
+    data.reserve(256 + settings.customApps.size() * 192);
+    data += SETTINGS_HEADER;
+    data += ' ';
+    data += std::to_string(VERSION);
+    data += '\n';
+    AppendLine(data, "ChromePath", settings.chromePath);
+    AppendLine(data, "SteamPath", settings.steamPath);
+    AppendLine(data, "DiscordPath", settings.discordPath);
+    for (const CustomAppSettings& app : settings.customApps) {
+        data += "\n[App]\n";
+        AppendLine(data, "Name", app.name);
+        AppendLine(data, "Path", app.exePath);
+        AppendLine(data, "Icon", app.iconPath);
+        AppendLine(data, "WindowTitle", app.windowTitle);
+        if (!app.readiness.IsEmpty()) {
+            const ReadinessRule& rule = app.readiness;
+            char style[16];
+            AppendLine(data, "ReadyMinWidth", std::to_string(rule.minWidth));
+            AppendLine(data, "ReadyMinHeight", std::to_string(rule.minHeight));
+            AppendLine(data, "ReadyClass", rule.className);
+            AppendLine(data, "ReadyTitle", rule.titlePattern);
+            snprintf(style, sizeof(style), "0x%08X", rule.requiredStyle);
+            AppendLine(data, "ReadyStyle", style);
+            snprintf(style, sizeof(style), "0x%08X", rule.excludedStyle);
+            AppendLine(data, "ReadyNotStyle", style);
+            AppendLine(data, "ReadyStableMs", std::to_string(rule.stableMs));
+        }
+        if (!app.throttleWhenHidden) AppendLine(data, "ThrottleWhenHidden", "0");
+    }
+    for (const LaunchProfileSettings& profile : settings.launchProfiles) {
+        data += "\n[Profile]\n";
+        AppendLine(data, "Name", profile.name);
+        for (const LaunchProfileAppSettings& member : profile.apps) {
+            AppendLine(data, "App", member.name);
+            for (const std::string& dependency : member.after) {
+                AppendLine(data, "After", dependency);
+            }
+        }
+    }
+    for (const LaunchCostSettings& cost : settings.launchCosts) {
+        data += "\n[LaunchCost]\n";
+        AppendLine(data, "Name", cost.name);
+        AppendLine(data, "ReadBytes", std::to_string(cost.readBytes));
+        AppendLine(data, "StartupMs", std::to_string(cost.startupMs));
+    }
+    if (!settings.sessionTabs.empty()) {
+        data += "\n[Session]\n";
+        for (const SessionTabSettings& tab : settings.sessionTabs) {
+            AppendLine(data, "App", tab.name);
+            AppendLine(data, "Pid", std::to_string(tab.pid));
+        }
+    }
+    for (const LaunchLatencySettings& latency : settings.launchLatencies) {
+        data += "\n[LaunchLatency]\n";
+        AppendLine(data, "Name", latency.name);
+        AppendLine(data, "ProcessStart", latency.processStart);
+        AppendLine(data, "FirstWindow", latency.firstWindow);
+        AppendLine(data, "WindowReady", latency.windowReady);
+        AppendLine(data, "Embedded", latency.embedded);
+        AppendLine(data, "Settle", latency.settle);
+    }
+
+    std::error_code error;
+    std::filesystem::path path(m_path);
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), error);
+
+    // Readers only ever see the old file or the complete new one
+    std::string tempPath = m_path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(data.data(), data.size());
+        out.flush();
+        if (!out) {
+            out.close();
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+    }
+    std::filesystem::rename(tempPath, m_path, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+// RegistrySettingsStore
+#ifdef _WIN32
+static bool ReadRegistryString(HKEY key, const std::string& name, std::string& value)
+{
+    char buffer[512];
+    DWORD bufferSize = sizeof(buffer);
+    if (RegQueryValueExA(key, name.c_str(), NULL, NULL, (LPBYTE)buffer, &bufferSize) != ERROR_SUCCESS) return false;
+    value = buffer;
+    return true;
+}
+
+bool RegistrySettingsStore::Load(DashboardSettings& settings)
+{
+    HKEY hKey;
+    if (RegOpenKeyExA(HKEY_CURRENT_USER, "SOFTWARE\\GamingDashboard", 0, KEY_READ, &hKey) != ERROR_SUCCESS) return false;
+
+    ReadRegistryString(hKey, "ChromePath", settings.chromePath);
+    ReadRegistryString(hKey, "SteamPath", settings.steamPath);
+    ReadRegistryString(hKey, "DiscordPath", settings.discordPath);
+
+    DWORD customAppCount = 0;
+    DWORD bufferSize = sizeof(DWORD);
+    if (RegQueryValueExA(hKey, "CustomAppCount", NULL, NULL, (LPBYTE)&customAppCount, &bufferSize) == ERROR_SUCCESS) {
+        settings.customApps.clear();
+        for (DWORD i = 0; i < customAppCount; i++) {
+            CustomAppSettings app;
+            std::string prefix = "CustomApp" + std::to_string(i);
+            ReadRegistryString(hKey, prefix + "_Name", app.name);
+            ReadRegistryString(hKey, prefix + "_Path", app.exePath);
+            ReadRegistryString(hKey, prefix + "_Icon", app.iconPath);
+            ReadRegistryString(hKey, prefix + "_WindowTitle", app.windowTitle);
+
+            if (!app.name.empty() && !app.exePath.empty()) {
+                settings.customApps.push_back(app);
+            }
+        }
+    }
+
+    RegCloseKey(hKey);
+    return true;
+}
+
+bool RegistrySettingsStore::Exists() const
+{
+    HKEY hKey;
+    if (RegOpenKeyExA(HKEY_CURRENT_USER, "SOFTWARE\\GamingDashboard", 0, KEY_READ, &hKey) != ERROR_SUCCESS) return false;
+    RegCloseKey(hKey);
+    return true;
+}
+
+bool RegistrySettingsStore::Save(const DashboardSettings&)
+{
+    // Import only; new settings go to the settings file
+    return false;
+}
+#endif
+
+// MemorySettingsStore
+bool MemorySettingsStore::Load(DashboardSettings& settings)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_saved) return false;
+    settings = *m_saved;
+    return true;
+}
+
+bool MemorySettingsStore::Save(const DashboardSettings& settings)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_saved = std::make_unique<DashboardSettings>(settings);
+    return true;
+}
+
+bool MemorySettingsStore::Exists() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_saved != nullptr;
+}
+
+std::string DefaultSettingsPath()
+{
+#ifdef _WIN32
+    char appData[MAX_PATH];
+    DWORD length = GetEnvironmentVariableA("APPDATA", appData, sizeof(appData));
+    if (length > 0 && length < sizeof(appData)) return std::string(appData) + "\\GamingDashboard\\settings.txt";
+    return "settings.txt";
+#else
+    const char* configHome = std::getenv("XDG_CONFIG_HOME");
+    if (configHome && *configHome) return std::string(configHome) + "/gaming-dashboard/settings.txt";
+    const char* home = std::getenv("HOME");
+    if (home && *home) return std::string(home) + "/.config/gaming-dashboard/settings.txt";
+    return "settings.txt";
+#endif
+}
+
+// SettingsWriter
+SettingsWriter::SettingsWriter(SettingsStore& store)
+    : m_store(store)
+{
+    m_thread = std::thread([this]() { WriterThread(); });
+}
+
+SettingsWriter::~SettingsWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void SettingsWriter::Save(DashboardSettings settings)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending = std::make_unique<DashboardSettings>(std::move(settings));
+    }
+    m_wake.notify_one();
+}
+
+void SettingsWriter::Flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return !m_pending && !m_writing; });
+}
+
+void SettingsWriter::WriterThread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wake.wait(lock, [this]() { return m_pending || m_stopping; });
+        // Pending data is written even when stopping
+        if (!m_pending) return;
+
+        std::unique_ptr<DashboardSettings> settings = std::move(m_pending);
+        m_writing = true;
+        lock.unlock();
+        m_store.Save(*settings);
+        lock.lock();
+        m_writing = false;
+        if (!m_pending) m_idle.notify_all();
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "WindowReadiness.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct CustomAppSettings {
+    std::string name;
+    std::string exePath;
+    std::string iconPath;
+    std::string windowTitle;
+    ReadinessRule readiness;
+    bool throttleWhenHidden = true;
+};
+
+// A member of a launch profile. Apps are referred to by name, so built-in apps work too.
+struct LaunchProfileAppSettings {
+    std::string name;
+    // Members whose window must be up before this one starts
+    std::vector<std::string> after;
+};
+
+// Apps started together with one click
+struct LaunchProfileSettings {
+    std::string name;
+    std::vector<LaunchProfileAppSettings> apps;
+};
+
+// Measured cold-start cost of an app, so launch scheduling does not start from scratch every run
+struct LaunchCostSettings {
+    std::string name;
+    uint64_t readBytes = 0;
+    uint32_t startupMs = 0;
+};
+
+// Launch histograms of an app, each in LatencyHistogram::Format() text
+struct LaunchLatencySettings {
+    std::string name;
+    std::string processStart;
+    std::string firstWindow;
+    std::string windowReady;
+    std::string embedded;
+    std::string settle;
+};
+
+// An app that was embedded when the settings were saved, and the process its window belonged to
+struct SessionTabSettings {
+    std::string name;
+    uint32_t pid = 0;
+};
+
+// Everything the dashboard persists
+struct DashboardSettings {
+    std::string chromePath;
+    std::string steamPath;
+    std::string discordPath;
+    std::vector<CustomAppSettings> customApps;
+    std::vector<LaunchProfileSettings> launchProfiles;
+    std::vector<LaunchCostSettings> launchCosts;
+    std::vector<LaunchLatencySettings> launchLatencies;
+    // Tabs of the last session, the current one first
+    std::vector<SessionTabSettings> sessionTabs;
+};
+
+// Where settings live. Load only overwrites fields that are present in the store.
+class SettingsStore {
+public:
+    virtual ~SettingsStore() {}
+
+    // False if there is nothing to load (or it could not be read)
+    virtual bool Load(DashboardSettings& settings) = 0;
+    virtual bool Save(const DashboardSettings& settings) = 0;
+    // True once something was saved, even if it can no longer be loaded
+    virtual bool Exists() const = 0;
+};
+
+// Versioned flat-text file, read with a single read and replaced atomically (temp file + rename)
+class FileSettingsStore : public SettingsStore {
+public:
+    // 2 added [Profile] sections; version 1 readers would have read their keys into the last app
+    static const int VERSION = 2;
+
+    explicit FileSettingsStore(std::string path);
+
+    bool Load(DashboardSettings& settings) override;
+    bool Save(const DashboardSettings& settings) override;
+
+    bool Exists() const override;
+
+    const std::string& Path() const { return m_path; }
+
+private:
+    std::string m_path;
+};
+
+#ifdef _WIN32
+// Legacy per-key values under HKCU\SOFTWARE\GamingDashboard. Only used to import old settings.
+class RegistrySettingsStore : public SettingsStore {
+public:
+    bool Load(DashboardSettings& settings) override;
+    bool Save(const DashboardSettings& settings) override;
+    bool Exists() const override;
+};
+#endif
+
+// Keeps the last saved settings in memory; for headless runs
+class MemorySettingsStore : public SettingsStore {
+public:
+    bool Load(DashboardSettings& settings) override;
+    bool Save(const DashboardSettings& settings) override;
+    bool Exists() const override;
+
+private:
+    // Save runs on the SettingsWriter thread
+    mutable std::mutex m_mutex;
+    std::unique_ptr<DashboardSettings> m_saved;
+};
+
+// %APPDATA%\GamingDashboard\settings.txt on Windows, XDG config dir elsewhere
+std::string DefaultSettingsPath();
+
+// Saves on a background thread so the UI never waits on disk. Back-to-back saves collapse into one
+// write of the latest snapshot. The destructor finishes any pending write.
+class SettingsWriter {
+public:
+    explicit SettingsWriter(SettingsStore& store);
+    ~SettingsWriter();
+
+    SettingsWriter(const SettingsWriter&) = delete;
+    SettingsWriter& operator=(const SettingsWriter&) = delete;
+
+    void Save(DashboardSettings settings);
+    // Blocks until everything queued so far is on disk
+    void Flush();
+
+private:
+    void WriterThread();
+
+    SettingsStore& m_store;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::unique_ptr<DashboardSettings> m_pending;
+    bool m_writing = false;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
@@ -0,0 +1,718 @@
+#include "SoftwareRenderer.h"
+
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RASTER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// Vertices are snapped to 1/16 pixel; edge functions are exact in 64-bit integers
+const int SUBPIXEL_BITS = 4;
+const int SUBPIXEL_ONE = 1 << SUBPIXEL_BITS;
+const int SUBPIXEL_HALF = SUBPIXEL_ONE / 2;
+// Far off-screen vertices are clamped so the fixed-point products stay well inside 64 bits
+const float MAX_COORDINATE = 1 << 20;
+
+// round(a * b / 255) for a, b in 0..255
+inline uint32_t Mul8(uint32_t a, uint32_t b)
+{
+    uint32_t t = a * b + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+inline uint32_t Modulate(uint32_t texel, uint32_t color)
+{
+    uint32_t result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        result |= Mul8((texel >> shift) & 0xff, (color >> shift) & 0xff) << shift;
+    }
+    return result;
+}
+
+// Colour: source * sourceAlpha + target * (1 - sourceAlpha). Alpha: source + target * (1 - sourceAlpha).
+inline uint32_t Blend(uint32_t source, uint32_t target)
+{
+    uint32_t alpha = source >> 24;
+    uint32_t inverse = 255 - alpha;
+    uint32_t result = (alpha + Mul8(target >> 24, inverse)) << 24;
+    for (int shift = 0; shift < 24; shift += 8) {
+        result |= (Mul8((source >> shift) & 0xff, alpha) + Mul8((target >> shift) & 0xff, inverse)) << shift;
+    }
+    return result;
+}
+
+// Floor / ceiling of n / d for d > 0
+int64_t FloorDiv(int64_t n, int64_t d)
+{
+    int64_t quotient = n / d;
+    return (n % d != 0 && n < 0) ? quotient - 1 : quotient;
+}
+
+int64_t CeilDiv(int64_t n, int64_t d)
+{
+    return -FloorDiv(-n, d);
+}
+
+// Walks floor(n / divisor) down the rows of a triangle, where n changes by a constant each row, without dividing
+struct EdgeWalk {
+    int64_t quotient = 0;
+    int64_t remainder = 0;
+    int64_t divisor = 1;
+    int64_t stepQuotient = 0;
+    int64_t stepRemainder = 0;
+
+    void Start(int64_t numerator, int64_t step, int64_t positiveDivisor) {
+        divisor = positiveDivisor;
+        quotient = FloorDiv(numerator, divisor);
+        remainder = numerator - quotient * divisor;
+        stepQuotient = FloorDiv(step, divisor);
+        stepRemainder = step - stepQuotient * divisor;
+    }
+
+    void Next() {
+        quotient += stepQuotient;
+        remainder += stepRemainder;
+        if (remainder >= divisor) {
+            remainder -= divisor;
+            quotient++;
+        }
+    }
+
+    int64_t Floor() const { return quotient; }
+    int64_t Ceil() const { return remainder > 0 ? quotient + 1 : quotient; }
+};
+
+// Written as _mm_max_ps / _mm_min_ps evaluate, so the scalar and SSE2 paths round identically
+inline float ClampLikeSse(float value, float low, float high)
+{
+    value = value > low ? value : low;
+    return value < high ? value : high;
+}
+
+// One span of a triangle that needs per-pixel texture coordinates or colours
+struct ShadedSpan {
+    const uint32_t* texels;
+    int textureWidth;
+    float textureScaleX;
+    float textureScaleY;
+    float textureMaxX;
+    float textureMaxY;
+    // Attribute at pixel x of this row is row + dx * (x + 0.5)
+    float uRow, uDx;
+    float vRow, vDx;
+    bool flatColor;
+    uint32_t vertexColor;
+    float colorRow[4];
+    float colorDx[4];
+};
+
+inline uint32_t ShadePixel(const ShadedSpan& span, int x)
+{
+    float center = (float)x + 0.5f;
+    float u = span.uRow + span.uDx * center;
+    float v = span.vRow + span.vDx * center;
+    int texelX = (int)ClampLikeSse(u * span.textureScaleX, 0.0f, span.textureMaxX);
+    int texelY = (int)ClampLikeSse(v * span.textureScaleY, 0.0f, span.textureMaxY);
+    uint32_t texel = span.texels[texelY * span.textureWidth + texelX];
+
+    uint32_t color = span.vertexColor;
+    if (!span.flatColor) {
+        color = 0;
+        for (int channel = 0; channel < 4; channel++) {
+            float value = span.colorRow[channel] + span.colorDx[channel] * center;
+            value = value + 0.5f;
+            color |= (uint32_t)(int)ClampLikeSse(value, 0.0f, 255.0f) << (channel * 8);
+        }
+    }
+    return Modulate(texel, color);
+}
+
+void FillFlatScalar(uint32_t* target, int count, uint32_t source)
+{
+    if ((source >> 24) == 255) {
+        std::fill(target, target + count, source);
+        return;
+    }
+    for (int i = 0; i < count; i++) target[i] = Blend(source, target[i]);
+}
+
+void FillShadedScalar(uint32_t* target, int x, int count, const ShadedSpan& span)
+{
+    for (int i = 0; i < count; i++) target[i] = Blend(ShadePixel(span, x + i), target[i]);
+}
+
+#ifdef RASTER_SSE2
+// Mul8 on eight 16-bit lanes
+inline __m128i Mul8x8(__m128i a, __m128i b)
+{
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(a, b), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+// Two pixels widened to 16 bits per channel
+inline __m128i BlendWide(__m128i source, __m128i target)
+{
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(source, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    // The alpha channel takes the source as is (factor 255) instead of source * alpha
+    const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    __m128i sourceFactor = _mm_or_si128(_mm_andnot_si128(alphaLanes, alpha), _mm_and_si128(alphaLanes, _mm_set1_epi16(255)));
+    __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+    return _mm_add_epi16(Mul8x8(source, sourceFactor), Mul8x8(target, inverse));
+}
+
+inline __m128i Blend4(__m128i source, __m128i target)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i low = BlendWide(_mm_unpacklo_epi8(source, zero), _mm_unpacklo_epi8(target, zero));
+    __m128i high = BlendWide(_mm_unpackhi_epi8(source, zero), _mm_unpackhi_epi8(target, zero));
+    return _mm_packus_epi16(low, high);
+}
+
+inline __m128i Modulate4(__m128i texels, __m128i colors)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i low = Mul8x8(_mm_unpacklo_epi8(texels, zero), _mm_unpacklo_epi8(colors, zero));
+    __m128i high = Mul8x8(_mm_unpackhi_epi8(texels, zero), _mm_unpackhi_epi8(colors, zero));
+    return _mm_packus_epi16(low, high);
+}
+
+void FillFlatSSE2(uint32_t* target, int count, uint32_t source)
+{
+    int i = 0;
+    if ((source >> 24) == 255) {
+        __m128i fill = _mm_set1_epi32((int)source);
+        for (; i + 4 <= count; i += 4) _mm_storeu_si128((__m128i*)(target + i), fill);
+    }
+    else {
+        // The source half of the blend is the same for every pixel
+        const __m128i zero = _mm_setzero_si128();
+        __m128i wide = _mm_unpacklo_epi8(_mm_set1_epi32((int)source), zero);
+        __m128i alpha = _mm_set1_epi16((short)(source >> 24));
+        const __m128i alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+        __m128i sourceFactor = _mm_or_si128(_mm_andnot_si128(alphaLanes, alpha), _mm_and_si128(alphaLanes, _mm_set1_epi16(255)));
+        __m128i sourceTerm = Mul8x8(wide, sourceFactor);
+        __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+        for (; i + 4 <= count; i += 4) {
+            __m128i pixels = _mm_loadu_si128((const __m128i*)(target + i));
+            __m128i low = _mm_add_epi16(sourceTerm, Mul8x8(_mm_unpacklo_epi8(pixels, zero), inverse));
+            __m128i high = _mm_add_epi16(sourceTerm, Mul8x8(_mm_unpackhi_epi8(pixels, zero), inverse));
+            _mm_storeu_si128((__m128i*)(target + i), _mm_packus_epi16(low, high));
+        }
+    }
+    FillFlatScalar(target + i, count - i, source);
+}
+
+// Four pixels at a time: coordinates, colours, modulate and blend in SSE2; only the texel fetch is scalar
+void FillShadedSSE2(uint32_t* target, int x, int count, const ShadedSpan& span)
+{
+    const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 center = _mm_add_ps(_mm_add_ps(_mm_set1_ps((float)(x + i)), lanes), half);
+        __m128 u = _mm_add_ps(_mm_set1_ps(span.uRow), _mm_mul_ps(_mm_set1_ps(span.uDx), center));
+        __m128 v = _mm_add_ps(_mm_set1_ps(span.vRow), _mm_mul_ps(_mm_set1_ps(span.vDx), center));
+        u = _mm_min_ps(_mm_max_ps(_mm_mul_ps(u, _mm_set1_ps(span.textureScaleX)), zero), _mm_set1_ps(span.textureMaxX));
+        v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v, _mm_set1_ps(span.textureScaleY)), zero), _mm_set1_ps(span.textureMaxY));
+        alignas(16) int32_t texelX[4];
+        alignas(16) int32_t texelY[4];
+        _mm_store_si128((__m128i*)texelX, _mm_cvttps_epi32(u));
+        _mm_store_si128((__m128i*)texelY, _mm_cvttps_epi32(v));
+        const uint32_t* texels = span.texels;
+        int width = span.textureWidth;
+        __m128i fetched = _mm_set_epi32((int)texels[texelY[3] * width + texelX[3]], (int)texels[texelY[2] * width + texelX[2]],
+            (int)texels[texelY[1] * width + texelX[1]], (int)texels[texelY[0] * width + texelX[0]]);
+
+        __m128i colors;
+        if (span.flatColor) {
+            colors = _mm_set1_epi32((int)span.vertexColor);
+        }
+        else {
+            colors = _mm_setzero_si128();
+            for (int channel = 0; channel < 4; channel++) {
+                __m128 value = _mm_add_ps(_mm_set1_ps(span.colorRow[channel]), _mm_mul_ps(_mm_set1_ps(span.colorDx[channel]), center));
+                value = _mm_min_ps(_mm_max_ps(_mm_add_ps(value, half), zero), _mm_set1_ps(255.0f));
+                colors = _mm_or_si128(colors, _mm_slli_epi32(_mm_cvttps_epi32(value), channel * 8));
+            }
+        }
+
+        __m128i pixels = _mm_loadu_si128((const __m128i*)(target + i));
+        _mm_storeu_si128((__m128i*)(target + i), Blend4(Modulate4(fetched, colors), pixels));
+    }
+    FillShadedScalar(target + i, x + i, count - i, span);
+}
+#endif
+
+// Copies a rectangle of an ImGui texture, widening Alpha8 to white with that alpha
+void CopyTexels(uint32_t* pixels, int width, ImTextureData* source, int x, int y, int rectWidth, int rectHeight)
+{
+    for (int row = y; row < y + rectHeight; row++) {
+        uint32_t* target = pixels + (size_t)row * width + x;
+        const unsigned char* texels = (const unsigned char*)source->GetPixelsAt(x, row);
+        if (source->Format == ImTextureFormat_RGBA32) {
+            memcpy(target, texels, (size_t)rectWidth * 4);
+        }
+        else {
+            for (int i = 0; i < rectWidth; i++) target[i] = 0x00ffffffu | ((uint32_t)texels[i] << 24);
+        }
+    }
+}
+
+}
+
+SoftwareRenderer::SoftwareRenderer(int threadCount)
+{
+    if (threadCount <= 0) threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+    m_whiteTexture.width = 1;
+    m_whiteTexture.height = 1;
+    m_whiteTexture.pixels.assign(1, 0xffffffffu);
+    for (int i = 1; i < threadCount; i++) {
+        m_workers.emplace_back(&SoftwareRenderer::WorkerThread, this);
+    }
+}
+
+SoftwareRenderer::~SoftwareRenderer()
+{
+    if (m_initialized) Shutdown();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers) worker.join();
+}
+
+void SoftwareRenderer::Init()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IM_ASSERT(io.BackendRendererUserData == nullptr && "Already initialized a renderer backend!");
+    io.BackendRendererUserData = this;
+    io.BackendRendererName = "software";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+
+    ImGuiPlatformIO& platformIo = ImGui::GetPlatformIO();
+    platformIo.Renderer_TextureMaxWidth = platformIo.Renderer_TextureMaxHeight = 16384;
+    m_initialized = true;
+}
+
+void SoftwareRenderer::Shutdown()
+{
+    for (ImTextureData* texture : ImGui::GetPlatformIO().Textures) {
+        if (texture->RefCount == 1) DestroyTexture(texture);
+    }
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendRendererName = nullptr;
+    io.BackendRendererUserData = nullptr;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures);
+    m_initialized = false;
+}
+
+void SoftwareRenderer::SetClearColor(const ImVec4& color)
+{
+    m_clearColor = ImGui::ColorConvertFloat4ToU32(color);
+}
+
+void SoftwareRenderer::RenderDrawData(ImDrawData* drawData)
+{
+    if (drawData->Textures != nullptr) {
+        for (ImTextureData* texture : *drawData->Textures) {
+            if (texture->Status != ImTextureStatus_OK) UpdateTexture(texture);
+        }
+    }
+
+    int width = (int)(drawData->DisplaySize.x * drawData->FramebufferScale.x);
+    int height = (int)(drawData->DisplaySize.y * drawData->FramebufferScale.y);
+    if (width <= 0 || height <= 0) return;
+    Resize(width, height);
+
+    m_lastFrame = SoftwareRenderStats();
+    {
+        GD_PROFILE_ZONE("Bin triangles");
+        m_triangles.clear();
+        for (std::vector<uint32_t>& bin : m_bins) bin.clear();
+        for (const ImDrawList* drawList : drawData->CmdLists) {
+            BinDrawList(drawList, drawData);
+        }
+    }
+
+    RenderTiles();
+
+    m_lastFrame.binnedTriangles = (int)m_triangles.size();
+    m_lastFrame.tiles = (int)m_bins.size();
+    for (size_t tile = 0; tile < m_bins.size(); tile++) {
+        m_lastFrame.binEntries += (int)m_bins[tile].size();
+        m_lastFrame.pixelsShaded += m_tilePixels[tile];
+    }
+}
+
+bool SoftwareRenderer::SavePpm(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    file << "P6\n" << m_width << " " << m_height << "\n255\n";
+    std::vector<unsigned char> row((size_t)m_width * 3);
+    for (int y = 0; y < m_height; y++) {
+        const uint32_t* pixels = &m_framebuffer[(size_t)y * m_width];
+        for (int x = 0; x < m_width; x++) {
+            row[x * 3 + 0] = (unsigned char)(pixels[x] & 0xff);
+            row[x * 3 + 1] = (unsigned char)((pixels[x] >> 8) & 0xff);
+            row[x * 3 + 2] = (unsigned char)((pixels[x] >> 16) & 0xff);
+        }
+        file.write((const char*)row.data(), row.size());
+    }
+    return (bool)file;
+}
+
+void SoftwareRenderer::UpdateTexture(ImTextureData* texture)
+{
+    if (texture->Status == ImTextureStatus_WantCreate) {
+        IM_ASSERT(texture->TexID == ImTextureID_Invalid && texture->BackendUserData == nullptr);
+        Texture* backendTexture = new Texture();
+        backendTexture->width = texture->Width;
+        backendTexture->height = texture->Height;
+        backendTexture->pixels.resize((size_t)texture->Width * texture->Height);
+        CopyTexels(backendTexture->pixels.data(), texture->Width, texture, 0, 0, texture->Width, texture->Height);
+        texture->SetTexID((ImTextureID)(intptr_t)backendTexture);
+        texture->SetStatus(ImTextureStatus_OK);
+        texture->BackendUserData = backendTexture;
+    }
+    else if (texture->Status == ImTextureStatus_WantUpdates) {
+        Texture* backendTexture = (Texture*)texture->BackendUserData;
+        for (const ImTextureRect& rect : texture->Updates) {
+            CopyTexels(backendTexture->pixels.data(), backendTexture->width, texture, rect.x, rect.y, rect.w, rect.h);
+        }
+        texture->SetStatus(ImTextureStatus_OK);
+    }
+    if (texture->Status == ImTextureStatus_WantDestroy && texture->UnusedFrames > 0) {
+        DestroyTexture(texture);
+    }
+}
+
+void SoftwareRenderer::DestroyTexture(ImTextureData* texture)
+{
+    delete (Texture*)texture->BackendUserData;
+    texture->SetTexID(ImTextureID_Invalid);
+    texture->SetStatus(ImTextureStatus_Destroyed);
+    texture->BackendUserData = nullptr;
+}
+
+void SoftwareRenderer::Resize(int width, int height)
+{
+    if (width == m_width && height == m_height) return;
+    m_width = width;
+    m_height = height;
+    m_framebuffer.assign((size_t)width * height, m_clearColor);
+    m_tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    m_tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    m_bins.resize((size_t)m_tilesX * m_tilesY);
+    m_tilePixels.assign(m_bins.size(), 0);
+}
+
+void SoftwareRenderer::BinDrawList(const ImDrawList* drawList, const ImDrawData* drawData)
+{
+    ImVec2 offset = drawData->DisplayPos;
+    ImVec2 scale = drawData->FramebufferScale;
+    for (const ImDrawCmd& command : drawList->CmdBuffer) {
+        if (command.UserCallback != nullptr) {
+            if (command.UserCallback != ImDrawCallback_ResetRenderState) command.UserCallback(drawList, &command);
+            continue;
+        }
+
+        // Same scissor as the D3D11 backend, clamped to the framebuffer
+        float clipMinX = std::max((command.ClipRect.x - offset.x) * scale.x, 0.0f);
+        float clipMinY = std::max((command.ClipRect.y - offset.y) * scale.y, 0.0f);
+        float clipMaxX = std::min((command.ClipRect.z - offset.x) * scale.x, (float)m_width);
+        float clipMaxY = std::min((command.ClipRect.w - offset.y) * scale.y, (float)m_height);
+        if (clipMaxX <= clipMinX || clipMaxY <= clipMinY) continue;
+        int clip[4] = { (int)clipMinX, (int)clipMinY, (int)clipMaxX, (int)clipMaxY };
+
+        const Texture* texture = (const Texture*)(intptr_t)command.GetTexID();
+        if (texture == nullptr) texture = &m_whiteTexture;
+
+        m_lastFrame.drawCalls++;
+        const ImDrawIdx* indices = drawList->IdxBuffer.Data + command.IdxOffset;
+        const ImDrawVert* vertices = drawList->VtxBuffer.Data + command.VtxOffset;
+        for (unsigned int i = 0; i + 2 < command.ElemCount; i += 3) {
+            BinTriangle(vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]], offset, scale, clip, texture);
+        }
+        m_lastFrame.triangles += (int)command.ElemCount / 3;
+    }
+}
+
+void SoftwareRenderer::BinTriangle(const ImDrawVert& v0, const ImDrawVert& v1, const ImDrawVert& v2, const ImVec2& offset,
+    const ImVec2& scale, const int clip[4], const Texture* texture)
+{
+    const ImDrawVert* vertices[3] = { &v0, &v1, &v2 };
+    int64_t fixedX[3];
+    int64_t fixedY[3];
+    for (int i = 0; i < 3; i++) {
+        float x = std::clamp((vertices[i]->pos.x - offset.x) * scale.x, -MAX_COORDINATE, MAX_COORDINATE);
+        float y = std::clamp((vertices[i]->pos.y - offset.y) * scale.y, -MAX_COORDINATE, MAX_COORDINATE);
+        fixedX[i] = (int64_t)std::floor(x * SUBPIXEL_ONE + 0.5f);
+        fixedY[i] = (int64_t)std::floor(y * SUBPIXEL_ONE + 0.5f);
+    }
+
+    int64_t area = (fixedX[1] - fixedX[0]) * (fixedY[2] - fixedY[0]) - (fixedY[1] - fixedY[0]) * (fixedX[2] - fixedX[0]);
+    if (area == 0) return;
+    // ImGui emits both windings; make every triangle positive so "inside" is the same side of each edge
+    if (area < 0) {
+        std::swap(vertices[1], vertices[2]);
+        std::swap(fixedX[1], fixedX[2]);
+        std::swap(fixedY[1], fixedY[2]);
+        area = -area;
+    }
+
+    // Pixels whose centre lies in the bounding box, clipped to the scissor (which is inside the framebuffer)
+    int64_t boxMinX = std::min({ fixedX[0], fixedX[1], fixedX[2] });
+    int64_t boxMinY = std::min({ fixedY[0], fixedY[1], fixedY[2] });
+    int64_t boxMaxX = std::max({ fixedX[0], fixedX[1], fixedX[2] });
+    int64_t boxMaxY = std::max({ fixedY[0], fixedY[1], fixedY[2] });
+    int minX = (int)std::max<int64_t>(CeilDiv(boxMinX - SUBPIXEL_HALF, SUBPIXEL_ONE), clip[0]);
+    int minY = (int)std::max<int64_t>(CeilDiv(boxMinY - SUBPIXEL_HALF, SUBPIXEL_ONE), clip[1]);
+    int maxX = (int)std::min<int64_t>(FloorDiv(boxMaxX - SUBPIXEL_HALF, SUBPIXEL_ONE) + 1, clip[2]);
+    int maxY = (int)std::min<int64_t>(FloorDiv(boxMaxY - SUBPIXEL_HALF, SUBPIXEL_ONE) + 1, clip[3]);
+    if (minX >= maxX || minY >= maxY) return;
+
+    Triangle triangle;
+    triangle.minX = minX;
+    triangle.minY = minY;
+    triangle.maxX = maxX;
+    triangle.maxY = maxY;
+    triangle.texture = texture;
+    triangle.flatColor = v0.col == v1.col && v1.col == v2.col;
+    triangle.flatUv = v0.uv.x == v1.uv.x && v1.uv.x == v2.uv.x && v0.uv.y == v1.uv.y && v1.uv.y == v2.uv.y;
+    triangle.vertexColor = vertices[0]->col;
+    if (triangle.flatColor && (triangle.vertexColor >> 24) == 0) return;
+
+    for (int i = 0; i < 3; i++) {
+        int next = (i + 1) % 3;
+        int64_t dx = fixedX[next] - fixedX[i];
+        int64_t dy = fixedY[next] - fixedY[i];
+        // Top-left rule: pixel centres exactly on a top or left edge belong to this triangle, not its neighbour
+        bool topLeft = dy < 0 || (dy == 0 && dx > 0);
+        Edge& edge = triangle.edges[i];
+        edge.a = -dy * SUBPIXEL_ONE;
+        edge.b = dx * SUBPIXEL_ONE;
+        edge.c = dx * (SUBPIXEL_HALF - fixedY[i]) - dy * (SUBPIXEL_HALF - fixedX[i]) - (topLeft ? 0 : 1);
+    }
+
+    // Attribute planes from the snapped positions, in pixels
+    float x0 = (float)fixedX[0] / SUBPIXEL_ONE;
+    float y0 = (float)fixedY[0] / SUBPIXEL_ONE;
+    float x1 = (float)fixedX[1] / SUBPIXEL_ONE - x0;
+    float y1 = (float)fixedY[1] / SUBPIXEL_ONE - y0;
+    float x2 = (float)fixedX[2] / SUBPIXEL_ONE - x0;
+    float y2 = (float)fixedY[2] / SUBPIXEL_ONE - y0;
+    float inverseArea = 1.0f / (x1 * y2 - x2 * y1);
+    auto makePlane = [&](float f0, float f1, float f2) {
+        Plane plane;
+        plane.dx = ((f1 - f0) * y2 - (f2 - f0) * y1) * inverseArea;
+        plane.dy = ((f2 - f0) * x1 - (f1 - f0) * x2) * inverseArea;
+        plane.c = f0 - plane.dx * x0 - plane.dy * y0;
+        return plane;
+    };
+    if (triangle.flatUv) {
+        triangle.u.c = vertices[0]->uv.x;
+        triangle.v.c = vertices[0]->uv.y;
+    }
+    else {
+        triangle.u = makePlane(vertices[0]->uv.x, vertices[1]->uv.x, vertices[2]->uv.x);
+        triangle.v = makePlane(vertices[0]->uv.y, vertices[1]->uv.y, vertices[2]->uv.y);
+    }
+    if (!triangle.flatColor) {
+        for (int channel = 0; channel < 4; channel++) {
+            int shift = channel * 8;
+            triangle.color[channel] = makePlane((float)((vertices[0]->col >> shift) & 0xff), (float)((vertices[1]->col >> shift) & 0xff),
+                (float)((vertices[2]->col >> shift) & 0xff));
+        }
+    }
+
+    triangle.flatSource = 0;
+    if (triangle.flatColor && triangle.flatUv) {
+        // Same texel lookup as ShadePixel() with a constant coordinate
+        int texelX = (int)ClampLikeSse(triangle.u.c * texture->width, 0.0f, (float)(texture->width - 1));
+        int texelY = (int)ClampLikeSse(triangle.v.c * texture->height, 0.0f, (float)(texture->height - 1));
+        triangle.flatSource = Modulate(texture->pixels[(size_t)texelY * texture->width + texelX], triangle.vertexColor);
+        if ((triangle.flatSource >> 24) == 0) return;
+    }
+
+    // Only tiles the triangle reaches: ImGui fills rounded shapes as fans of long slivers whose bounding
+    // boxes cover far more tiles than the slivers touch
+    uint32_t index = (uint32_t)m_triangles.size();
+    bool binned = false;
+    for (int tileY = minY / TILE_SIZE; tileY <= (maxY - 1) / TILE_SIZE; tileY++) {
+        int rowMin = std::max(tileY * TILE_SIZE, minY);
+        int rowMax = std::min((tileY + 1) * TILE_SIZE, maxY) - 1;
+        for (int tileX = minX / TILE_SIZE; tileX <= (maxX - 1) / TILE_SIZE; tileX++) {
+            int columnMin = std::max(tileX * TILE_SIZE, minX);
+            int columnMax = std::min((tileX + 1) * TILE_SIZE, maxX) - 1;
+            bool outside = false;
+            for (const Edge& edge : triangle.edges) {
+                // The edge function is largest at the corner furthest along its normal
+                int64_t x = edge.a > 0 ? columnMax : columnMin;
+                int64_t y = edge.b > 0 ? rowMax : rowMin;
+                if (edge.a * x + edge.b * y + edge.c < 0) outside = true;
+            }
+            if (outside) continue;
+            m_bins[(size_t)tileY * m_tilesX + tileX].push_back(index);
+            binned = true;
+        }
+    }
+    if (binned) m_triangles.push_back(triangle);
+}
+
+void SoftwareRenderer::RenderTiles()
+{
+    if (m_workers.empty()) {
+        m_nextTile = 0;
+        RenderTileQueue();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_nextTile = 0;
+        m_busyWorkers = (int)m_workers.size();
+        m_generation++;
+    }
+    m_wake.notify_all();
+    RenderTileQueue();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this]() { return m_busyWorkers == 0; });
+}
+
+void SoftwareRenderer::RenderTileQueue()
+{
+    GD_PROFILE_ZONE("Raster tiles");
+    int tileCount = (int)m_bins.size();
+    for (int tile = m_nextTile.fetch_add(1); tile < tileCount; tile = m_nextTile.fetch_add(1)) {
+        RenderTile(tile);
+    }
+}
+
+void SoftwareRenderer::RenderTile(int tile)
+{
+    int tileMinX = (tile % m_tilesX) * TILE_SIZE;
+    int tileMinY = (tile / m_tilesX) * TILE_SIZE;
+    int tileMaxX = std::min(tileMinX + TILE_SIZE, m_width);
+    int tileMaxY = std::min(tileMinY + TILE_SIZE, m_height);
+    for (int y = tileMinY; y < tileMaxY; y++) {
+        uint32_t* row = &m_framebuffer[(size_t)y * m_width];
+        std::fill(row + tileMinX, row + tileMaxX, m_clearColor);
+    }
+
+#ifdef RASTER_SSE2
+    bool simd = m_simd;
+#else
+    bool simd = false;
+#endif
+    uint64_t pixels = 0;
+    for (uint32_t index : m_bins[tile]) {
+        const Triangle& triangle = m_triangles[index];
+        int minX = std::max(triangle.minX, tileMinX);
+        int minY = std::max(triangle.minY, tileMinY);
+        int maxX = std::min(triangle.maxX, tileMaxX);
+        int maxY = std::min(triangle.maxY, tileMaxY);
+        bool flat = triangle.flatColor && triangle.flatUv;
+
+        ShadedSpan span;
+        if (!flat) {
+            const Texture& texture = *triangle.texture;
+            span.texels = texture.pixels.data();
+            span.textureWidth = texture.width;
+            span.textureScaleX = (float)texture.width;
+            span.textureScaleY = (float)texture.height;
+            span.textureMaxX = (float)(texture.width - 1);
+            span.textureMaxY = (float)(texture.height - 1);
+            span.uDx = triangle.u.dx;
+            span.vDx = triangle.v.dx;
+            span.flatColor = triangle.flatColor;
+            span.vertexColor = triangle.vertexColor;
+            for (int channel = 0; channel < 4; channel++) span.colorDx[channel] = triangle.color[channel].dx;
+        }
+
+        // Edge a * x + b * y + c >= 0 bounds x from below (a > 0) at ceil(-(b * y + c) / a), or from above
+        // (a < 0) at floor((b * y + c) / -a); horizontal edges (a == 0) accept or reject whole rows
+        EdgeWalk walks[3];
+        for (int i = 0; i < 3; i++) {
+            const Edge& edge = triangle.edges[i];
+            if (edge.a > 0) walks[i].Start(-(edge.b * minY + edge.c), -edge.b, edge.a);
+            else if (edge.a < 0) walks[i].Start(edge.b * minY + edge.c, edge.b, -edge.a);
+        }
+
+        for (int y = minY; y < maxY; y++) {
+            // Pixels of this row inside all three edges
+            int64_t spanMin = minX;
+            int64_t spanMax = maxX - 1;
+            for (int i = 0; i < 3; i++) {
+                const Edge& edge = triangle.edges[i];
+                if (edge.a > 0) spanMin = std::max(spanMin, walks[i].Ceil());
+                else if (edge.a < 0) spanMax = std::min(spanMax, walks[i].Floor());
+                else if (edge.b * y + edge.c < 0) spanMax = spanMin - 1;
+                walks[i].Next();
+            }
+            if (spanMin > spanMax) continue;
+
+            int x = (int)spanMin;
+            int count = (int)(spanMax - spanMin + 1);
+            uint32_t* target = &m_framebuffer[(size_t)y * m_width + x];
+            pixels += count;
+            if (flat) {
+#ifdef RASTER_SSE2
+                if (simd) {
+                    FillFlatSSE2(target, count, triangle.flatSource);
+                    continue;
+                }
+#endif
+                FillFlatScalar(target, count, triangle.flatSource);
+                continue;
+            }
+
+            float center = (float)y + 0.5f;
+            span.uRow = triangle.u.dy * center + triangle.u.c;
+            span.vRow = triangle.v.dy * center + triangle.v.c;
+            for (int channel = 0; channel < 4; channel++) {
+                span.colorRow[channel] = triangle.color[channel].dy * center + triangle.color[channel].c;
+            }
+#ifdef RASTER_SSE2
+            if (simd) {
+                FillShadedSSE2(target, x, count, span);
+                continue;
+            }
+#endif
+            FillShadedScalar(target, x, count, span);
+        }
+    }
+    m_tilePixels[tile] = pixels;
+}
+
+void SoftwareRenderer::WorkerThread()
+{
+    GD_PROFILE_THREAD("Raster");
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&]() { return m_stopping || m_generation != seen; });
+            if (m_stopping) return;
+            seen = m_generation;
+        }
+        RenderTileQueue();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busyWorkers == 0) m_done.notify_one();
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "imgui.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct SoftwareRenderStats {
+    int drawCalls = 0;
+    int triangles = 0;
+    // Triangles left after dropping degenerate, scissored and fully transparent ones
+    int binnedTriangles = 0;
+    // Sum of every tile's bin length; a triangle spanning several tiles counts once per tile
+    int binEntries = 0;
+    int tiles = 0;
+    uint64_t pixelsShaded = 0;
+};
+
+// ImGui renderer backend that rasterizes on the CPU into an RGBA8 framebuffer, for machines without
+// a usable GPU and as a reference image on Linux. Triangles are binned into 64x64 tiles on the calling
+// thread, then the tiles are rasterized in parallel; each tile applies its triangles in submission
+// order, so the result does not depend on the thread count. Matches the D3D11 backend's pipeline:
+// texture * vertex colour, straight alpha blending (ONE for the alpha channel), scissor per command.
+// Textures are sampled nearest-texel, which is exact for ImGui's pixel-aligned glyphs and icons.
+class SoftwareRenderer {
+public:
+    // threadCount 0 uses every hardware thread; the calling thread renders tiles as well
+    explicit SoftwareRenderer(int threadCount = 0);
+    ~SoftwareRenderer();
+
+    SoftwareRenderer(const SoftwareRenderer&) = delete;
+    SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+
+    // Call after ImGui::CreateContext(), like ImGui_ImplDX11_Init()
+    void Init();
+    // Destroys the remaining textures; call before ImGui::DestroyContext()
+    void Shutdown();
+
+    void SetClearColor(const ImVec4& color);
+    // SSE2 span filling where the CPU has it. Off runs the scalar reference, which gives the same pixels.
+    void SetSimd(bool enabled) { m_simd = enabled; }
+    bool SimdEnabled() const { return m_simd; }
+    int ThreadCount() const { return (int)m_workers.size() + 1; }
+
+    // Resizes the framebuffer to DisplaySize * FramebufferScale, clears it and draws the frame
+    void RenderDrawData(ImDrawData* drawData);
+
+    int Width() const { return m_width; }
+    int Height() const { return m_height; }
+    // RGBA8, red in the low byte, rows top to bottom with no padding
+    const uint32_t* Pixels() const { return m_framebuffer.data(); }
+    // Binary PPM (alpha dropped), for golden-image comparisons
+    bool SavePpm(const std::string& path) const;
+
+    const SoftwareRenderStats& LastFrame() const { return m_lastFrame; }
+
+    static const int TILE_SIZE = 64;
+
+private:
+    struct Texture {
+        int width = 0;
+        int height = 0;
+        std::vector<uint32_t> pixels;
+    };
+
+    // Attribute at pixel centre (x + 0.5, y + 0.5) is dx * x + dy * y + c
+    struct Plane {
+        float dx = 0.0f;
+        float dy = 0.0f;
+        float c = 0.0f;
+    };
+
+    // Inside when a * x + b * y + c >= 0 at pixel (x, y), in 1/16 pixel fixed point; the top-left rule is folded into c
+    struct Edge {
+        int64_t a = 0;
+        int64_t b = 0;
+        int64_t c = 0;
+    };
+
+    struct Triangle {
+        Edge edges[3];
+        // Pixel rectangle [minX, maxX) x [minY, maxY), already clipped to the scissor and the framebuffer
+        int minX, minY, maxX, maxY;
+        const Texture* texture;
+        Plane u, v;
+        Plane color[4];
+        // All three vertices share the colour / the texture coordinate
+        bool flatColor;
+        bool flatUv;
+        uint32_t vertexColor;
+        // Texel * vertex colour when both are flat
+        uint32_t flatSource;
+    };
+
+    void UpdateTexture(ImTextureData* texture);
+    void DestroyTexture(ImTextureData* texture);
+
+    void Resize(int width, int height);
+    void BinDrawList(const ImDrawList* drawList, const ImDrawData* drawData);
+    void BinTriangle(const ImDrawVert& v0, const ImDrawVert& v1, const ImDrawVert& v2, const ImVec2& offset,
+        const ImVec2& scale, const int clip[4], const Texture* texture);
+
+    // Hands the tiles out to the workers and the calling thread, returns once all are done
+    void RenderTiles();
+    void RenderTileQueue();
+    void RenderTile(int tile);
+    void WorkerThread();
+
+    bool m_initialized = false;
+    bool m_simd = true;
+    uint32_t m_clearColor = 0xff000000;
+    Texture m_whiteTexture;
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_tilesX = 0;
+    int m_tilesY = 0;
+    std::vector<uint32_t> m_framebuffer;
+    // Reused every frame, so rendering stops allocating once the largest frame has been seen
+    std::vector<Triangle> m_triangles;
+    std::vector<std::vector<uint32_t>> m_bins;
+    std::vector<uint64_t> m_tilePixels;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    uint64_t m_generation = 0;
+    int m_busyWorkers = 0;
+    bool m_stopping = false;
+    std::atomic<int> m_nextTile{ 0 };
+
+    SoftwareRenderStats m_lastFrame;
+};
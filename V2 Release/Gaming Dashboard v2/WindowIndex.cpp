@@ -0,0 +1,181 @@
+#include "WindowIndex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+WindowIndex::WindowIndex(WindowSystem& system) : m_system(system)
+{
+    // Subscribe first so nothing created during the seed pass is lost.
+    // Seeding holds the lock, so events arriving meanwhile are applied after it.
+    m_token = m_system.Subscribe([this](const WindowEvent& event) { OnEvent(event); });
+
+    std::vector<WindowId> windows;
+    m_system.EnumerateWindows(windows);
+
+    // Top of the z-order first. A window an event has indexed already is newer than the seed pass.
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_order.reserve(windows.size() * 2);
+    for (size_t i = 0; i < windows.size(); i++) {
+        WindowInfo info;
+        if (m_order.count(windows[i]) == 0 && m_system.QueryWindow(windows[i], info)) {
+            Store(windows[i], std::move(info), -(int64_t)i);
+        }
+    }
+}
+
+WindowIndex::~WindowIndex()
+{
+    m_system.Unsubscribe(m_token);
+}
+
+void WindowIndex::OnEvent(const WindowEvent& event)
+{
+    if (event.type == WindowEventType::Destroyed) {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        Erase(event.window);
+        return;
+    }
+
+    // Query outside the lock; readers keep the old entry until the swap
+    WindowInfo info;
+    bool alive = m_system.QueryWindow(event.window, info);
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    // Any window that gets reparented reports it; only the ones already indexed are kept up to date
+    if (event.type == WindowEventType::ParentChanged && info.parent != 0 && m_order.count(event.window) == 0) return;
+    if (alive) {
+        Store(event.window, std::move(info), m_nextOrder++);
+    }
+    else {
+        Erase(event.window);
+    }
+}
+
+void WindowIndex::Store(WindowId window, WindowInfo info, int64_t order)
+{
+    auto known = m_order.emplace(window, order);
+    WindowInfo& stored = m_windows[known.first->second];
+    stored = std::move(info);
+    stored.id = window;
+}
+
+void WindowIndex::Erase(WindowId window)
+{
+    auto it = m_order.find(window);
+    if (it == m_order.end()) return;
+    m_windows.erase(it->second);
+    m_order.erase(it);
+}
+
+bool WindowIndex::Lookup(WindowId window, WindowInfo& info) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto it = m_order.find(window);
+    if (it == m_order.end()) return false;
+    info = m_windows.at(it->second);
+    return true;
+}
+
+WindowId WindowIndex::Find(const WindowPredicate& predicate) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    for (auto& entry : m_windows) {
+        if (predicate(entry.second)) return entry.second.id;
+    }
+    return 0;
+}
+
+void WindowIndex::Resolve(const WindowMatcher& matcher, std::vector<WindowId>& windows) const
+{
+    windows.assign(matcher.Count(), 0);
+    int open = matcher.Count();
+    std::vector<int> entries;
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    for (auto& entry : m_windows) {
+        if (open == 0) break;
+        entries.clear();
+        matcher.Match(entry.second, entries);
+        for (int index : entries) {
+            if (windows[index] != 0) continue;
+            windows[index] = entry.second.id;
+            open--;
+            break;
+        }
+    }
+}
+
+void WindowIndex::VisibleWindowOwners(std::vector<ProcessId>& pids) const
+{
+    pids.clear();
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    for (auto& entry : m_windows) {
+        const WindowInfo& info = entry.second;
+        if (info.visible && info.parent == 0 && std::find(pids.begin(), pids.end(), info.pid) == pids.end()) {
+            pids.push_back(info.pid);
+        }
+    }
+}
+
+WindowId WindowIndex::FindByTitle(const std::string& titlePart) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    for (auto& entry : m_windows) {
+        const WindowInfo& info = entry.second;
+        if (info.visible && info.parent == 0 && info.title.find(titlePart) != std::string::npos) {
+            return info.id;
+        }
+    }
+    return 0;
+}
+
+size_t WindowIndex::Size() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_order.size();
+}
+
+int WindowIndex::Watch(WindowPredicate predicate, std::function<void(WindowId)> onFound)
+{
+    auto fired = std::make_shared<std::atomic<bool>>(false);
+    auto report = [fired, onFound](WindowId window) {
+        if (!fired->exchange(true)) onFound(window);
+    };
+
+    // Listeners run in subscription order, so the index has already applied the event here
+    int token = m_system.Subscribe([this, predicate, report](const WindowEvent& event) {
+        if (event.type == WindowEventType::Destroyed || event.type == WindowEventType::Hidden) return;
+        WindowInfo info;
+        if (Lookup(event.window, info) && predicate(info)) report(event.window);
+    });
+
+    WindowId existing = Find(predicate);
+    if (existing != 0) report(existing);
+    return token;
+}
+
+void WindowIndex::CancelWatch(int watch)
+{
+    m_system.Unsubscribe(watch);
+}
+
+WindowId WindowIndex::WaitFor(const WindowPredicate& predicate, int timeoutMs)
+{
+    std::mutex mutex;
+    std::condition_variable found;
+    WindowId result = 0;
+
+    int watch = Watch(predicate, [&](WindowId window) {
+        std::lock_guard<std::mutex> lock(mutex);
+        result = window;
+        found.notify_one();
+    });
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        found.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&] { return result != 0; });
+    }
+    CancelWatch(watch);
+    return result;
+}
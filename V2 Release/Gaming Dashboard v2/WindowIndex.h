@@ -0,0 +1,59 @@
+#pragma once
+
+#include "WindowMatcher.h"
+#include "WindowSystem.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <shared_mutex>
+#include <unordered_map>
+
+// In-memory table of top-level windows, kept up to date from WindowSystem events.
+// Lookups never touch the OS, so they are safe to call on the UI thread. Searches visit the newest
+// window first: those created since the index started, newest first, then the ones that were open
+// then, top of the z-order first. Where several windows match, the first one that way wins, like the
+// top-most match of the EnumWindows scan this replaces.
+class WindowIndex {
+public:
+    explicit WindowIndex(WindowSystem& system);
+    ~WindowIndex();
+
+    WindowIndex(const WindowIndex&) = delete;
+    WindowIndex& operator=(const WindowIndex&) = delete;
+
+    bool Lookup(WindowId window, WindowInfo& info) const;
+    // Newest indexed window accepted by the predicate, 0 if none
+    WindowId Find(const WindowPredicate& predicate) const;
+    WindowId FindByTitle(const std::string& titlePart) const;
+    // One pass over the index for every entry of the built matcher: windows[entry] is its newest
+    // matching window, or 0. A window goes to one entry at most, the lowest it satisfies that is still open.
+    void Resolve(const WindowMatcher& matcher, std::vector<WindowId>& windows) const;
+    // Processes that show a visible top-level window, i.e. one that is not embedded anywhere
+    void VisibleWindowOwners(std::vector<ProcessId>& pids) const;
+    size_t Size() const;
+
+    // Calls onFound once with the first matching window: right away on the caller's thread if one is
+    // already indexed, otherwise on the event thread. onFound must not call CancelWatch itself.
+    int Watch(WindowPredicate predicate, std::function<void(WindowId)> onFound);
+    // onFound is not running and will not run once this returns
+    void CancelWatch(int watch);
+
+    // Like ::WaitForWindow, but existing windows are checked from the index instead of a scan
+    WindowId WaitFor(const WindowPredicate& predicate, int timeoutMs);
+
+private:
+    void OnEvent(const WindowEvent& event);
+
+    // Callers hold the lock exclusively. A window keeps its place in the order once it has one.
+    void Store(WindowId window, WindowInfo info, int64_t order);
+    void Erase(WindowId window);
+
+    WindowSystem& m_system;
+    mutable std::shared_mutex m_mutex;
+    // By place in the search order, highest first; the windows open at startup get 0 and below
+    std::map<int64_t, WindowInfo, std::greater<int64_t>> m_windows;
+    std::unordered_map<WindowId, int64_t> m_order;
+    int64_t m_nextOrder = 1;
+    int m_token = 0;
+};
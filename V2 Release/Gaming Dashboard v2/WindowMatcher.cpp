@@ -0,0 +1,108 @@
+#include "WindowMatcher.h"
+
+#include <algorithm>
+#include <deque>
+
+int WindowMatcher::Add(Entry entry)
+{
+    m_entries.push_back(std::move(entry));
+    return (int)m_entries.size() - 1;
+}
+
+int WindowMatcher::Child(int node, unsigned char c) const
+{
+    for (const auto& edge : m_nodes[node].next) {
+        if (edge.first == c) return edge.second;
+    }
+    return -1;
+}
+
+void WindowMatcher::Build()
+{
+    m_nodes.assign(1, Node());
+    m_anyTitle.clear();
+    m_pidEntries.clear();
+    m_anyPidCount = 0;
+    m_classEntries.clear();
+    m_needsClass.assign(m_entries.size(), 0);
+
+    // Trie of the title parts
+    for (int i = 0; i < Count(); i++) {
+        const Entry& entry = m_entries[i];
+        if (entry.pid != 0) m_pidEntries[entry.pid].push_back(i);
+        else m_anyPidCount++;
+        if (entry.readiness && !entry.readiness->Rule().className.empty()) {
+            m_classEntries[entry.readiness->Rule().className].push_back(i);
+            m_needsClass[i] = 1;
+        }
+        if (entry.titlePart.empty()) {
+            m_anyTitle.push_back(i);
+            continue;
+        }
+        int node = 0;
+        for (char c : entry.titlePart) {
+            int child = Child(node, (unsigned char)c);
+            if (child < 0) {
+                child = (int)m_nodes.size();
+                m_nodes[node].next.push_back({ (unsigned char)c, child });
+                m_nodes.emplace_back();
+            }
+            node = child;
+        }
+        m_nodes[node].outputs.push_back(i);
+    }
+
+    // Fail links breadth-first, so a node's fail target is finished before the node
+    std::deque<int> queue;
+    for (const auto& edge : m_nodes[0].next) {
+        queue.push_back(edge.second);
+    }
+    while (!queue.empty()) {
+        int node = queue.front();
+        queue.pop_front();
+        for (const auto& edge : m_nodes[node].next) {
+            int fail = m_nodes[node].fail;
+            while (fail != 0 && Child(fail, edge.first) < 0) fail = m_nodes[fail].fail;
+            int target = Child(fail, edge.first);
+            Node& child = m_nodes[edge.second];
+            child.fail = target >= 0 && target != edge.second ? target : 0;
+            const std::vector<int>& inherited = m_nodes[child.fail].outputs;
+            child.outputs.insert(child.outputs.end(), inherited.begin(), inherited.end());
+            queue.push_back(edge.second);
+        }
+    }
+}
+
+void WindowMatcher::Match(const WindowInfo& info, std::vector<int>& entries) const
+{
+    // Same windows MatchWindowTitle considers
+    if (!info.visible || info.parent != 0) return;
+    if (m_anyPidCount == 0 && m_pidEntries.find(info.pid) == m_pidEntries.end()) return;
+
+    size_t first = entries.size();
+    entries.insert(entries.end(), m_anyTitle.begin(), m_anyTitle.end());
+    int node = 0;
+    for (char c : info.title) {
+        int child;
+        while ((child = Child(node, (unsigned char)c)) < 0 && node != 0) node = m_nodes[node].fail;
+        node = child < 0 ? 0 : child;
+        const std::vector<int>& outputs = m_nodes[node].outputs;
+        entries.insert(entries.end(), outputs.begin(), outputs.end());
+    }
+    // A part found more than once is one match
+    std::sort(entries.begin() + first, entries.end());
+    entries.erase(std::unique(entries.begin() + first, entries.end()), entries.end());
+
+    const std::vector<int>* sameClass = nullptr;
+    if (!m_classEntries.empty()) {
+        auto it = m_classEntries.find(info.className);
+        if (it != m_classEntries.end()) sameClass = &it->second;
+    }
+    auto rejected = [&](int index) {
+        const Entry& entry = m_entries[index];
+        if (entry.pid != 0 && entry.pid != info.pid) return true;
+        if (m_needsClass[index] && (!sameClass || !std::binary_search(sameClass->begin(), sameClass->end(), index))) return true;
+        return entry.readiness && !entry.readiness->Matches(info);
+    };
+    entries.erase(std::remove_if(entries.begin() + first, entries.end(), rejected), entries.end());
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "WindowReadiness.h"
+#include "WindowSystem.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Finds the windows of many apps at once. The title substrings of all entries are compiled into one
+// Aho-Corasick automaton, so a title is scanned once however many apps are looked for; process ids
+// and window classes are hash lookups. Build once, then Match from any thread.
+class WindowMatcher {
+public:
+    struct Entry {
+        // Must appear in the title (case-sensitive, like MatchWindowTitle); empty for any title
+        std::string titlePart;
+        // 0 for any process
+        ProcessId pid = 0;
+        // Null takes any window with the title
+        std::shared_ptr<const ReadinessMatcher> readiness;
+    };
+
+    // Returns the entry's index, which is also its slot in WindowIndex::Resolve's results
+    int Add(Entry entry);
+    // After the last Add and before the first Match
+    void Build();
+
+    int Count() const { return (int)m_entries.size(); }
+
+    // Appends the entries a visible top-level window satisfies, in entry order
+    void Match(const WindowInfo& info, std::vector<int>& entries) const;
+
+private:
+    struct Node {
+        // Sparse: a node has few children, and the automaton is built per lookup batch
+        std::vector<std::pair<unsigned char, int>> next;
+        int fail = 0;
+        // Entries whose title part ends here, including those reached through fail links
+        std::vector<int> outputs;
+    };
+
+    int Child(int node, unsigned char c) const;
+
+    std::vector<Entry> m_entries;
+    std::vector<Node> m_nodes;
+    // Entries that take any title
+    std::vector<int> m_anyTitle;
+    // Entries bound to a process, by pid; when every entry is, windows of other processes are skipped unread
+    std::unordered_map<ProcessId, std::vector<int>> m_pidEntries;
+    int m_anyPidCount = 0;
+    // Entries whose readiness rule names a window class, by class
+    std::unordered_map<std::string, std::vector<int>> m_classEntries;
+    std::vector<unsigned char> m_needsClass;
+};
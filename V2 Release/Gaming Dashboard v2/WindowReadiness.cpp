@@ -0,0 +1,75 @@
+#include "WindowReadiness.h"
+
+#include <cctype>
+
+bool ReadinessRule::IsEmpty() const
+{
+    return minWidth <= 0 && minHeight <= 0 && className.empty() && titlePattern.empty() && requiredStyle == 0 &&
+        excludedStyle == 0 && stableMs <= 0;
+}
+
+namespace {
+
+// part (lowercased, '?' for any character) against text at pos
+bool MatchesAt(std::string_view text, size_t pos, const std::string& part)
+{
+    if (pos + part.size() > text.size()) return false;
+    for (size_t i = 0; i < part.size(); i++) {
+        if (part[i] != '?' && part[i] != (char)std::tolower((unsigned char)text[pos + i])) return false;
+    }
+    return true;
+}
+
+}
+
+ReadinessMatcher::ReadinessMatcher(ReadinessRule rule) : m_rule(std::move(rule))
+{
+    const std::string& pattern = m_rule.titlePattern;
+    if (pattern.empty()) return;
+    m_titleStartsWithStar = pattern.front() == '*';
+    m_titleEndsWithStar = pattern.back() == '*';
+    std::string part;
+    for (char c : pattern) {
+        if (c != '*') {
+            part += (char)std::tolower((unsigned char)c);
+            continue;
+        }
+        if (!part.empty()) m_titleParts.push_back(std::move(part));
+        part.clear();
+    }
+    if (!part.empty()) m_titleParts.push_back(std::move(part));
+}
+
+bool ReadinessMatcher::Matches(const WindowInfo& info) const
+{
+    if (info.width < m_rule.minWidth || info.height < m_rule.minHeight) return false;
+    if ((info.style & m_rule.requiredStyle) != m_rule.requiredStyle || (info.style & m_rule.excludedStyle) != 0) return false;
+    if (!m_rule.className.empty() && info.className != m_rule.className) return false;
+    return m_rule.titlePattern.empty() || MatchesTitle(info.title);
+}
+
+bool ReadinessMatcher::MatchesTitle(std::string_view title) const
+{
+    // Each literal run goes to its leftmost place after the previous one; only the first and last
+    // are pinned, to the ends of the title, when the pattern does not start or end with a star
+    size_t pos = 0;
+    for (size_t i = 0; i < m_titleParts.size(); i++) {
+        const std::string& part = m_titleParts[i];
+        if (i == 0 && !m_titleStartsWithStar) {
+            if (!MatchesAt(title, 0, part)) return false;
+            pos = part.size();
+        }
+        else if (i == m_titleParts.size() - 1 && !m_titleEndsWithStar) {
+            if (title.size() < pos + part.size() || !MatchesAt(title, title.size() - part.size(), part)) return false;
+            pos = title.size();
+        }
+        else {
+            while (!MatchesAt(title, pos, part)) {
+                if (pos + part.size() >= title.size()) return false;
+                pos++;
+            }
+            pos += part.size();
+        }
+    }
+    return m_titleEndsWithStar || pos == title.size();
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "WindowSystem.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Window style bits a readiness rule can test; the WS_* values, so Win32 styles pass straight through
+namespace WindowStyle {
+const uint32_t POPUP = 0x80000000;
+const uint32_t CAPTION = 0x00C00000;
+const uint32_t THICK_FRAME = 0x00040000;
+}
+
+// When a launched app's window is its real main window rather than a splash screen or updater.
+// Every condition that is set must hold.
+struct ReadinessRule {
+    int minWidth = 0;
+    int minHeight = 0;
+    // Exact window class; empty for any
+    std::string className;
+    // The whole title, case-insensitive, with * and ? wildcards; empty for any
+    std::string titlePattern;
+    uint32_t requiredStyle = 0;
+    uint32_t excludedStyle = 0;
+    // The window must then go this long without resizing or retitling; 0 leaves that to the launch history
+    int stableMs = 0;
+
+    bool IsEmpty() const;
+};
+
+// A rule compiled once per app: the title pattern is lowercased and split at its stars up front, so
+// testing a window on each event is a few compares and never allocates. Immutable, so launches on
+// any thread can share one.
+class ReadinessMatcher {
+public:
+    explicit ReadinessMatcher(ReadinessRule rule);
+
+    bool Matches(const WindowInfo& info) const;
+    int StableMs() const { return m_rule.stableMs; }
+    const ReadinessRule& Rule() const { return m_rule; }
+
+private:
+    bool MatchesTitle(std::string_view title) const;
+
+    ReadinessRule m_rule;
+    // Literal runs of the pattern between stars, lowercased; '?' inside them matches any character
+    std::vector<std::string> m_titleParts;
+    bool m_titleStartsWithStar = false;
+    bool m_titleEndsWithStar = false;
+};
@@ -0,0 +1,418 @@
+#include "WindowSystem.h"
+
+#include <chrono>
+#include <condition_variable>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <future>
+#include <thread>
+#endif
+
+int WindowSystem::Subscribe(Listener listener)
+{
+    std::lock_guard<std::mutex> lock(m_listenersMutex);
+    int token = m_nextToken++;
+    m_listeners[token] = std::move(listener);
+    return token;
+}
+
+void WindowSystem::Unsubscribe(int token)
+{
+    std::lock_guard<std::mutex> lock(m_listenersMutex);
+    m_listeners.erase(token);
+}
+
+void WindowSystem::Dispatch(const WindowEvent& event)
+{
+    std::lock_guard<std::mutex> lock(m_listenersMutex);
+    for (auto& entry : m_listeners) {
+        entry.second(event);
+    }
+}
+
+// Fake backend
+bool FakeWindowSystem::QueryWindow(WindowId window, WindowInfo& info)
+{
+    std::lock_guard<std::mutex> lock(m_windowsMutex);
+    auto it = m_windows.find(window);
+    if (it == m_windows.end()) return false;
+    info = it->second;
+    return true;
+}
+
+void FakeWindowSystem::EnumerateWindows(std::vector<WindowId>& windows)
+{
+    std::lock_guard<std::mutex> lock(m_windowsMutex);
+    windows.clear();
+    // Ids grow with each window, and new windows open on top
+    for (auto it = m_windows.rbegin(); it != m_windows.rend(); ++it) {
+        windows.push_back(it->first);
+    }
+}
+
+void FakeWindowSystem::PlaceWindows(const std::vector<WindowPlacement>& placements)
+{
+    std::vector<WindowId> resized;
+    {
+        std::lock_guard<std::mutex> lock(m_windowsMutex);
+        m_placeCalls++;
+        for (const WindowPlacement& placement : placements) {
+            auto it = m_windows.find(placement.window);
+            if (it == m_windows.end()) continue;
+            m_placedWindows++;
+            if (it->second.width == placement.width && it->second.height == placement.height) continue;
+            it->second.width = placement.width;
+            it->second.height = placement.height;
+            resized.push_back(placement.window);
+        }
+    }
+    for (WindowId window : resized) {
+        Dispatch({ WindowEventType::Resized, window });
+    }
+}
+
+bool FakeWindowSystem::IsWindowAlive(WindowId window)
+{
+    std::lock_guard<std::mutex> lock(m_windowsMutex);
+    return m_windows.count(window) != 0;
+}
+
+bool FakeWindowSystem::ClientSize(WindowId window, int& width, int& height)
+{
+    std::lock_guard<std::mutex> lock(m_windowsMutex);
+    auto it = m_windows.find(window);
+    if (it == m_windows.end()) return false;
+    width = it->second.width;
+    height = it->second.height;
+    return true;
+}
+
+bool FakeWindowSystem::EmbedWindow(WindowId window, WindowId parent)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_windowsMutex);
+        auto it = m_windows.find(window);
+        if (it == m_windows.end() || m_windows.count(parent) == 0) return false;
+        it->second.parent = parent;
+    }
+    Dispatch({ WindowEventType::ParentChanged, window });
+    return true;
+}
+
+void FakeWindowSystem::ReleaseWindow(WindowId window)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_windowsMutex);
+        auto it = m_windows.find(window);
+        if (it == m_windows.end()) return;
+        it->second.parent = 0;
+        it->second.visible = true;
+    }
+    Dispatch({ WindowEventType::ParentChanged, window });
+    Dispatch({ WindowEventType::Shown, window });
+}
+
+int FakeWindowSystem::PlaceCalls() const
+{
+    std::lock_guard<std::mutex> lock(m_windowsMutex);
+    return m_placeCalls;
+}
+
+int FakeWindowSystem::PlacedWindows() const
+{
+    std::lock_guard<std::mutex> lock(m_windowsMutex);
+    return m_placedWindows;
+}
+
+WindowId FakeWindowSystem::AddWindow(const WindowInfo& info)
+{
+    WindowId id;
+    {
+        std::lock_guard<std::mutex> lock(m_windowsMutex);
+        id = m_nextId++;
+        m_windows[id] = info;
+        m_windows[id].id = id;
+    }
+    Dispatch({ WindowEventType::Created, id });
+    if (info.visible) Dispatch({ WindowEventType::Shown, id });
+    return id;
+}
+
+void FakeWindowSystem::SetTitle(WindowId window, const std::string& title)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_windowsMutex);
+        auto it = m_windows.find(window);
+        if (it == m_windows.end()) return;
+        it->second.title = title;
+    }
+    Dispatch({ WindowEventType::NameChanged, window });
+}
+
+void FakeWindowSystem::SetVisible(WindowId window, bool visible)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_windowsMutex);
+        auto it = m_windows.find(window);
+        if (it == m_windows.end()) return;
+        it->second.visible = visible;
+    }
+    Dispatch({ visible ? WindowEventType::Shown : WindowEventType::Hidden, window });
+}
+
+void FakeWindowSystem::SetSize(WindowId window, int width, int height)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_windowsMutex);
+        auto it = m_windows.find(window);
+        if (it == m_windows.end()) return;
+        it->second.width = width;
+        it->second.height = height;
+    }
+    Dispatch({ WindowEventType::Resized, window });
+}
+
+void FakeWindowSystem::RemoveWindow(WindowId window)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_windowsMutex);
+        if (m_windows.erase(window) == 0) return;
+    }
+    Dispatch({ WindowEventType::Destroyed, window });
+}
+
+WindowPredicate MatchWindowTitle(const std::string& titlePart)
+{
+    return [titlePart](const WindowInfo& info) {
+        return info.visible && info.parent == 0 && info.title.find(titlePart) != std::string::npos;
+    };
+}
+
+WindowId WaitForWindow(WindowSystem& system, const WindowPredicate& predicate, int timeoutMs)
+{
+    std::mutex mutex;
+    std::condition_variable found;
+    WindowId result = 0;
+
+    auto test = [&](WindowId window) {
+        WindowInfo info;
+        if (!system.QueryWindow(window, info) || !predicate(info)) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (result == 0) result = window;
+        found.notify_one();
+    };
+
+    int token = system.Subscribe([&](const WindowEvent& event) {
+        if (event.type == WindowEventType::Destroyed || event.type == WindowEventType::Hidden) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (result != 0) return;
+        }
+        test(event.window);
+    });
+
+    // Check what is already on screen
+    std::vector<WindowId> windows;
+    system.EnumerateWindows(windows);
+    for (WindowId window : windows) {
+        test(window);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (result != 0) break;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        found.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&] { return result != 0; });
+    }
+    system.Unsubscribe(token);
+    return result;
+}
+
+#ifdef _WIN32
+
+// Out-of-context WinEvent hook on a dedicated thread with its own message loop
+class Win32WindowSystem : public WindowSystem {
+public:
+    Win32WindowSystem() {
+        std::promise<void> ready;
+        std::future<void> started = ready.get_future();
+        m_thread = std::thread([this, &ready]() { HookThread(ready); });
+        started.wait();
+    }
+
+    ~Win32WindowSystem() override {
+        PostThreadMessage(m_threadId, WM_QUIT, 0, 0);
+        m_thread.join();
+    }
+
+    bool QueryWindow(WindowId window, WindowInfo& info) override {
+        HWND hwnd = (HWND)window;
+        if (!IsWindow(hwnd)) return false;
+
+        char text[256];
+        info.id = window;
+        info.parent = (WindowId)GetParent(hwnd);
+        info.visible = IsWindowVisible(hwnd) != FALSE;
+
+        DWORD pid = 0;
+        GetWindowThreadProcessId(hwnd, &pid);
+        info.pid = pid;
+
+        RECT rect = {};
+        GetWindowRect(hwnd, &rect);
+        info.width = rect.right - rect.left;
+        info.height = rect.bottom - rect.top;
+        info.style = (std::uint32_t)GetWindowLongPtrA(hwnd, GWL_STYLE);
+
+        text[0] = 0;
+        GetWindowTextA(hwnd, text, sizeof(text));
+        info.title = text;
+        text[0] = 0;
+        GetClassNameA(hwnd, text, sizeof(text));
+        info.className = text;
+        return true;
+    }
+
+    void EnumerateWindows(std::vector<WindowId>& windows) override {
+        windows.clear();
+        EnumWindows([](HWND hwnd, LPARAM lParam) -> BOOL {
+            ((std::vector<WindowId>*)lParam)->push_back((WindowId)hwnd);
+            return TRUE;
+            }, (LPARAM)&windows);
+    }
+
+    void PlaceWindows(const std::vector<WindowPlacement>& placements) override {
+        // One DeferWindowPos batch: every window moves in a single repaint instead of one per window.
+        // A dead window would fail the whole batch, so those are filtered out first.
+        int count = 0;
+        for (const WindowPlacement& placement : placements) {
+            if (IsWindow((HWND)placement.window)) count++;
+        }
+        if (count == 0) return;
+
+        const UINT flags = SWP_NOZORDER | SWP_NOACTIVATE;
+        HDWP batch = BeginDeferWindowPos(count);
+        for (const WindowPlacement& placement : placements) {
+            HWND hwnd = (HWND)placement.window;
+            if (!IsWindow(hwnd)) continue;
+            if (batch) batch = DeferWindowPos(batch, hwnd, nullptr, placement.x, placement.y, placement.width, placement.height, flags);
+            // The batch is gone if DeferWindowPos failed; place the rest one at a time
+            if (!batch) SetWindowPos(hwnd, nullptr, placement.x, placement.y, placement.width, placement.height, flags);
+        }
+        if (batch) EndDeferWindowPos(batch);
+    }
+
+    bool IsWindowAlive(WindowId window) override {
+        return IsWindow((HWND)window) != FALSE;
+    }
+
+    bool ClientSize(WindowId window, int& width, int& height) override {
+        RECT rect;
+        if (!GetClientRect((HWND)window, &rect)) return false;
+        width = rect.right - rect.left;
+        height = rect.bottom - rect.top;
+        return true;
+    }
+
+    bool EmbedWindow(WindowId window, WindowId parent) override {
+        HWND hwnd = (HWND)window;
+        if (!IsWindow(hwnd) || !IsWindow((HWND)parent)) return false;
+        SetParent(hwnd, (HWND)parent);
+        LONG style = GetWindowLong(hwnd, GWL_STYLE);
+        style &= ~(WS_CAPTION | WS_THICKFRAME | WS_MINIMIZE | WS_MAXIMIZE | WS_SYSMENU);
+        style |= WS_CHILD;
+        SetWindowLong(hwnd, GWL_STYLE, style);
+        // The hook skips our own process's events, and drops child windows
+        Dispatch({ WindowEventType::ParentChanged, window });
+        return true;
+    }
+
+    void ReleaseWindow(WindowId window) override {
+        HWND hwnd = (HWND)window;
+        if (!IsWindow(hwnd)) return;
+        LONG style = GetWindowLong(hwnd, GWL_STYLE);
+        style &= ~WS_CHILD;
+        style |= WS_CAPTION | WS_THICKFRAME | WS_SYSMENU | WS_MINIMIZEBOX | WS_MAXIMIZEBOX;
+        SetWindowLong(hwnd, GWL_STYLE, style);
+        SetParent(hwnd, NULL);
+        SetWindowPos(hwnd, NULL, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE | SWP_FRAMECHANGED);
+        ShowWindow(hwnd, SW_SHOWNA);
+        Dispatch({ WindowEventType::ParentChanged, window });
+        Dispatch({ WindowEventType::Shown, window });
+    }
+
+    void SetWindowVisible(WindowId window, bool visible) override {
+        ShowWindow((HWND)window, visible ? SW_SHOW : SW_HIDE);
+        Dispatch({ visible ? WindowEventType::Shown : WindowEventType::Hidden, window });
+    }
+
+    void InvalidateWindow(WindowId window) override {
+        InvalidateRect((HWND)window, NULL, TRUE);
+    }
+
+private:
+    void HookThread(std::promise<void>& ready) {
+        MSG msg;
+        // Make sure the thread has a message queue before anyone posts to it
+        PeekMessage(&msg, nullptr, WM_USER, WM_USER, PM_NOREMOVE);
+        m_threadId = GetCurrentThreadId();
+        s_instance = this;
+
+        HWINEVENTHOOK hook = SetWinEventHook(EVENT_OBJECT_CREATE, EVENT_OBJECT_PARENTCHANGE, nullptr,
+            WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+        ready.set_value();
+
+        while (GetMessage(&msg, nullptr, 0, 0) > 0) {
+            TranslateMessage(&msg);
+            DispatchMessage(&msg);
+        }
+
+        if (hook) UnhookWinEvent(hook);
+        s_instance = nullptr;
+    }
+
+    static void CALLBACK WinEventProc(HWINEVENTHOOK, DWORD event, HWND hwnd, LONG idObject, LONG idChild, DWORD, DWORD) {
+        if (!hwnd || idObject != OBJID_WINDOW || idChild != CHILDID_SELF || !s_instance) return;
+
+        WindowEvent windowEvent;
+        windowEvent.window = (WindowId)hwnd;
+        switch (event) {
+        case EVENT_OBJECT_CREATE: windowEvent.type = WindowEventType::Created; break;
+        case EVENT_OBJECT_SHOW: windowEvent.type = WindowEventType::Shown; break;
+        case EVENT_OBJECT_HIDE: windowEvent.type = WindowEventType::Hidden; break;
+        case EVENT_OBJECT_NAMECHANGE: windowEvent.type = WindowEventType::NameChanged; break;
+        case EVENT_OBJECT_LOCATIONCHANGE: windowEvent.type = WindowEventType::Resized; break;
+        case EVENT_OBJECT_PARENTCHANGE: windowEvent.type = WindowEventType::ParentChanged; break;
+        case EVENT_OBJECT_DESTROY: windowEvent.type = WindowEventType::Destroyed; break;
+        default: return;
+        }
+
+        // Only top-level windows; a destroyed window can no longer be checked, and one that has just
+        // become a child must still reach the index so it stops counting as top-level
+        if (windowEvent.type != WindowEventType::Destroyed && windowEvent.type != WindowEventType::ParentChanged &&
+            GetAncestor(hwnd, GA_ROOT) != hwnd) return;
+
+        s_instance->Dispatch(windowEvent);
+    }
+
+    std::thread m_thread;
+    DWORD m_threadId = 0;
+    static Win32WindowSystem* s_instance;
+};
+
+Win32WindowSystem* Win32WindowSystem::s_instance = nullptr;
+
+std::unique_ptr<WindowSystem> CreatePlatformWindowSystem()
+{
+    return std::make_unique<Win32WindowSystem>();
+}
+
+#else
+
+std::unique_ptr<WindowSystem> CreatePlatformWindowSystem()
+{
+    return std::make_unique<FakeWindowSystem>();
+}
+
+#endif
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Opaque window handle (the HWND value on Win32)
+typedef std::uintptr_t WindowId;
+typedef std::uint32_t ProcessId;
+
+// Snapshot of a top-level window
+struct WindowInfo {
+    WindowId id = 0;
+    WindowId parent = 0;
+    ProcessId pid = 0;
+    bool visible = false;
+    int width = 0;
+    int height = 0;
+    // GWL_STYLE bits on Win32
+    std::uint32_t style = 0;
+    std::string title;
+    std::string className;
+};
+
+enum class WindowEventType {
+    Created,
+    Shown,
+    Hidden,
+    NameChanged,
+    Resized,
+    // Embedded into another window or released from it
+    ParentChanged,
+    Destroyed,
+};
+
+struct WindowEvent {
+    WindowEventType type = WindowEventType::Created;
+    WindowId window = 0;
+};
+
+// Position and size for a window, in its parent's client coordinates
+struct WindowPlacement {
+    WindowId window = 0;
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+};
+
+// Source of top-level window lifecycle events plus basic queries, and the few operations the dashboard
+// needs to embed windows
+class WindowSystem {
+public:
+    typedef std::function<void(const WindowEvent&)> Listener;
+
+    virtual ~WindowSystem() = default;
+
+    // Fills info for a live window, false if it is gone
+    virtual bool QueryWindow(WindowId window, WindowInfo& info) = 0;
+    // Lists all current top-level windows in z-order, top-most first
+    virtual void EnumerateWindows(std::vector<WindowId>& windows) = 0;
+    // Moves and resizes the windows as one batch, without changing z-order or activation.
+    // All of them must share the same parent. Windows that no longer exist are skipped.
+    virtual void PlaceWindows(const std::vector<WindowPlacement>& placements) = 0;
+
+    virtual bool IsWindowAlive(WindowId window) = 0;
+    // Client area size, false if the window is gone
+    virtual bool ClientSize(WindowId window, int& width, int& height) = 0;
+    // Turns window into a borderless child of parent. False if either is gone. These three report
+    // their change as an event before they return, so the index never offers an embedded window.
+    virtual bool EmbedWindow(WindowId window, WindowId parent) = 0;
+    // Undoes EmbedWindow: a visible top-level window with caption and frame again
+    virtual void ReleaseWindow(WindowId window) = 0;
+    virtual void SetWindowVisible(WindowId window, bool visible) = 0;
+    // Asks the window to repaint itself
+    virtual void InvalidateWindow(WindowId window) = 0;
+
+    // Listeners run on the event thread, in subscription order, and must not (un)subscribe from inside the callback.
+    // Unsubscribe waits for an in-flight dispatch, so captured state can be released right after.
+    int Subscribe(Listener listener);
+    void Unsubscribe(int token);
+
+protected:
+    void Dispatch(const WindowEvent& event);
+
+private:
+    std::mutex m_listenersMutex;
+    std::map<int, Listener> m_listeners;
+    int m_nextToken = 1;
+};
+
+// In-memory backend; events fire synchronously on the calling thread
+class FakeWindowSystem : public WindowSystem {
+public:
+    bool QueryWindow(WindowId window, WindowInfo& info) override;
+    void EnumerateWindows(std::vector<WindowId>& windows) override;
+    // Applies the sizes (the fake has no positions) and counts the calls
+    void PlaceWindows(const std::vector<WindowPlacement>& placements) override;
+    bool IsWindowAlive(WindowId window) override;
+    // The fake has no borders, so the client size is the window size
+    bool ClientSize(WindowId window, int& width, int& height) override;
+    bool EmbedWindow(WindowId window, WindowId parent) override;
+    void ReleaseWindow(WindowId window) override;
+    void SetWindowVisible(WindowId window, bool visible) override { SetVisible(window, visible); }
+    void InvalidateWindow(WindowId) override {}
+
+    // Number of PlaceWindows batches, and of windows placed across all of them
+    int PlaceCalls() const;
+    int PlacedWindows() const;
+
+    // Creates a window on top of the others and returns its id (info.id is ignored)
+    WindowId AddWindow(const WindowInfo& info);
+    void SetTitle(WindowId window, const std::string& title);
+    void SetVisible(WindowId window, bool visible);
+    void SetSize(WindowId window, int width, int height);
+    void RemoveWindow(WindowId window);
+
+private:
+    mutable std::mutex m_windowsMutex;
+    std::map<WindowId, WindowInfo> m_windows;
+    WindowId m_nextId = 0x1000;
+    int m_placeCalls = 0;
+    int m_placedWindows = 0;
+};
+
+typedef std::function<bool(const WindowInfo&)> WindowPredicate;
+
+// Visible, parentless window whose title contains titlePart (same rule as the old EnumWindows scan)
+WindowPredicate MatchWindowTitle(const std::string& titlePart);
+
+// Blocks until a window matching the predicate exists or timeoutMs expires. Returns 0 on timeout.
+// Subscribes before looking at existing windows, so a window appearing in between is not missed.
+WindowId WaitForWindow(WindowSystem& system, const WindowPredicate& predicate, int timeoutMs);
+
+// Win32 event hook backend on Windows, FakeWindowSystem elsewhere
+std::unique_ptr<WindowSystem> CreatePlatformWindowSystem();